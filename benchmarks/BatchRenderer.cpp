@@ -0,0 +1,103 @@
+//
+// Created by fo on 13/04/2021.
+//
+// This file contains a benchmark of the scaling of BatchRenderer, rendering an "UPDATE" query for each of many records,
+// across a growing number of threads; rendering through MYSQLBuilder::buildQuery, on one thread, is measured first
+//
+// compilation for g++, from the root of the repository:
+// g++ -O2 -std=c++17 -pthread benchmarks/BatchRenderer.cpp src/builders/*.cpp src/types/*.cpp src/utils/*.cpp -o batchRendererBenchmark
+#include "../builders/BatchRenderer.h"
+#include "../builders/MYSQLBuilder.h"
+#include "../types/QueryCondition.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using BatchRenderer = DBQueryBuilder::Builder::BatchRenderer;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+
+static const std::size_t slots = 5;     //the values of each record: 4 columns, then the id of the guard-condition
+
+/**
+ * @brief: returns the text of the values of the passed number of records, record after record
+ */
+static std::vector<std::string> makeValues(const std::size_t &records) {
+    std::vector<std::string> values;
+    values.reserve(records * slots);
+    for (std::size_t record = 0; record < records; ++record) {
+        values.push_back(std::to_string(record * 37 % 100000) + ".25");
+        values.push_back("client-" + std::to_string(record) + "@example.com");
+        values.push_back("O'Brien " + std::to_string(record % 977));
+        values.push_back("2021-04-13 10:" + std::to_string(record % 60));
+        values.push_back(std::to_string(record));
+    }
+
+    return values;
+}
+
+/**
+ * @brief: sets the shape of the "UPDATE" query of the passed record into the passed builder
+ */
+static void setRecord(MYSQLBuilder &builder, const std::vector<std::string> &values, const std::size_t &record) {
+    builder.reset();
+    builder.setTableName("Account");
+    builder.setAction(DBQueryBuilder::Action::UPDATE);
+    builder.addResourceRep({{"balance", values[record * slots]},
+                            {"email", values[record * slots + 1]},
+                            {"name", values[record * slots + 2]},
+                            {"updatedAt", values[record * slots + 3]}});
+    builder.addCondition(std::make_shared<QCondition>(QCondition::AND, "id", QCondition::Operator::E, false,
+                                                      values[record * slots + 4]));
+}
+
+int main() {
+    const std::size_t records = 1000000;
+    const std::vector<std::string> values = makeValues(records);
+    const std::vector<std::string_view> views(values.begin(), values.end());
+
+    //the builder renders the columns in the order of their names, which the values above follow
+    MYSQLBuilder builder;
+    std::size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t record = 0; record < records / 10; ++record) {
+        setRecord(builder, values, record);
+        checksum += builder.buildQuery().size();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("MYSQLBuilder::buildQuery\t1 thread\t%.0f queries/s\t(checksum %zu)\n", records / 10 / elapsed.count(),
+                checksum);
+
+    setRecord(builder, values, 0);
+    auto qTemplate = builder.compile();
+
+    std::vector<std::size_t> threadCounts = {1, 2, 4, 8, 16, 32};
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    double single = 0;      //the throughput of a single thread
+    for (const std::size_t &threads : threadCounts) {
+        if (threads > hardware && threads != 1) {
+            break;
+        }
+
+        BatchRenderer renderer(threads);
+        DBQueryBuilder::Builder::RenderedBatch batch;
+        renderer.renderInto(*qTemplate, views.data(), views.size(), batch);       //warm the buffers up
+
+        const int repetitions = 5;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; ++i) {
+            renderer.renderInto(*qTemplate, views.data(), views.size(), batch);
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+
+        const double throughput = records * repetitions / elapsed.count();
+        single = threads == 1 ? throughput : single;
+        std::printf("BatchRenderer\t%zu threads\t%.0f queries/s\tspeed-up %.2f\t(checksum %zu)\n", threads, throughput,
+                    throughput / single, batch.query(batch.size() - 1).size());
+    }
+
+    return 0;
+}
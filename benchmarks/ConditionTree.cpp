@@ -0,0 +1,113 @@
+//
+// Created by fo on 12/04/2021.
+//
+// This file contains a benchmark of a 20-predicate "where"-clause, built from shared QueryConditions and
+// CompQueryConditions, against the same clause built as a ConditionTree
+//
+// compilation for g++, from the root of the repository:
+// g++ -O2 -std=c++17 benchmarks/ConditionTree.cpp src/builders/MYSQLBuilder.cpp src/types/*.cpp src/utils/Escaper.cpp -o conditionTreeBenchmark
+#include "../builders/MYSQLBuilder.h"
+#include "../types/CompQueryCondition.h"
+#include "../types/ConditionTree.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+using CQCondition = DBQueryBuilder::Type::CompQueryCondition;
+using ConditionTree = DBQueryBuilder::Type::ConditionTree;
+
+static std::size_t allocations = 0;     //the number of calls to operator new so far
+
+void *operator new(std::size_t size) {
+    ++allocations;
+    if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+static const char *fields[] = {"clientId", "cipherName", "key", "id", "createdAt"};
+static const char *values[] = {"17", "aes-256-gcm", "k3y", "4096", "2021-04-12"};
+
+/**
+ * @brief: adds 20 predicates to the passed builder: 12 at the top of the "where"-clause, and 2 groups of 4
+ */
+static void addClasses(MYSQLBuilder &builder) {
+    for (int i = 0; i < 12; ++i) {
+        builder.addCondition(std::make_shared<QCondition>(i % 3 == 0 ? QCondition::OR : QCondition::AND, fields[i % 5],
+                                                          QCondition::Operator::E, i % 4 == 0, values[i % 5]));
+    }
+    for (int group = 0; group < 2; ++group) {
+        std::vector<QCondition::Ptr> components;
+        for (int i = 0; i < 4; ++i) {
+            components.push_back(std::make_shared<QCondition>(QCondition::AND, fields[i], QCondition::Operator::GE,
+                                                              false, values[i]));
+        }
+        builder.addCompositeCondition(components);
+    }
+}
+
+static void addTree(MYSQLBuilder &builder, ConditionTree &tree) {
+    tree.clear();
+    for (int i = 0; i < 12; ++i) {
+        tree.add(i % 3 == 0 ? QCondition::OR : QCondition::AND, fields[i % 5], QCondition::Operator::E, i % 4 == 0,
+                 values[i % 5]);
+    }
+    for (int group = 0; group < 2; ++group) {
+        tree.openGroup();
+        for (int i = 0; i < 4; ++i) {
+            tree.add(QCondition::AND, fields[i], QCondition::Operator::GE, false, values[i]);
+        }
+        tree.closeGroup();
+    }
+    builder.addConditions(tree);
+}
+
+/**
+ * @brief: builds the query the passed number of times, and prints the time and the allocations of each build
+ */
+template<typename AddConditions>
+static void measure(const char *name, const int &iterations, const AddConditions &addConditions) {
+    MYSQLBuilder builder;
+    std::string query;
+    std::size_t checksum = 0;
+
+    const std::size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        builder.reset();
+        builder.setTableName("CipherPackage");
+        builder.setAction(DBQueryBuilder::Action::SELECT);
+        addConditions(builder);
+
+        query.clear();
+        checksum += builder.buildQueryInto(query);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::printf("%s\t%.1f ns/query\t%.2f allocations/query\t(checksum %zu)\n", name, elapsed.count() / iterations,
+                static_cast<double>(allocations - before) / iterations, checksum);
+}
+
+int main() {
+    const int iterations = 200000;
+    ConditionTree tree;
+
+    measure("QueryCondition", iterations, [](MYSQLBuilder &builder) { addClasses(builder); });
+    measure("ConditionTree", iterations, [&](MYSQLBuilder &builder) { addTree(builder, tree); });
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+//
+// Created by fo on 09/04/2021.
+//
+// This file contains a microbenchmark of Escaper, across payload-sizes, densities of characters that need escaping, and
+// implementations
+//
+// compilation for g++, from the root of the repository:
+// g++ -O2 -std=c++17 benchmarks/Escaper.cpp src/utils/Escaper.cpp -o escaperBenchmark
+#include "../utils/Escaper.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+using Escaper = DBQueryBuilder::Util::Escaper;
+
+/**
+ * @brief: returns a payload of the passed size, in which roughly the passed fraction of characters need escaping
+ */
+static std::string makePayload(const std::size_t &size, const double &density) {
+    static const char specials[] = {'\'', '"', '\\', '\0', '\n', '\r', '\t', '\x1a'};
+    std::mt19937 random(static_cast<unsigned>(size));
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::uniform_int_distribution<int> printable(' ' + 1, '~');
+
+    std::string payload(size, 'a');
+    for (char &character : payload) {
+        character = chance(random) < density ? specials[random() % sizeof(specials)] : static_cast<char>(printable(random));
+        if (character == '\'' || character == '"' || character == '\\') {       //printable, yet needing escaping
+            character = chance(random) < density ? character : 'x';
+        }
+    }
+
+    return payload;
+}
+
+int main() {
+    const std::size_t sizes[] = {16, 64, 256, 4096, 65536, 1u << 20u};
+    const double densities[] = {0.0, 0.001, 0.01, 0.1};
+    const Escaper::Level levels[] = {Escaper::Level::SCALAR, Escaper::Level::SSE2, Escaper::Level::AVX2};
+    const char *names[] = {"scalar", "sse2", "avx2"};
+
+    std::printf("implementation\tbytes\tdensity\tMB/s\n");
+    for (const Escaper::Level &requested : levels) {
+        Escaper::Level level = Escaper::setLevel(requested);
+        if (level != requested) {       //the processor does not support the implementation
+            continue;
+        }
+
+        for (const std::size_t &size : sizes) {
+            for (const double &density : densities) {
+                std::string payload = makePayload(size, density);
+                std::string out(payload.size() * 2 + 2, '\0');
+
+                //escape about 256MB in total, so that every size is timed over a similar amount of work
+                const std::size_t iterations = std::max<std::size_t>(1, (256u << 20u) / size);
+                std::size_t checksum = 0;
+
+                auto start = std::chrono::steady_clock::now();
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    checksum += Escaper::literalLength(payload.data(), payload.size());
+                    checksum += Escaper::escapeLiteral(payload.data(), payload.size(), &out[0]) - out.data();
+                }
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+                double megabytes = static_cast<double>(size) * static_cast<double>(iterations) / (1u << 20u);
+                std::printf("%s\t%zu\t%g\t%.1f\t(checksum %zu)\n", names[level], size, density,
+                            megabytes / elapsed.count(), checksum);
+            }
+        }
+    }
+
+    return 0;
+}
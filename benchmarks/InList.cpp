@@ -0,0 +1,105 @@
+//
+// Created by fo on 24/04/2021.
+//
+// This file contains a benchmark of the lookup of a set of rows by their ids, on an in-memory SQLite-database, as a
+// query per id against the "in"-lists of SQLiteBuilder::setInList, split by setInListLimit into queries of a growing
+// number of ids; the number of ids looked up is the first argument
+//
+// compilation for g++, from the root of the repository:
+// g++ -O2 -std=c++17 -pthread benchmarks/InList.cpp src/builders/*.cpp src/diagnostics/*.cpp src/types/*.cpp src/utils/*.cpp -lsqlite3 -o inListBenchmark
+#include "../builders/SQLiteBuilder.h"
+
+#include <sqlite3.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using SQLiteBuilder = DBQueryBuilder::Builder::SQLiteBuilder;
+using ParameterizedQuery = DBQueryBuilder::Builder::ParameterizedQuery;
+
+static const std::size_t tableRows = 200000;
+
+/**
+ * @brief: runs the passed query, binding its values in order, and returns the number of rows it returned
+ */
+static std::size_t run(sqlite3 *db, const ParameterizedQuery &query) {
+    sqlite3_stmt *statement = nullptr;
+    if (sqlite3_prepare_v2(db, query.sql.data(), static_cast<int>(query.sql.size()), &statement, nullptr) != SQLITE_OK) {
+        std::fprintf(stderr, "Error: %s in: %s\n", sqlite3_errmsg(db), query.sql.c_str());
+        std::exit(1);
+    }
+    for (std::size_t i = 0; i < query.binds.size(); ++i) {
+        sqlite3_bind_text(statement, static_cast<int>(i + 1), query.binds[i].data(),
+                          static_cast<int>(query.binds[i].size()), SQLITE_STATIC);
+    }
+
+    std::size_t rows = 0;
+    while (sqlite3_step(statement) == SQLITE_ROW) {
+        ++rows;
+    }
+    sqlite3_finalize(statement);
+
+    return rows;
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t lookups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+
+    sqlite3 *db = nullptr;
+    sqlite3_open(":memory:", &db);
+    run(db, {"create table account(id integer primary key, email text, balance text)", {}});
+
+    SQLiteBuilder builder;
+    builder.setTableName("account");
+    builder.setAction(DBQueryBuilder::Action::INSERT);
+    builder.setBatchLimits(0, 250);
+    for (std::size_t row = 0; row < tableRows; ++row) {
+        builder.addRow({{"id", std::to_string(row)}, {"email", "client-" + std::to_string(row) + "@example.com"},
+                        {"balance", std::to_string(row * 37 % 100000) + ".25"}});
+    }
+    run(db, {"begin", {}});
+    for (const ParameterizedQuery &query : builder.buildParameterizedQueries()) {
+        run(db, query);
+    }
+    run(db, {"commit", {}});
+
+    //the ids looked up, scattered over the table
+    std::vector<std::string> ids;
+    for (std::size_t id = 0; id < lookups; ++id) {
+        ids.push_back(std::to_string(id * 7919 % tableRows));
+    }
+
+    //a query per id, each built and prepared anew
+    builder.reset();
+    builder.setTableName("account");
+    builder.setAction(DBQueryBuilder::Action::SELECT);
+    builder.setTargetColumns({"id", "email", "balance"});
+    std::size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string &id : ids) {
+        builder.setInList("id", {id});
+        found += run(db, builder.buildParameterizedQuery());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("point lookups\t%zu rows\t%.0f rows/s\n", found, found / elapsed.count());
+
+    //the ids in lists of a growing length, the list built and sorted once
+    for (const std::size_t &perQuery : {std::size_t(10), std::size_t(100), std::size_t(1000), std::size_t(10000)}) {
+        found = 0;
+        start = std::chrono::steady_clock::now();
+        builder.setInList("id", ids);
+        builder.setInListLimit(perQuery);
+        const std::vector<ParameterizedQuery> queries = builder.buildParameterizedQueries();
+        for (const ParameterizedQuery &query : queries) {
+            found += run(db, query);
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("in-lists of %zu\t%zu rows\t%zu queries\t%.0f rows/s\n", perQuery, found, queries.size(),
+                    found / elapsed.count());
+    }
+
+    sqlite3_close(db);
+    return 0;
+}
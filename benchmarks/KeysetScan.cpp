@@ -0,0 +1,125 @@
+//
+// Created by fo on 23/04/2021.
+//
+// This file contains a benchmark of the pages of a table, at a growing depth, sought by an offset against sought by the
+// key of MYSQLBuilder::setKeyset, on an in-memory SQLite-database, which reads the queries of MYSQLBuilder alike; then
+// the rows/s of a whole scan by KeysetScanner. The number of rows is the first argument
+//
+// compilation for g++, from the root of the repository:
+// g++ -O2 -std=c++17 -pthread benchmarks/KeysetScan.cpp src/builders/*.cpp src/diagnostics/*.cpp src/types/*.cpp src/utils/*.cpp -lsqlite3 -o keysetScanBenchmark
+#include "../builders/KeysetScanner.h"
+#include "../builders/SQLiteBuilder.h"
+
+#include <sqlite3.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using KeysetScanner = DBQueryBuilder::Builder::KeysetScanner;
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using SQLiteBuilder = DBQueryBuilder::Builder::SQLiteBuilder;
+using ParameterizedQuery = DBQueryBuilder::Builder::ParameterizedQuery;
+
+static const int pageSize = 1000;
+
+/**
+ * @brief: runs the passed query, binding its values in order, and returns the number of rows it returned, keeping the
+ * key of the last one
+ */
+static std::size_t run(sqlite3 *db, const ParameterizedQuery &query, std::string *lastKey = nullptr) {
+    sqlite3_stmt *statement = nullptr;
+    if (sqlite3_prepare_v2(db, query.sql.data(), static_cast<int>(query.sql.size()), &statement, nullptr) != SQLITE_OK) {
+        std::fprintf(stderr, "Error: %s in: %s\n", sqlite3_errmsg(db), query.sql.c_str());
+        std::exit(1);
+    }
+    for (std::size_t i = 0; i < query.binds.size(); ++i) {
+        sqlite3_bind_text(statement, static_cast<int>(i + 1), query.binds[i].data(),
+                          static_cast<int>(query.binds[i].size()), SQLITE_STATIC);
+    }
+
+    std::size_t rows = 0;
+    while (sqlite3_step(statement) == SQLITE_ROW) {
+        if (lastKey != nullptr) {
+            *lastKey = reinterpret_cast<const char *>(sqlite3_column_text(statement, 0));
+        }
+        ++rows;
+    }
+    sqlite3_finalize(statement);
+
+    return rows;
+}
+
+/**
+ * @brief: returns the seconds that the passed page takes, at the least of a few runs
+ */
+static double timePage(sqlite3 *db, const ParameterizedQuery &query) {
+    double best = 1e9;
+    for (int i = 0; i < 5; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        run(db, query);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+
+    return best;
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500000;
+
+    sqlite3 *db = nullptr;
+    sqlite3_open(":memory:", &db);
+    run(db, {"create table account(id integer primary key, email text, balance text)", {}});
+
+    SQLiteBuilder filler;
+    filler.setTableName("account");
+    filler.setAction(DBQueryBuilder::Action::INSERT);
+    filler.setBatchLimits(0, 250);
+    for (std::size_t row = 0; row < rows; ++row) {
+        filler.addRow({{"id", std::to_string(row)}, {"email", "client-" + std::to_string(row) + "@example.com"},
+                       {"balance", std::to_string(row * 37 % 100000) + ".25"}});
+    }
+    run(db, {"begin", {}});
+    for (const ParameterizedQuery &query : filler.buildParameterizedQueries()) {
+        run(db, query);
+    }
+    run(db, {"commit", {}});
+
+    //a page at each depth, by an offset, then by the key of the row before it
+    MYSQLBuilder builder;
+    builder.setTableName("account");
+    builder.setAction(DBQueryBuilder::Action::SELECT);
+    builder.setTargetColumns({"id", "email", "balance"});
+    for (const std::size_t &depth : {std::size_t(0), rows / 4, rows / 2, rows - pageSize}) {
+        builder.setOrder("id", DBQueryBuilder::Order::ASC);
+        builder.setLimit(pageSize);
+        ParameterizedQuery byOffset = builder.buildParameterizedQuery();
+        byOffset.sql += " offset " + std::to_string(depth);
+
+        builder.setKeyset({"id"}, pageSize);
+        builder.seekAfter(depth == 0 ? std::vector<std::string>() : std::vector<std::string>{std::to_string(depth - 1)});
+        const ParameterizedQuery byKey = builder.buildParameterizedQuery();
+        builder.seekAfter({});
+
+        std::printf("depth %zu\toffset %.3f ms\tkeyset %.3f ms\n", depth, timePage(db, byOffset) * 1000,
+                    timePage(db, byKey) * 1000);
+    }
+
+    //the whole table, a page at a time
+    std::size_t scanned = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::string lastKey;
+    for (KeysetScanner scanner(builder, {"id"}, pageSize); !scanner.done();) {
+        const std::size_t returned = run(db, scanner.query(), &lastKey);
+        scanned += returned;
+        scanner.advance(returned, {lastKey});
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("KeysetScanner\t%zu rows\t%.0f rows/s\n", scanned, scanned / elapsed.count());
+
+    sqlite3_close(db);
+    return 0;
+}
@@ -0,0 +1,95 @@
+//
+// Created by fo on 21/04/2021.
+//
+// This file contains a benchmark of the rendering of millions of rows for MYSQL, as batched "INSERT" queries of
+// MYSQLBuilder::buildColumnarInsert, against the file of a "LOAD DATA" statement streamed by
+// MYSQLBuilder::streamLoadDataPayload, a ColumnBatch at a time; the peak resident memory is printed after each, and
+// the number of rows is the first argument
+//
+// compilation for g++, from the root of the repository:
+// g++ -O2 -std=c++17 -pthread benchmarks/LoadData.cpp src/builders/*.cpp src/diagnostics/*.cpp src/types/*.cpp src/utils/*.cpp -o loadDataBenchmark
+#include "../builders/MYSQLBuilder.h"
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using ColumnBatch = DBQueryBuilder::Type::ColumnBatch;
+
+static const std::size_t batchRows = 10000;     //the rows of each ColumnBatch
+
+/**
+ * @brief: the columns of a ColumnBatch of rows, refilled batch after batch
+ */
+struct Columns {
+    std::vector<std::int64_t> ids = std::vector<std::int64_t>(batchRows);
+    std::vector<double> balances = std::vector<double>(batchRows);
+    std::vector<std::string> emails = std::vector<std::string>(batchRows);
+    std::vector<std::string> names = std::vector<std::string>(batchRows);
+
+    /**
+     * @brief: fills the columns with the passed number of rows, beginning with the passed one
+     */
+    ColumnBatch fill(const std::size_t &first, const std::size_t &rows) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            const std::size_t row = first + i;
+            ids[i] = static_cast<std::int64_t>(row);
+            balances[i] = static_cast<double>(row * 37 % 100000) + 0.25;
+            emails[i] = "client-" + std::to_string(row) + "@example.com";
+            names[i] = "O'Brien\t" + std::to_string(row % 977);
+        }
+
+        ColumnBatch batch(rows);
+        batch.addColumn("id", ids.data()).addColumn("balance", balances.data()).addColumn("email", emails.data())
+                .addColumn("name", names.data());
+        return batch;
+    }
+};
+
+/**
+ * @brief: returns the peak resident memory of the process so far, in MiB
+ */
+static double peakMiB() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss / 1024.0;
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    Columns columns;
+
+    //"INSERT" queries of at most 1MiB, each handed to the caller whole
+    MYSQLBuilder builder;
+    builder.setTableName("account");
+    builder.setBatchLimits(1024 * 1024, 0);
+    std::size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t first = 0; first < rows; first += batchRows) {
+        for (const std::string &query : builder.buildColumnarInsert(columns.fill(first, std::min(batchRows, rows - first)))) {
+            bytes += query.size();
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("buildColumnarInsert\t%zu rows\t%.0f rows/s\t%.1f MiB/s\tpeak %.1f MiB\n", rows, rows / elapsed.count(),
+                bytes / elapsed.count() / (1024 * 1024), peakMiB());
+
+    //the file of a "LOAD DATA" statement, passed on in chunks of 64KiB
+    bytes = 0;
+    const MYSQLBuilder::LoadDataSink sink = [&](const char *, const std::size_t &count) { bytes += count; };
+    start = std::chrono::steady_clock::now();
+    for (std::size_t first = 0; first < rows; first += batchRows) {
+        builder.streamLoadDataPayload(columns.fill(first, std::min(batchRows, rows - first)), sink);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("streamLoadDataPayload\t%zu rows\t%.0f rows/s\t%.1f MiB/s\tpeak %.1f MiB\n", rows,
+                rows / elapsed.count(), bytes / elapsed.count() / (1024 * 1024), peakMiB());
+
+    return 0;
+}
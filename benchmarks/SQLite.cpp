@@ -0,0 +1,151 @@
+//
+// Created by fo on 20/04/2021.
+//
+// This file contains an end-to-end benchmark of SQLiteBuilder: the rows/s of building "INSERT" queries and running them
+// against a SQLite-database, a row per query, then in multi-row queries of a growing number of rows, either committed
+// query by query or wrapped in a transaction; the database is the file passed as the first argument, or an in-memory
+// one, and the number of rows is the second argument
+//
+// compilation for g++, from the root of the repository:
+// g++ -O2 -std=c++17 benchmarks/SQLite.cpp src/builders/SQLiteBuilder.cpp src/diagnostics/*.cpp src/types/*.cpp src/utils/*.cpp -lsqlite3 -o sqliteBenchmark
+#include "../builders/SQLiteBuilder.h"
+
+#include <sqlite3.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using SQLiteBuilder = DBQueryBuilder::Builder::SQLiteBuilder;
+using ParameterizedQuery = DBQueryBuilder::Builder::ParameterizedQuery;
+
+/**
+ * @brief: runs queries, re-using the prepared statement of the previous query when the next has the same text, as
+ * every full batch of a multi-row insert has
+ */
+class Runner {
+public:
+    explicit Runner(sqlite3 *db) : _db(db) {}
+
+    Runner(const Runner &) = delete;
+
+    Runner &operator=(const Runner &) = delete;
+
+    void run(const ParameterizedQuery &query) {
+        if (_statement == nullptr || query.sql != _sql) {
+            sqlite3_finalize(_statement);
+            _statement = nullptr;
+            _sql = query.sql;
+            if (sqlite3_prepare_v2(_db, _sql.data(), static_cast<int>(_sql.size()), &_statement, nullptr) != SQLITE_OK) {
+                fail();
+            }
+        } else {
+            sqlite3_reset(_statement);
+        }
+
+        for (std::size_t i = 0; i < query.binds.size(); ++i) {
+            sqlite3_bind_text(_statement, static_cast<int>(i + 1), query.binds[i].data(),
+                              static_cast<int>(query.binds[i].size()), SQLITE_STATIC);
+        }
+        if (sqlite3_step(_statement) != SQLITE_DONE) {
+            fail();
+        }
+    }
+
+    void run(const std::string &query) {
+        if (sqlite3_exec(_db, query.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK) {
+            fail();
+        }
+    }
+
+    ~Runner() {
+        sqlite3_finalize(_statement);
+    }
+
+private:
+    void fail() const {
+        std::fprintf(stderr, "Error: %s in: %s\n", sqlite3_errmsg(_db), _sql.c_str());
+        std::exit(1);
+    }
+
+    sqlite3 *_db;
+    sqlite3_stmt *_statement = nullptr;
+    std::string _sql;       //the text of _statement
+};
+
+/**
+ * @brief: adds the passed range of rows to the passed builder, which is set to insert them into the table "account"
+ */
+static void setRows(SQLiteBuilder &builder, const std::size_t &first, const std::size_t &last) {
+    builder.reset();
+    builder.setTableName("account");
+    builder.setAction(DBQueryBuilder::Action::INSERT);
+    for (std::size_t row = first; row < last; ++row) {
+        builder.addRow({{"balance", std::to_string(row * 37 % 100000) + ".25"},
+                        {"email", "client-" + std::to_string(row) + "@example.com"},
+                        {"id", std::to_string(row)},
+                        {"name", "O'Brien " + std::to_string(row % 977)}});
+    }
+}
+
+/**
+ * @brief: inserts the passed number of rows, either a query per row, or all of them split by
+ * SQLiteBuilder::buildParameterizedQueries() into queries of at most the passed number of rows, and prints the rows/s
+ * @param batchRows: the rows of each query; zero, if only the number of variables bounds them
+ */
+static void measure(sqlite3 *db, const std::size_t &rows, const std::size_t &batchRows, const bool &transaction) {
+    Runner runner(db);
+    runner.run("drop table if exists account");
+    runner.run("create table account(balance text, email text, id integer primary key, name text)");
+
+    SQLiteBuilder builder;
+    const auto start = std::chrono::steady_clock::now();
+    if (transaction) {
+        runner.run("begin");
+    }
+    if (batchRows == 1) {
+        for (std::size_t row = 0; row < rows; ++row) {
+            setRows(builder, row, row + 1);
+            runner.run(builder.buildParameterizedQuery());
+        }
+    } else {
+        setRows(builder, 0, rows);
+        builder.setBatchLimits(0, batchRows);
+        for (const ParameterizedQuery &query : builder.buildParameterizedQueries()) {
+            runner.run(query);
+        }
+    }
+    if (transaction) {
+        runner.run("commit");
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const std::string batch = batchRows == 0 ? "max variables" : std::to_string(batchRows);
+    std::printf("%s rows/query\t%s\t%zu rows\t%.0f rows/s\n", batch.c_str(),
+                transaction ? "transaction" : "autocommit", rows, rows / elapsed.count());
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = argc > 1 ? argv[1] : ":memory:";
+    const std::size_t rows = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+
+    sqlite3 *db = nullptr;
+    if (sqlite3_open(path, &db) != SQLITE_OK) {
+        std::fprintf(stderr, "Error: %s\n", sqlite3_errmsg(db));
+        return 1;
+    }
+
+    //without a transaction every query is committed, which, on a file, costs a sync each; single rows are then fewer,
+    //so that the benchmark ends soon on a file as well
+    measure(db, std::min<std::size_t>(rows, 10000), 1, false);
+    measure(db, rows, 1, true);
+    measure(db, rows, 250, false);
+    for (const auto &batchRows : {10, 100, 250, 1000, 0}) {
+        measure(db, rows, batchRows, true);
+    }
+
+    sqlite3_close(db);
+    return 0;
+}
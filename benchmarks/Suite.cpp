@@ -0,0 +1,389 @@
+//
+// Created by fo on 14/04/2021.
+//
+// This file contains the benchmark-suite of the hot paths of the builders: buildQuery() for every Action,
+// QueryCondition::toString(), CompQueryCondition nested in depth and in width, wide inserts through addResourceRep(...),
+// and the construction of builders on several threads at once
+//
+// Every result is printed, as a line of CSV, to the standard output:
+//      name,ns_per_op,iterations[,baseline_ns_per_op,ratio,status]
+// The results can be saved as a baseline with --save <file>, then compared against it with --baseline <file>; a
+// benchmark whose time grows beyond the tolerance (--tolerance <fraction>, 0.25 by default) is flagged as a
+// "regression", and the suite exits with 2
+//
+// usage: dbQueryBuilderBenchmarks [--quick] [--filter <substring>] [--save <file>] [--baseline <file>] [--tolerance <fraction>]
+//
+// compilation for g++, from the root of the repository:
+// g++ -O2 -std=c++17 -pthread benchmarks/Suite.cpp src/*/*.cpp -o dbQueryBuilderBenchmarks
+#include "../builders/MYSQLBuilder.h"
+#include "../factories/QueryBuilderCreator.h"
+#include "../types/CompQueryCondition.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using IQueryBuilder = DBQueryBuilder::Builder::IQueryBuilder;
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+using CQCondition = DBQueryBuilder::Type::CompQueryCondition;
+
+/**
+ * @brief: the settings of a run of the suite
+ */
+struct Settings {
+    bool quick{false};      //measure each benchmark briefly, e.g. to check that the suite runs
+    std::string filter;     //only the benchmarks whose names contain this are run
+    std::string save;       //the file the results are saved to, as a baseline
+    std::string baseline;       //the file the results are compared against
+    double tolerance{0.25};     //the fraction by which a benchmark may slow down before it is flagged
+};
+
+/**
+ * @brief: the result of a benchmark
+ */
+struct Result {
+    std::string name;
+    double nsPerOp;
+    std::size_t iterations;
+};
+
+static std::size_t checksum = 0;        //consumes the output of every benchmark, so that none is optimized away
+
+/**
+ * @brief: runs the passed body, which performs the passed number of operations, for long enough to be measured; the
+ * fastest of several samples is kept, as it is the least disturbed by the rest of the machine
+ * @param body: performs its argument's number of operations
+ */
+static Result measure(const Settings &settings, const std::string &name,
+                      const std::function<void(std::size_t)> &body) {
+    using Clock = std::chrono::steady_clock;
+    const double sampleNs = settings.quick ? 1e6 : 5e7;     //the least duration of a sample
+    const int samples = settings.quick ? 1 : 5;
+
+    //grow the number of operations until a sample lasts long enough
+    std::size_t iterations = 1;
+    while (true) {
+        auto start = Clock::now();
+        body(iterations);
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        if (elapsed.count() >= sampleNs || iterations >= (std::size_t(1) << 30)) {
+            break;
+        }
+        iterations *= elapsed.count() * 10 < sampleNs ? 10 : 2;
+    }
+
+    double best = 0;
+    for (int sample = 0; sample < samples; ++sample) {
+        auto start = Clock::now();
+        body(iterations);
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        if (sample == 0 || elapsed.count() < best) {
+            best = elapsed.count();
+        }
+    }
+
+    return {name, best / static_cast<double>(iterations), iterations};
+}
+
+/**
+ * @brief: adds the target-columns, the conditions, the order and the limit shared by the benchmarks of buildQuery()
+ */
+static void describe(IQueryBuilder &builder, const DBQueryBuilder::Action &action) {
+    builder.setTableName("CipherPackage");
+    builder.setAction(action);
+    if (action == DBQueryBuilder::Action::SELECT) {
+        builder.setTargetColumns({"clientId", "cipherName", "key", "id", "createdAt", "updatedAt"});
+        builder.setOrder("clientId", DBQueryBuilder::Order::ASC);
+        builder.setLimit(100);
+    } else if (action != DBQueryBuilder::Action::DELETE) {
+        builder.addResourceRep({{"clientId", "17"}, {"cipherName", "aes-256-gcm"}, {"key", "k3y'with\"quotes"},
+                                {"id", "4096"}, {"createdAt", "2021-04-14"}, {"updatedAt", "2021-04-14"}});
+    }
+
+    if (action != DBQueryBuilder::Action::INSERT) {
+        builder.addCondition(std::make_shared<QCondition>(QCondition::AND, "clientId", QCondition::Operator::E, false, "17"));
+        builder.addCondition(std::make_shared<QCondition>(QCondition::OR, "cipherName", QCondition::Operator::E, true,
+                                                          "aes-128-cbc"));
+        builder.addCompositeCondition({std::make_shared<QCondition>(QCondition::AND, "id", QCondition::Operator::GE, false, "10"),
+                                       std::make_shared<QCondition>(QCondition::AND, "id", QCondition::Operator::LE, false, "99")});
+    }
+}
+
+/**
+ * @brief: returns a CompQueryCondition nested to the passed depth, each level holding a QueryCondition and the next level
+ */
+static QCondition::Ptr nested(const std::size_t &depth) {
+    QCondition::Ptr condition = std::make_shared<QCondition>(QCondition::AND, "id", QCondition::Operator::E, false, "0");
+    for (std::size_t level = 1; level < depth; ++level) {
+        condition = std::make_shared<CQCondition>(std::vector<QCondition::Ptr>{
+                std::make_shared<QCondition>(QCondition::OR, "clientId", QCondition::Operator::G, false,
+                                             std::to_string(level)), condition});
+    }
+    return condition;
+}
+
+/**
+ * @brief: returns a CompQueryCondition holding the passed number of QueryConditions
+ */
+static QCondition::Ptr wide(const std::size_t &width) {
+    std::vector<QCondition::Ptr> components;
+    for (std::size_t i = 0; i < width; ++i) {
+        components.push_back(std::make_shared<QCondition>(i % 2 == 0 ? QCondition::AND : QCondition::OR,
+                                                          "column" + std::to_string(i), QCondition::Operator::E,
+                                                          i % 3 == 0, std::to_string(i)));
+    }
+    return std::make_shared<CQCondition>(components);
+}
+
+/**
+ * @brief: returns a row of the passed number of columns
+ */
+static std::map<std::string, std::string> row(const std::size_t &columns) {
+    std::map<std::string, std::string> resourceRep;
+    for (std::size_t i = 0; i < columns; ++i) {
+        resourceRep["column" + std::to_string(i)] = "value-" + std::to_string(i * 7919);
+    }
+    return resourceRep;
+}
+
+/**
+ * @brief: constructs, describes, builds and destroys the passed number of builders on each of the passed number of
+ * threads; the time of an operation is that of one builder
+ * @param pooled: whether the builders are handed out by Factory::makePooledQueryBuilder(...)
+ */
+static void constructOnThreads(const std::size_t &threads, const bool &pooled, const std::size_t &iterations) {
+    const std::size_t perThread = (iterations + threads - 1) / threads;
+    std::vector<std::size_t> lengths(threads, 0);
+
+    auto work = [&](std::size_t thread) {
+        for (std::size_t i = 0; i < perThread; ++i) {
+            if (pooled) {
+                DBQueryBuilder::Factory::PooledQueryBuilder builder = DBQueryBuilder::Factory::makePooledQueryBuilder(DBQueryBuilder::Factory::MYSQL);
+                describe(*builder, DBQueryBuilder::Action::SELECT);
+                lengths[thread] += builder->buildQuery().size();
+            } else {
+                MYSQLBuilder builder;
+                describe(builder, DBQueryBuilder::Action::SELECT);
+                lengths[thread] += builder.buildQuery().size();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t thread = 1; thread < threads; ++thread) {
+        workers.emplace_back(work, thread);
+    }
+    work(0);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    for (const std::size_t &length : lengths) {
+        checksum += length;
+    }
+}
+
+/**
+ * @brief: returns every benchmark of the suite, by name
+ */
+static std::vector<std::pair<std::string, std::function<void(std::size_t)>>> benchmarks() {
+    std::vector<std::pair<std::string, std::function<void(std::size_t)>>> list;
+
+    const std::pair<const char *, DBQueryBuilder::Action> actions[] = {
+            {"insert", DBQueryBuilder::Action::INSERT}, {"select", DBQueryBuilder::Action::SELECT},
+            {"update", DBQueryBuilder::Action::UPDATE}, {"delete", DBQueryBuilder::Action::DELETE}};
+    for (const auto &action : actions) {
+        auto builder = std::make_shared<MYSQLBuilder>();
+        describe(*builder, action.second);
+        list.emplace_back(std::string("buildQuery/") + action.first, [builder](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                checksum += builder->buildQuery().size();
+            }
+        });
+    }
+
+    auto leaf = std::make_shared<QCondition>(QCondition::AND, "cipherName", QCondition::Operator::GE, true, "aes-256-cbc");
+    list.emplace_back("toString/leaf", [leaf](std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            checksum += leaf->toString(true).size();
+        }
+    });
+
+    for (const std::size_t depth : {2, 8, 32, 128}) {
+        QCondition::Ptr condition = nested(depth);
+        list.emplace_back("toString/depth/" + std::to_string(depth), [condition](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                checksum += condition->toString(true).size();
+            }
+        });
+    }
+
+    for (const std::size_t width : {2, 8, 32, 128}) {
+        QCondition::Ptr condition = wide(width);
+        list.emplace_back("toString/width/" + std::to_string(width), [condition](std::size_t iterations) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                checksum += condition->toString(true).size();
+            }
+        });
+    }
+
+    for (const std::size_t columns : {8, 64, 256}) {
+        auto resourceRep = std::make_shared<std::map<std::string, std::string>>(row(columns));
+        list.emplace_back("addResourceRep/columns/" + std::to_string(columns), [resourceRep](std::size_t iterations) {
+            MYSQLBuilder builder;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                builder.reset();
+                builder.setTableName("CipherPackage");
+                builder.setAction(DBQueryBuilder::Action::INSERT);
+                builder.addResourceRep(*resourceRep);
+                checksum += builder.buildQuery().size();
+            }
+        });
+    }
+
+    list.emplace_back("makeQueryBuilder/dialect", [](std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            checksum += DBQueryBuilder::Factory::makeQueryBuilder(DBQueryBuilder::Factory::MYSQL).use_count();
+        }
+    });
+    list.emplace_back("makeQueryBuilder/name", [](std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            checksum += DBQueryBuilder::Factory::makeQueryBuilder("mysql").use_count();
+        }
+    });
+
+    for (const std::size_t threads : {1, 2, 4, 8}) {
+        list.emplace_back("construct/threads/" + std::to_string(threads), [threads](std::size_t iterations) {
+            constructOnThreads(threads, false, iterations);
+        });
+        list.emplace_back("constructPooled/threads/" + std::to_string(threads), [threads](std::size_t iterations) {
+            constructOnThreads(threads, true, iterations);
+        });
+    }
+
+    return list;
+}
+
+/**
+ * @brief: reads the results saved in the passed file; lines that are empty or start with '#' are skipped
+ * @return bool: false, if the file cannot be read
+ */
+static bool readBaseline(const std::string &path, std::map<std::string, double> &baseline) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#' || line.compare(0, 5, "name,") == 0) {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        std::string name, nsPerOp;
+        if (std::getline(fields, name, ',') && std::getline(fields, nsPerOp, ',')) {
+            baseline[name] = std::strtod(nsPerOp.c_str(), nullptr);
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    Settings settings;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--quick") {
+            settings.quick = true;
+        } else if (argument == "--filter" && hasValue) {
+            settings.filter = argv[++i];
+        } else if (argument == "--save" && hasValue) {
+            settings.save = argv[++i];
+        } else if (argument == "--baseline" && hasValue) {
+            settings.baseline = argv[++i];
+        } else if (argument == "--tolerance" && hasValue) {
+            settings.tolerance = std::strtod(argv[++i], nullptr);
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--quick] [--filter <substring>] [--save <file>] "
+                      << "[--baseline <file>] [--tolerance <fraction>]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!settings.baseline.empty() && !readBaseline(settings.baseline, baseline)) {
+        std::cerr << "Error: the baseline \"" << settings.baseline << "\" cannot be read" << std::endl;
+        return 1;
+    }
+
+    std::cout << (baseline.empty() ? "name,ns_per_op,iterations" : "name,ns_per_op,iterations,baseline_ns_per_op,ratio,status")
+              << std::endl;
+
+    std::vector<Result> results;
+    std::size_t regressions = 0;
+    char line[256];
+    for (const auto &benchmark : benchmarks()) {
+        if (benchmark.first.find(settings.filter) == std::string::npos) {
+            continue;
+        }
+
+        Result result = measure(settings, benchmark.first, benchmark.second);
+        std::snprintf(line, sizeof(line), "%s,%.2f,%zu", result.name.c_str(), result.nsPerOp, result.iterations);
+        std::cout << line;
+
+        if (!baseline.empty()) {
+            auto saved = baseline.find(result.name);
+            if (saved == baseline.end() || saved->second <= 0) {
+                std::cout << ",,,new";
+            } else {
+                const double ratio = result.nsPerOp / saved->second;
+                const char *status = "ok";
+                if (ratio > 1 + settings.tolerance) {
+                    status = "regression";
+                    ++regressions;
+                } else if (ratio < 1 - settings.tolerance) {
+                    status = "improved";
+                }
+                std::snprintf(line, sizeof(line), ",%.2f,%.3f,%s", saved->second, ratio, status);
+                std::cout << line;
+            }
+        }
+        std::cout << std::endl;
+
+        results.push_back(result);
+    }
+
+    if (!settings.save.empty()) {
+        std::ofstream file(settings.save);
+        file << "# saved by dbQueryBuilderBenchmarks; compare with --baseline <file>\n" << "name,ns_per_op,iterations\n";
+        for (const Result &result : results) {
+            std::snprintf(line, sizeof(line), "%s,%.2f,%zu\n", result.name.c_str(), result.nsPerOp, result.iterations);
+            file << line;
+        }
+        if (!file) {
+            std::cerr << "Error: the results cannot be saved to \"" << settings.save << "\"" << std::endl;
+            return 1;
+        }
+    }
+
+    //the checksum keeps the work of the benchmarks observable
+    std::cerr << "checksum: " << checksum << std::endl;
+    if (regressions != 0) {
+        std::cerr << regressions << " benchmark(s) regressed by more than " << settings.tolerance * 100 << "%" << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+//
+// Created by fo on 13/04/2021.
+//
+// This file contains the definition of BatchRenderer, which renders a compiled QueryTemplate once per record, across
+// the threads of a WorkStealingPool
+#include "../types/QueryTemplate.h"
+#include "../utils/WorkStealingPool.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef DBQUERYBUILDER_BATCHRENDERER_H
+#define DBQUERYBUILDER_BATCHRENDERER_H
+
+namespace DBQueryBuilder::Builder {
+
+    /**
+     * @brief: the queries rendered from a batch of records; each chunk of records is rendered into one buffer, and its
+     * queries are held by their positions within it, so a RenderedBatch can be copied and moved like any value
+     */
+    struct RenderedBatch {
+        /**
+         * @brief: the position of the query of a record
+         */
+        struct Query {
+            std::size_t buffer;     //the index of the buffer that holds the query
+            std::size_t offset;     //the position of the query within the buffer
+            std::size_t count;      //the length of the query
+        };
+
+        std::vector<std::string> buffers;       //the text of the queries, one buffer per chunk of records
+        std::vector<Query> queries;     //the query of each record, in the order of the records
+
+        /**
+         * @brief: returns the text of the query of the record at the passed position; it points into buffers, so it is
+         * valid until this RenderedBatch is changed, moved or destroyed
+         * @return
+         */
+        inline std::string_view query(const std::size_t &record) const {
+            const Query &position = queries[record];
+            return std::string_view(buffers[position.buffer].data() + position.offset, position.count);
+        }
+
+        inline std::size_t size() const {
+            return queries.size();
+        }
+    };
+
+    class BatchRenderer {
+    public:
+        /**
+         * @param threads: the number of threads that render, including the one that calls render(...); zero, for as
+         * many as the hardware runs at once
+         * @param chunkSize: the number of records rendered, into one buffer, by a thread at a time
+         */
+        explicit BatchRenderer(const std::size_t &threads = 0, const std::size_t &chunkSize = 256);
+
+        /**
+         * @brief: returns the number of threads that render, including the one that calls render(...)
+         * @return
+         */
+        std::size_t threads() const;
+
+        /**
+         * @brief: renders the passed QueryTemplate, e.g. from MYSQLBuilder::compile(), once for every record, into the
+         * passed RenderedBatch; the buffers already held by the RenderedBatch are reused
+         * @throws std::logic_error: if the number of values is not a multiple of the number of slots of the QueryTemplate
+         * @param qTemplate: the shape of every query
+         * @param values: the values of the records, record after record, each holding qTemplate.slots() values
+         * @param count: the number of values
+         * @param batch: receives the queries, in the order of the records
+         * @return std::size_t: the number of records rendered
+         */
+        std::size_t renderInto(const Type::QueryTemplate &qTemplate, const std::string_view *values,
+                               const std::size_t &count, RenderedBatch &batch);
+
+        /**
+         * @brief: returns the queries of renderInto(...) in a new RenderedBatch
+         * @throws std::logic_error: if the number of values is not a multiple of the number of slots of the QueryTemplate
+         * @param qTemplate: the shape of every query
+         * @param values: the values of the records, record after record, each holding qTemplate.slots() values
+         * @return RenderedBatch: the queries, in the order of the records
+         */
+        RenderedBatch render(const Type::QueryTemplate &qTemplate, const std::vector<std::string_view> &values);
+
+    private:
+        Util::WorkStealingPool _pool;       //the threads that render
+        std::size_t _chunkSize;
+    };
+
+}
+
+#endif //DBQUERYBUILDER_BATCHRENDERER_H
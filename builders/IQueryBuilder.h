@@ -3,10 +3,16 @@
 //
 // This file contains the definition of the interface IQueryBuilder, which is responsible for building SQL queries
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <memory>
 
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define DBQUERYBUILDER_HAS_IOVEC
+#endif
+
 #ifndef DBQUERYBUILDER_IQUERYBUIKDER_H
 #define DBQUERYBUILDER_IQUERYBUIKDER_H
 
@@ -20,6 +26,7 @@ namespace DBQueryBuilder {
         SELECT,
         UPDATE,
         DELETE,
+        UPSERT,     //an insert that updates the rows whose keys are already held, for the builders whose dialect has one
         NIL     //no action
     };
 
@@ -36,10 +43,99 @@ namespace DBQueryBuilder {
          * @brief: check types/QueryCondition.h
          */
         class QueryCondition;
+
+        /**
+         * @brief: check types/ConditionTree.h
+         */
+        class ConditionTree;
     }       //Type
 
     namespace Builder {
 
+        /**
+         * @brief: a query whose values are replaced by placeholders, together with the values to be bound to those
+         * placeholders, in order of appearance
+         */
+        struct ParameterizedQuery {
+            std::string sql;        //the text of the query; it does not change with the values
+            std::vector<std::string> binds;     //the values of the placeholders in sql, in order
+        };
+
+        /**
+         * @brief: a query held as the sequence of pieces that its text is made of, so that it can be sent, e.g. with
+         * writev, without ever being concatenated; the pieces are keyword-literals in static storage, values held by
+         * the builder that need no escaping, and whatever else was written into storage. A piece of storage is held by
+         * its position within it, so a FragmentedQuery can be copied and moved like any value
+         */
+        struct FragmentedQuery {
+            /**
+             * @brief: a piece of the text of the query
+             */
+            struct Fragment {
+                const char *chars;      //the characters, if they are outside of storage; nullptr, if they are within it
+                std::size_t offset;     //the position of the characters within storage, if they are within it
+                std::size_t count;      //the number of characters
+            };
+
+            std::vector<Fragment> fragments;        //the pieces of the text of the query, in order
+            std::string storage;        //the escaped values, quoted names and copied pieces that fragments refer to
+
+            /**
+             * @brief: returns the characters of the fragment at the passed position
+             * @return
+             */
+            inline std::string_view fragment(const std::size_t &position) const {
+                const Fragment &piece = fragments[position];
+                return std::string_view(piece.chars != nullptr ? piece.chars : storage.data() + piece.offset, piece.count);
+            }
+
+            /**
+             * @brief: returns the length of the text of the query
+             * @return
+             */
+            inline std::size_t length() const {
+                std::size_t length = 0;
+                for (const Fragment &piece : fragments) {
+                    length += piece.count;
+                }
+
+                return length;
+            }
+
+            /**
+             * @brief: returns the concatenated text of the query, e.g. for logging
+             * @return
+             */
+            inline std::string str() const {
+                std::string text;
+                text.reserve(length());
+                for (std::size_t i = 0; i < fragments.size(); ++i) {
+                    text += fragment(i);
+                }
+
+                return text;
+            }
+
+#ifdef DBQUERYBUILDER_HAS_IOVEC
+            /**
+             * @brief: returns the fragments as the iovecs that writev takes; there may be more of them than IOV_MAX, in
+             * which case they are to be sent in several calls. The iovecs point into storage, so they are valid until
+             * this FragmentedQuery is changed, moved or destroyed
+             * @return
+             */
+            inline std::vector<iovec> iovecs() const {
+                std::vector<iovec> vectors(fragments.size());
+                for (std::size_t i = 0; i < fragments.size(); ++i) {
+                    const std::string_view piece = fragment(i);
+                    vectors[i].iov_base = const_cast<char *>(piece.data());
+                    vectors[i].iov_len = piece.size();
+                }
+
+                return vectors;
+            }
+#endif
+        };
+
         class IQueryBuilder {
         public:
             using Ptr = std::shared_ptr<IQueryBuilder>;
@@ -79,6 +175,15 @@ namespace DBQueryBuilder {
              */
             virtual int addCompositeCondition(const std::vector<std::shared_ptr<Type::QueryCondition>> qConditions) = 0;
 
+            /**
+             * @brief: adds all the guard-conditions of the passed ConditionTree, in order, to the query being built, as
+             * if each had been added through addCondition(...) or addCompositeCondition(...)
+             * @throws std::logic_error: if the passed ConditionTree has a group that has not been closed
+             * @param conditions: the guard-conditions being added to the query being built
+             * @return int: custom error-number
+             */
+            virtual int addConditions(const Type::ConditionTree &conditions) = 0;
+
             /**
              * @brief: adds the passed Resource-representation into the query being built
              * @param resourceRep: the Resource-representation that is to be added to the query being built
@@ -86,6 +191,34 @@ namespace DBQueryBuilder {
              */
             virtual int addResourceRep(const std::map<std::string, std::string> &resourceRep) = 0;
 
+            /**
+             * @brief: appends the passed Resource-representation to those already added, so that a single query pushes
+             * all of them to the database
+             * @throws std::logic_error: if the columns of the passed Resource-representation differ from those of the
+             * Resource-representations already added
+             * @param resourceRep: the Resource-representation that is to be appended
+             * @return int: custom error-number
+             */
+            virtual int addRow(const std::map<std::string, std::string> &resourceRep) = 0;
+
+            /**
+             * @brief: sets the limits of each of the queries that buildQueries() splits the Resource-representations into
+             * @param maxBytes: the maximum length of each query, e.g. the "max_allowed_packet" of the server; zero, if
+             * unbounded
+             * @param maxRows: the maximum number of Resource-representations pushed by each query; zero, if unbounded
+             * @return int: custom error-number
+             */
+            virtual int setBatchLimits(const std::size_t &maxBytes, const std::size_t &maxRows) = 0;
+
+            /**
+             * @brief: sets the Column by whose values the Resource-representations are ordered, so that concurrent
+             * batches take their locks in the same order
+             * @param columnName: the Column by which Resource-representations are ordered; empty, to keep the order in
+             * which they were added
+             * @return int: custom error-number
+             */
+            virtual int setBatchOrder(const std::string &columnName) = 0;
+
             /**
              * @brief: sets the maximum number of database-entities that the query being build should affect
              * @param limit
@@ -107,6 +240,82 @@ namespace DBQueryBuilder {
              */
             virtual std::string buildQuery() = 0;
 
+            /**
+             * @brief: returns the query that has been built thus far, split into as many queries as the limits set by
+             * setBatchLimits(const std::size_t &, const std::size_t &) require
+             * @throws std::length_error: if a single Resource-representation cannot fit the byte-limit
+             * @return std::vector: the queries, in order
+             */
+            virtual std::vector<std::string> buildQueries() = 0;
+
+            /**
+             * @brief: appends the query that has been built thus far to the passed buffer, growing the buffer at most once
+             * @param buffer: the caller-owned buffer that the query is appended to; its previous content is kept
+             * @return std::size_t: the number of characters appended
+             */
+            virtual std::size_t buildQueryInto(std::string &buffer) = 0;
+
+            /**
+             * @brief: writes the query that has been built thus far into the passed buffer; no terminating null-character is written
+             * @throws std::length_error: if the query is longer than the passed capacity, in which case nothing is written
+             * @param buffer: the caller-owned buffer that the query is written into
+             * @param capacity: the number of characters that the passed buffer can hold
+             * @return std::size_t: the number of characters written
+             */
+            virtual std::size_t buildQueryInto(char *buffer, const std::size_t &capacity) = 0;
+
+            /**
+             * @brief: returns the query that has been built thus far, with every value replaced by a placeholder
+             * @return ParameterizedQuery: the text of the query, with the values to be bound to its placeholders
+             */
+            virtual ParameterizedQuery buildParameterizedQuery() = 0;
+
+            /**
+             * @brief: appends the query that has been built thus far, with every value replaced by a placeholder, to the
+             * passed ParameterizedQuery; the text and the values are each grown at most once
+             * @param query: the caller-owned ParameterizedQuery that the text and the values are appended to
+             * @return std::size_t: the number of characters appended to the text
+             */
+            virtual std::size_t buildParameterizedQueryInto(ParameterizedQuery &query) = 0;
+
+            /**
+             * @brief: returns the query that has been built thus far as a sequence of fragments; the fragments that
+             * point at values held by this builder are valid until the builder is changed, reset or destroyed
+             * @return FragmentedQuery: the fragments of the query, with the storage that some of them point into
+             */
+            virtual FragmentedQuery buildFragmentedQuery() = 0;
+
+            /**
+             * @brief: writes the query that has been built thus far into the passed FragmentedQuery, whose previous
+             * content is discarded, though the capacity of its fragments and storage is reused
+             * @param query: the caller-owned FragmentedQuery that receives the fragments
+             * @return std::size_t: the length of the text of the query
+             */
+            virtual std::size_t buildFragmentedQueryInto(FragmentedQuery &query) = 0;
+
+            /**
+             * @brief: discards everything set on the query being built, so that a new query can be built; the memory
+             * already acquired for the query is kept for reuse
+             * @return int: custom error-number
+             */
+            virtual int reset() = 0;
+
+            /**
+             * @brief: returns a new builder of the same dialect, holding the query built so far, e.g. to create builders
+             * from a prototype
+             * @return IQueryBuilder *: the new builder, owned by the caller
+             */
+            virtual IQueryBuilder *clone() const = 0;
+
+            /**
+             * @brief: makes the query of this builder that of the passed one, e.g. of the prototype it was cloned from;
+             * the memory already acquired by this builder is kept for reuse
+             * @throws std::logic_error: if the passed builder is not of the same dialect
+             * @param prototype
+             * @return int: custom error-number
+             */
+            virtual int restore(const IQueryBuilder &prototype) = 0;
+
             virtual ~IQueryBuilder() = default;
         };
 
@@ -0,0 +1,80 @@
+//
+// Created by fo on 23/04/2021.
+//
+// This file contains the definition of KeysetScanner, which goes through a whole table, a page of a unique key at a
+// time, e.g. for exports
+#include "MYSQLBuilder.h"
+#include <string>
+#include <vector>
+
+#ifndef DBQUERYBUILDER_KEYSETSCANNER_H
+#define DBQUERYBUILDER_KEYSETSCANNER_H
+
+namespace DBQueryBuilder::Builder {
+
+    /**
+     * @brief: iterates over the pages of a "SELECT" query, each sought from the key of the last row of the one before;
+     * the caller runs query(), then passes the number of rows it returned, and the key of its last row, to advance(...),
+     * until done():
+     *  for (KeysetScanner scanner(builder, {"id"}, 1000); !scanner.done();) {
+     *      const ParameterizedQuery &page = scanner.query();
+     *      ...run the page, and keep the key of its last row...
+     *      scanner.advance(rows, lastKey);
+     *  }
+     */
+    class KeysetScanner {
+    public:
+        /**
+         * @param builder: the MYSQLBuilder of the query to be paged, whose table, target-columns and guard-conditions
+         * have been set; it must outlive this KeysetScanner, which sets its keyset, and so its "order by" clause and
+         * "limit" phrase
+         * @param keyColumns: the columns of a unique key, most significant first, which the target-columns must hold
+         * @param pageSize: the greatest number of rows of a page
+         * @param order: the order in which the pages go through the key
+         * @throws std::logic_error: as MYSQLBuilder::setKeyset(...) does
+         */
+        KeysetScanner(MYSQLBuilder &builder, const std::vector<std::string> &keyColumns, const int &pageSize,
+                      const Order &order = Order::ASC);
+
+        /**
+         * @brief: confirms whether or not every page has been returned; it is true once a page has fewer rows than a
+         * page can hold
+         * @return
+         */
+        bool done() const;
+
+        /**
+         * @brief: returns the query of the current page, with its values replaced by placeholders; it is rendered into
+         * the same ParameterizedQuery every time, whose text keeps its memory from page to page
+         * @throws std::logic_error: if every page has been returned
+         * @return ParameterizedQuery: the query, which is valid until the next call of query()
+         */
+        const ParameterizedQuery &query();
+
+        /**
+         * @brief: moves to the page that follows the current one
+         * @throws std::logic_error: if every page has been returned, or, if the page was full, the key is empty or has
+         * not a value for every key-column
+         * @param rows: the number of rows that the query of the current page returned
+         * @param lastKey: the values of the key-columns of the last row of the current page; ignored if the page is
+         * the last
+         */
+        void advance(const std::size_t &rows, const std::vector<std::string> &lastKey);
+
+        /**
+         * @brief: returns the number of pages moved past so far
+         * @return
+         */
+        std::size_t pages() const;
+
+    private:
+        MYSQLBuilder &_builder;
+        std::size_t _pageSize;
+        std::size_t _pages{0};
+        bool _done{false};
+        ParameterizedQuery _query;      //the query of the current page
+    };
+
+}
+
+#endif //DBQUERYBUILDER_KEYSETSCANNER_H
@@ -4,16 +4,80 @@
 // This file contains the definition of MYSQLBuilder, an implementer of IQueryBuilder.
 // MSQBuilder is responsible for building queries form MYSQL
 #include "IQueryBuilder.h"
+#include "../diagnostics/Allocations.h"
+#include "../types/ColumnBatch.h"
+#include "../types/ConditionTree.h"
+#include "../types/QueryTemplate.h"
+#include <functional>
 
 #ifndef DBQUERYBUILDER_MYSQLBUILDER_H
 #define DBQUERYBUILDER_MYSQLBUILDER_H
 
 namespace DBQueryBuilder::Builder {
 
+    /**
+     * @brief: the layout of the file that a "LOAD DATA" statement reads; backslashes, NUL-characters, enclosures and,
+     * when fields are not enclosed, the first characters of the terminators are backslash-escaped, and a NULL is "\N"
+     */
+    struct LoadDataFormat {
+        std::string fieldTerminator{"\t"};       //separates the fields of a row
+        std::string lineTerminator{"\n"};        //ends every row
+        char enclosure{'\0'};       //encloses every field but NULLs, e.g. '"' for CSV; '\0', if fields are not enclosed
+    };
+
+    /**
+     * @brief: once Type::TemplateCache::instance() is given a capacity, MYSQLBuilders render queries of an already seen
+     * shape by splicing their values into the cached Type::QueryTemplate of that shape; the shape is still digested
+     * whole, clause by clause, to be looked up, so a hit saves the quoting and escaping of the names, not the walk of
+     * the query. A shape rendered many times is better compiled once, through compile()
+     */
     class MYSQLBuilder : public IQueryBuilder {
     public:
+        /**
+         * @brief: the enumeration of the expressions that merge a value of the row of an "UPSERT" query into the value
+         * of the same column of the row already held by the table
+         */
+        enum Merge {
+            OVERWRITE,      //`c` = values(`c`)
+            ADD,        //`c` = `c` + values(`c`), e.g. for counters
+            GREATEST        //`c` = greatest(`c`, values(`c`)), e.g. for timestamps and versions
+        };
+
+        /**
+         * @brief: the enumeration of the ways in which an "UPSERT" query refers to the values of its rows
+         */
+        enum UpsertSyntax {
+            VALUES_FUNCTION,        //"values(`c`)", the default, which MYSQL deprecates since 8.0.20
+            ROW_ALIAS       //"... values(...) as `new` on duplicate key update `c` = `new`.`c`", since MYSQL 8.0.19
+        };
+
         MYSQLBuilder();
 
+        MYSQLBuilder(const MYSQLBuilder &) = delete;
+
+        MYSQLBuilder &operator=(const MYSQLBuilder &) = delete;
+
+        /**
+         * @brief: the copy holds the same query, and has acquired at least as much memory as this MYSQLBuilder has
+         * @return IQueryBuilder *: the copy, owned by the caller
+         */
+        IQueryBuilder *clone() const override;
+
+        int restore(const IQueryBuilder &prototype) override;
+
+        /**
+         * @brief: acquires the memory for a query of the passed size at once, e.g. for a prototype of
+         * Factory::DialectRegistry, whose clones then acquire the same
+         * @param columns: the number of target-columns, or of columns of each Resource-representation
+         * @param rows: the number of Resource-representations
+         * @param conditions: the number of guard-conditions, and groups of them
+         * @param textLength: the total length of the values of the Resource-representations, and of the field-names
+         * and values of the guard-conditions
+         * @return int: custom error-number
+         */
+        int reserve(const std::size_t &columns, const std::size_t &rows, const std::size_t &conditions,
+                    const std::size_t &textLength);
+
         /**
          *
          * @param tableName
@@ -22,12 +86,30 @@ namespace DBQueryBuilder::Builder {
         int setTableName(const std::string &tableName) override;
 
         /**
-         *
+         * @brief: an "UPSERT" query is an "INSERT" query of the rows added, as many at once as the limits of
+         * setBatchLimits(const std::size_t &, const std::size_t &) allow, followed by an "on duplicate key update"-clause
          * @param action
          * @return
          */
         int setAction(const Action &action) override;
 
+        /**
+         * @brief: appends a column to those that an "UPSERT" query updates when a row's key is already held, in order;
+         * if none is appended, every column of the rows is overwritten; they are cleared by reset()
+         * @param column: the name of the column, which must be a column of the rows added
+         * @param merge: the expression that merges the value of the row into the held one
+         * @return int: custom error-number
+         */
+        int addUpsertColumn(const std::string &column, const Merge &merge = OVERWRITE);
+
+        /**
+         * @brief: sets the way in which an "UPSERT" query refers to the values of its rows; it is reset to
+         * VALUES_FUNCTION by reset()
+         * @param syntax
+         * @return int: custom error-number
+         */
+        int setUpsertSyntax(const UpsertSyntax &syntax);
+
         /**
          *
          * @param columns
@@ -49,6 +131,13 @@ namespace DBQueryBuilder::Builder {
          */
         int addCompositeCondition(const std::vector<std::shared_ptr<Type::QueryCondition>> qConditions) override;
 
+        /**
+         * @brief: the guard-conditions are copied, so the passed ConditionTree can be cleared and reused at once
+         * @param conditions
+         * @return
+         */
+        int addConditions(const Type::ConditionTree &conditions) override;
+
         /**
          *
          * @param resourceRep
@@ -56,6 +145,28 @@ namespace DBQueryBuilder::Builder {
          */
         int addResourceRep(const std::map<std::string, std::string> &resourceRep) override;
 
+        /**
+         *
+         * @param resourceRep
+         * @return
+         */
+        int addRow(const std::map<std::string, std::string> &resourceRep) override;
+
+        /**
+         *
+         * @param maxBytes
+         * @param maxRows
+         * @return
+         */
+        int setBatchLimits(const std::size_t &maxBytes, const std::size_t &maxRows) override;
+
+        /**
+         * @brief: rows are ordered by the byte-wise comparison of their values in the passed column
+         * @param columnName
+         * @return
+         */
+        int setBatchOrder(const std::string &columnName) override;
+
         /**
          *
          * @param columnName
@@ -71,27 +182,257 @@ namespace DBQueryBuilder::Builder {
          */
         int setLimit(const int &limit) override;
 
+        /**
+         * @brief: makes the query a page of the keyset-pagination over the passed unique key: it is ordered by every
+         * column of the key, in the passed order, and limited to the passed number of rows, replacing the "order by"
+         * clause and "limit" phrase set before; unlike an offset, the key lets every page be sought through the index of
+         * the key, so deep pages cost as much as the first
+         * @throws std::logic_error: if the key has no column or an empty one, the page-size is not positive, or the
+         * order is unknown
+         * @param keyColumns: the columns of a unique key, e.g. the primary key, most significant first
+         * @param pageSize: the greatest number of rows of a page
+         * @param order: the order in which the pages go through the key
+         * @return int: custom error-number
+         */
+        int setKeyset(const std::vector<std::string> &keyColumns, const int &pageSize, const Order &order = Order::ASC);
+
+        /**
+         * @brief: makes the query the page that follows the row of the passed key, usually the last row of the previous
+         * page, e.g. "where (`k1`, `k2`) > ('v1', 'v2') order by `k1` asc, `k2` asc limit 100", the key-comparison being
+         * in conjunction with the guard-conditions; an empty key makes the query the first page again
+         * @throws std::logic_error: if setKeyset(...) has not been called, or the key has not a value for every
+         * key-column
+         * @param lastKey: the values of the key-columns, in the order in which they were passed to setKeyset(...)
+         * @return int: custom error-number
+         */
+        int seekAfter(const std::vector<std::string> &lastKey);
+
+        /**
+         * @brief: puts the passed column in conjunction with the guard-conditions, as a member, or not, of the passed
+         * values, e.g. "where ( `a`='1') and `id` in ('1', '2', '3')", replacing the list set before; the values are
+         * sorted, by value if all of them are integers, and duplicates are dropped, so that a list of many values
+         * replaces as many point-lookups, or a disjunction of as many guard-conditions, with a query or a few
+         * @throws std::logic_error: if the column is empty, or there is no value
+         * @param column
+         * @param values
+         * @param negate: true, for a "not in"-list
+         * @return int: custom error-number
+         */
+        int setInList(const std::string &column, const std::vector<std::string> &values, const bool &negate = false);
+
+        /**
+         * @brief: as setInList(const std::string &, ...), for the row of the passed columns, e.g. of a composite key:
+         * "(`a`, `b`) in (('1', 'x'), ('2', 'y'))"; entries are sorted by their first column, then by the next
+         * @throws std::logic_error: if there is no column, or an empty one, there is no entry, or an entry has not a
+         * value for every column
+         * @param columns: the columns, most significant first
+         * @param entries: the values of the columns, in the order of the columns, for each entry
+         * @param negate: true, for a "not in"-list
+         * @return int: custom error-number
+         */
+        int setInList(const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &entries,
+                      const bool &negate = false);
+
+        /**
+         * @brief: sets the greatest number of entries of the "in"-list of each query of buildQueries(); a longer list
+         * is split into consecutive parts, a query each, so that no query blows the limits of the range optimizer, e.g.
+         * "range_optimizer_max_mem_size"; a "not in"-list is never split, and the "order by" clause applies to each
+         * query alone; a query with a "limit" phrase, or a page of setKeyset(...), is rejected by buildQueries() rather
+         * than split, as the queries together would return more rows than the limit; zero, the default, leaves the
+         * list whole
+         * @param maxEntries
+         * @return int: custom error-number
+         */
+        int setInListLimit(const std::size_t &maxEntries);
+
         /**
          *
          * @return
          */
         std::string buildQuery() override;
 
-        ~MYSQLBuilder() override;
+        /**
+         * @brief: "INSERT" queries are split; each has the form "insert into ... values(...), (...), ..."; so are
+         * queries whose "in"-list is longer than the limit of setInListLimit(const std::size_t &)
+         * @throws std::logic_error: if such a query has a "limit" phrase, or is a page of a keyset
+         * @return
+         */
+        std::vector<std::string> buildQueries() override;
 
-    private:
         /**
-         * @brief: describes the type of the query being built
+         * @brief: returns "INSERT" queries that push the rows of the passed ColumnBatch into the table set by
+         * setTableName(const std::string &), split by the limits set by
+         * setBatchLimits(const std::size_t &, const std::size_t &); the rows are rendered straight from the columns, in
+         * order, without being held by this builder
+         * @throws std::logic_error: if the table-name or the ColumnBatch is empty, or a number is not finite
+         * @throws std::length_error: if a single row cannot fit the byte-limit
+         * @param batch: the Resource-representations, column by column
+         * @return std::vector: the queries, in order
          */
-        class QueryDescriptor;
+        std::vector<std::string> buildColumnarInsert(const Type::ColumnBatch &batch);
 
         /**
-         * @brief: creates the main-clauses for MYSQL-queries
+         * @brief: the bit-flags of the checks that a "LOAD DATA" statement can be run without, through the statements
+         * of buildLoadDataPrologue(const int &) and buildLoadDataEpilogue(const int &)
          */
-        class MainClauseCreator;
+        enum LoadDataChecks {
+            UNIQUE_CHECKS = 1,      //"unique_checks": secondary unique indexes are not checked for duplicates
+            FOREIGN_KEY_CHECKS = 2      //"foreign_key_checks": foreign keys are not checked
+        };
 
+        /**
+         * @brief: receives the file of a "LOAD DATA" statement, a chunk at a time, e.g. to write it to a named pipe, or
+         * to pass it on from the local-infile handler of the connector
+         */
+        using LoadDataSink = std::function<void(const char *chars, const std::size_t &count)>;
+
+        /**
+         * @brief: returns the "LOAD DATA LOCAL INFILE" statement that loads the file at the passed path into the table
+         * set by setTableName(const std::string &), e.g. "load data local infile 'rows.tsv' into table `t` fields
+         * terminated by '\t' escaped by '\\' lines terminated by '\n' (`a`, `b`)"; the columns are those of the rows
+         * added through addRow(...) or addResourceRep(...), in the order of the fields of the file
+         * @throws std::logic_error: if the table-name is empty, no row has been added, or the format is ambiguous
+         * @param path: the path of the file, as the client reads it
+         * @param format: the layout of the file
+         * @return
+         */
+        std::string buildLoadDataStatement(const std::string &path, const LoadDataFormat &format = LoadDataFormat());
+
+        /**
+         * @brief: as buildLoadDataStatement(const std::string &, const LoadDataFormat &), for a file of the rows of
+         * ColumnBatches of the columns of the passed one
+         */
+        std::string buildLoadDataStatement(const std::string &path, const Type::ColumnBatch &batch,
+                                           const LoadDataFormat &format = LoadDataFormat());
+
+        /**
+         * @brief: appends the file of the statement returned by
+         * buildLoadDataStatement(const std::string &, const LoadDataFormat &) to the passed buffer, growing the buffer at
+         * most once; the rows are written in the order set by setBatchOrder(const std::string &)
+         * @throws std::logic_error: if no row has been added, or the format is ambiguous
+         * @param buffer: the caller-owned buffer that the file is appended to; its previous content is kept
+         * @param format: the layout of the file
+         * @return std::size_t: the number of bytes appended
+         */
+        std::size_t buildLoadDataPayloadInto(std::string &buffer, const LoadDataFormat &format = LoadDataFormat());
+
+        /**
+         * @brief: passes the file of the statement returned by
+         * buildLoadDataStatement(const std::string &, const LoadDataFormat &) to the passed sink, in chunks of the passed
+         * size, but the last; the file is never held whole
+         * @throws std::logic_error: if no row has been added, the chunk-size is zero, or the format is ambiguous
+         * @param sink: receives each chunk of the file, in order
+         * @param format: the layout of the file
+         * @param chunkSize: the number of bytes of each chunk
+         * @return std::size_t: the number of bytes passed to the sink
+         */
+        std::size_t streamLoadDataPayload(const LoadDataSink &sink, const LoadDataFormat &format = LoadDataFormat(),
+                                          const std::size_t &chunkSize = 64 * 1024);
+
+        /**
+         * @brief: passes the rows of the passed ColumnBatch, rendered straight from the columns, to the passed sink, in
+         * chunks of the passed size, but the last; neither the rows nor the file are held by this builder, so any number
+         * of rows can be loaded, a ColumnBatch at a time, into the same sink
+         * @throws std::logic_error: if the ColumnBatch has no column, the chunk-size is zero, the format is ambiguous,
+         * or a number is not finite
+         * @return std::size_t: the number of bytes passed to the sink
+         */
+        std::size_t streamLoadDataPayload(const Type::ColumnBatch &batch, const LoadDataSink &sink,
+                                          const LoadDataFormat &format = LoadDataFormat(),
+                                          const std::size_t &chunkSize = 64 * 1024);
+
+        /**
+         * @brief: returns the statements to be run, on the same connection, before a "LOAD DATA" statement, so that it
+         * runs without the passed checks; each keeps the setting of its check in a user-variable
+         * @throws std::logic_error: if a flag is not one of LoadDataChecks
+         * @param disabledChecks: the bit-wise or of LoadDataChecks
+         * @return std::vector: the statements, in order
+         */
+        static std::vector<std::string> buildLoadDataPrologue(const int &disabledChecks);
+
+        /**
+         * @brief: returns the statements that restore the checks disabled by the statements of
+         * buildLoadDataPrologue(const int &), to be run after the "LOAD DATA" statement, whether or not it succeeded
+         * @throws std::logic_error: if a flag is not one of LoadDataChecks
+         * @param disabledChecks: the bit-wise or of LoadDataChecks, as passed to buildLoadDataPrologue(const int &)
+         * @return std::vector: the statements, in order
+         */
+        static std::vector<std::string> buildLoadDataEpilogue(const int &disabledChecks);
+
+        /**
+         *
+         * @param buffer
+         * @return
+         */
+        std::size_t buildQueryInto(std::string &buffer) override;
+
+        /**
+         *
+         * @param buffer
+         * @param capacity
+         * @return
+         */
+        std::size_t buildQueryInto(char *buffer, const std::size_t &capacity) override;
+
+        /**
+         * @brief: the placeholder of a MYSQL-query is "?"
+         * @return
+         */
+        ParameterizedQuery buildParameterizedQuery() override;
+
+        /**
+         *
+         * @param query
+         * @return
+         */
+        std::size_t buildParameterizedQueryInto(ParameterizedQuery &query) override;
+
+        /**
+         * @brief: values that need no escaping, whether of rows or of guard-conditions, are pointed at where this
+         * builder holds them; escaped values, names and numbers are written into the storage of the FragmentedQuery
+         * @return
+         */
+        FragmentedQuery buildFragmentedQuery() override;
+
+        /**
+         *
+         * @param query
+         * @return
+         */
+        std::size_t buildFragmentedQueryInto(FragmentedQuery &query) override;
+
+        /**
+         * @brief: freezes the shape of the query built thus far into an immutable QueryTemplate, which any number of
+         * threads can then render at once with their own values, e.g. through
+         * Type::QueryTemplate::render(const std::vector<std::string_view> &, std::string &); the values are those of the
+         * rows, then of the guard-conditions, in the order in which the query holds them
+         * @throws std::logic_error: if the query cannot be built
+         * @return Type::QueryTemplate::Ptr: the QueryTemplate, shared with Type::TemplateCache if it caches QueryTemplates
+         */
+        Type::QueryTemplate::Ptr compile();
+
+        /**
+         * @brief: returns the heap-usage of all the calls of the member-functions of this MYSQLBuilder so far; all of it
+         * is zero unless DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS is defined
+         * @return
+         */
+        Diagnostics::AllocationStats allocationStats() const;
+
+        void resetAllocationStats();
+
+        /**
+         *
+         * @return
+         */
+        int reset() override;
+
+        ~MYSQLBuilder() override;
+
+    private:
         class Core;     //The implementer of MYSQLBuilder
 
+        explicit MYSQLBuilder(Core *core);
+
         Core *_core;        //pimpl
 };
 
@@ -0,0 +1,203 @@
+//
+// Created by fo on 19/04/2021.
+//
+// This file contains the definition of PostgreSQLBuilder, an implementer of IQueryBuilder.
+// PostgreSQLBuilder is responsible for building queries for PostgreSQL, and for bulk-loading rows through "COPY"
+#include "IQueryBuilder.h"
+#include "../diagnostics/Allocations.h"
+#include "../types/ConditionTree.h"
+#include <functional>
+
+#ifndef DBQUERYBUILDER_POSTGRESQLBUILDER_H
+#define DBQUERYBUILDER_POSTGRESQLBUILDER_H
+
+namespace DBQueryBuilder::Builder {
+
+    /**
+     * @brief: identifiers are double-quoted, and string-literals are written as standard_conforming_strings expects
+     * them, with their quotes doubled and their backslashes kept as they are; "UPDATE" and "DELETE" queries take no
+     * "order by" clause or "limit" phrase, and "UPSERT" queries are not built
+     */
+    class PostgreSQLBuilder : public IQueryBuilder {
+    public:
+        /**
+         * @brief: the enumeration of the formats of the payload of a "COPY ... FROM STDIN" command
+         */
+        enum CopyFormat {
+            TEXT,       //tab-separated fields, newline-terminated rows, with backslash-escapes
+            BINARY      //the "PGCOPY" signature, then length-prefixed fields
+        };
+
+        /**
+         * @brief: receives the payload of a "COPY" command, a chunk at a time, e.g. to pass it to PQputCopyData
+         */
+        using CopySink = std::function<void(const char *chars, const std::size_t &count)>;
+
+        PostgreSQLBuilder();
+
+        PostgreSQLBuilder(const PostgreSQLBuilder &) = delete;
+
+        PostgreSQLBuilder &operator=(const PostgreSQLBuilder &) = delete;
+
+        /**
+         * @brief: the copy holds the same query, and has acquired at least as much memory as this PostgreSQLBuilder has
+         * @return IQueryBuilder *: the copy, owned by the caller
+         */
+        IQueryBuilder *clone() const override;
+
+        int restore(const IQueryBuilder &prototype) override;
+
+        /**
+         * @brief: acquires the memory for a query of the passed size at once, e.g. for a prototype of
+         * Factory::DialectRegistry, whose clones then acquire the same
+         * @param columns: the number of target-columns, or of columns of each Resource-representation
+         * @param rows: the number of Resource-representations
+         * @param conditions: the number of guard-conditions, and groups of them
+         * @param textLength: the total length of the values of the Resource-representations, and of the field-names
+         * and values of the guard-conditions
+         * @return int: custom error-number
+         */
+        int reserve(const std::size_t &columns, const std::size_t &rows, const std::size_t &conditions,
+                    const std::size_t &textLength);
+
+        int setTableName(const std::string &tableName) override;
+
+        int setAction(const Action &action) override;
+
+        int setTargetColumns(const std::vector<std::string> &columns) override;
+
+        int addCondition(const std::shared_ptr<Type::QueryCondition> &qCondition) override;
+
+        int addCompositeCondition(const std::vector<std::shared_ptr<Type::QueryCondition>> qConditions) override;
+
+        /**
+         * @brief: the guard-conditions are copied, so the passed ConditionTree can be cleared and reused at once
+         * @param conditions
+         * @return
+         */
+        int addConditions(const Type::ConditionTree &conditions) override;
+
+        int addResourceRep(const std::map<std::string, std::string> &resourceRep) override;
+
+        /**
+         * @brief: the rows appended are pushed either by "INSERT" queries or, in bulk, by a "COPY" command
+         * @param resourceRep
+         * @return
+         */
+        int addRow(const std::map<std::string, std::string> &resourceRep) override;
+
+        int setBatchLimits(const std::size_t &maxBytes, const std::size_t &maxRows) override;
+
+        /**
+         * @brief: rows are ordered by the byte-wise comparison of their values in the passed column, in "INSERT" queries
+         * and in the payloads of "COPY" commands alike
+         * @param columnName
+         * @return
+         */
+        int setBatchOrder(const std::string &columnName) override;
+
+        /**
+         * @brief: only "SELECT" queries are ordered
+         * @param columnName
+         * @param order
+         * @return
+         */
+        int setOrder(const std::string &columnName, const Order &order) override;
+
+        /**
+         * @brief: only "SELECT" queries are limited
+         * @param limit
+         * @return
+         */
+        int setLimit(const int &limit) override;
+
+        std::string buildQuery() override;
+
+        /**
+         * @brief: only "INSERT" queries are split; each has the form "insert into ... values(...), (...), ..."
+         * @return
+         */
+        std::vector<std::string> buildQueries() override;
+
+        std::size_t buildQueryInto(std::string &buffer) override;
+
+        std::size_t buildQueryInto(char *buffer, const std::size_t &capacity) override;
+
+        /**
+         * @brief: the placeholders of a PostgreSQL-query are numbered, "$1", "$2", ..., in order of appearance
+         * @return
+         */
+        ParameterizedQuery buildParameterizedQuery() override;
+
+        std::size_t buildParameterizedQueryInto(ParameterizedQuery &query) override;
+
+        /**
+         * @brief: values that need no escaping, whether of rows or of guard-conditions, are pointed at where this
+         * builder holds them; escaped values and names are written into the storage of the FragmentedQuery
+         * @return
+         */
+        FragmentedQuery buildFragmentedQuery() override;
+
+        std::size_t buildFragmentedQueryInto(FragmentedQuery &query) override;
+
+        /**
+         * @brief: returns the "COPY" command that loads the rows added through addRow(...) or addResourceRep(...) into
+         * the table set by setTableName(const std::string &), e.g. 'copy "t"("a", "b") from stdin'; its payload is
+         * produced by buildCopyPayloadInto(...) or streamCopyPayload(...)
+         * @throws std::logic_error: if the table-name is empty, or no row has been added
+         * @param format: the format of the payload
+         * @return
+         */
+        std::string buildCopyCommand(const CopyFormat &format = TEXT);
+
+        /**
+         * @brief: appends the payload of the command returned by buildCopyCommand(const CopyFormat &) to the passed
+         * buffer, growing the buffer at most once; the binary format sends every value as the bytes of its text, which
+         * suits columns of the types text, varchar and bytea
+         * @throws std::logic_error: if no row has been added, or, in the text format, a value holds a NUL-character
+         * @throws std::length_error: if, in the binary format, a value is longer than a field can be
+         * @param buffer: the caller-owned buffer that the payload is appended to; its previous content is kept
+         * @param format: the format of the payload
+         * @return std::size_t: the number of bytes appended
+         */
+        std::size_t buildCopyPayloadInto(std::string &buffer, const CopyFormat &format = TEXT);
+
+        /**
+         * @brief: passes the payload of the command returned by buildCopyCommand(const CopyFormat &) to the passed sink,
+         * in chunks of the passed size, but the last; the payload is never held whole, so rows of any total size can be
+         * loaded
+         * @throws std::logic_error: if no row has been added, the chunk-size is zero, or, in the text format, a value
+         * holds a NUL-character
+         * @throws std::length_error: if, in the binary format, a value is longer than a field can be
+         * @param sink: receives each chunk of the payload, in order
+         * @param format: the format of the payload
+         * @param chunkSize: the number of bytes of each chunk
+         * @return std::size_t: the number of bytes passed to the sink
+         */
+        std::size_t streamCopyPayload(const CopySink &sink, const CopyFormat &format = TEXT,
+                                      const std::size_t &chunkSize = 64 * 1024);
+
+        /**
+         * @brief: returns the heap-usage of all the calls of the member-functions of this PostgreSQLBuilder so far; all
+         * of it is zero unless DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS is defined
+         * @return
+         */
+        Diagnostics::AllocationStats allocationStats() const;
+
+        void resetAllocationStats();
+
+        int reset() override;
+
+        ~PostgreSQLBuilder() override;
+
+    private:
+        class Core;     //The implementer of PostgreSQLBuilder
+
+        explicit PostgreSQLBuilder(Core *core);
+
+        Core *_core;        //pimpl
+    };
+
+}
+
+#endif //DBQUERYBUILDER_POSTGRESQLBUILDER_H
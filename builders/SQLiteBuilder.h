@@ -0,0 +1,236 @@
+//
+// Created by fo on 20/04/2021.
+//
+// This file contains the definition of SQLiteBuilder, an implementer of IQueryBuilder.
+// SQLiteBuilder is responsible for building queries for SQLite
+#include "IQueryBuilder.h"
+#include "../diagnostics/Allocations.h"
+#include "../types/ConditionTree.h"
+
+#ifndef DBQUERYBUILDER_SQLITEBUILDER_H
+#define DBQUERYBUILDER_SQLITEBUILDER_H
+
+namespace DBQueryBuilder::Builder {
+
+    /**
+     * @brief: identifiers are double-quoted, and string-literals have their quotes doubled; "UPDATE" and "DELETE"
+     * queries take no "order by" clause or "limit" phrase, which SQLite only accepts when built with
+     * SQLITE_ENABLE_UPDATE_DELETE_LIMIT; "UPSERT" queries are not built, setConflict(const Conflict &) resolving the
+     * conflicts of "INSERT" queries instead
+     */
+    class SQLiteBuilder : public IQueryBuilder {
+    public:
+        /**
+         * @brief: the enumeration of the resolutions of the conflicts of the rows of an "INSERT" query with the rows
+         * already held by the table, e.g. with the same primary key
+         */
+        enum Conflict {
+            ABORT,      //"insert into": the query fails, which is the default
+            REPLACE,        //"insert or replace into": the conflicting rows are deleted first
+            IGNORE      //"insert or ignore into": the conflicting rows are skipped
+        };
+
+        static constexpr std::size_t defaultMaxVariables = 32766;       //SQLITE_MAX_VARIABLE_NUMBER, since SQLite 3.32.0
+
+        SQLiteBuilder();
+
+        SQLiteBuilder(const SQLiteBuilder &) = delete;
+
+        SQLiteBuilder &operator=(const SQLiteBuilder &) = delete;
+
+        /**
+         * @brief: the copy holds the same query, and has acquired at least as much memory as this SQLiteBuilder has
+         * @return IQueryBuilder *: the copy, owned by the caller
+         */
+        IQueryBuilder *clone() const override;
+
+        int restore(const IQueryBuilder &prototype) override;
+
+        /**
+         * @brief: acquires the memory for a query of the passed size at once, e.g. for a prototype of
+         * Factory::DialectRegistry, whose clones then acquire the same
+         * @param columns: the number of target-columns, or of columns of each Resource-representation
+         * @param rows: the number of Resource-representations
+         * @param conditions: the number of guard-conditions, and groups of them
+         * @param textLength: the total length of the values of the Resource-representations, and of the field-names
+         * and values of the guard-conditions
+         * @return int: custom error-number
+         */
+        int reserve(const std::size_t &columns, const std::size_t &rows, const std::size_t &conditions,
+                    const std::size_t &textLength);
+
+        int setTableName(const std::string &tableName) override;
+
+        int setAction(const Action &action) override;
+
+        /**
+         * @brief: sets the resolution of the conflicts of the rows of an "INSERT" query with the rows already held by
+         * the table; it is reset to ABORT by reset()
+         * @param conflict
+         * @return int: custom error-number
+         */
+        int setConflict(const Conflict &conflict);
+
+        /**
+         * @brief: sets the greatest number of values that a query of buildParameterizedQueries() binds, e.g. from
+         * sqlite3_limit(db, SQLITE_LIMIT_VARIABLE_NUMBER, -1) of the connection the queries are run on; it is reset to
+         * defaultMaxVariables by reset(), so a builder that is reset for each query must be given it again
+         * @throws std::logic_error: if the passed number is zero
+         * @param maxVariables
+         * @return int: custom error-number
+         */
+        int setMaxVariables(const std::size_t &maxVariables);
+
+        int setTargetColumns(const std::vector<std::string> &columns) override;
+
+        int addCondition(const std::shared_ptr<Type::QueryCondition> &qCondition) override;
+
+        int addCompositeCondition(const std::vector<std::shared_ptr<Type::QueryCondition>> qConditions) override;
+
+        /**
+         * @brief: the guard-conditions are copied, so the passed ConditionTree can be cleared and reused at once
+         * @param conditions
+         * @return
+         */
+        int addConditions(const Type::ConditionTree &conditions) override;
+
+        int addResourceRep(const std::map<std::string, std::string> &resourceRep) override;
+
+        int addRow(const std::map<std::string, std::string> &resourceRep) override;
+
+        /**
+         * @brief: SQLite prepares a query of thousands of rows more slowly, per row, than a few queries of hundreds;
+         * see benchmarks/SQLite.cpp
+         * @param maxBytes
+         * @param maxRows
+         * @return
+         */
+        int setBatchLimits(const std::size_t &maxBytes, const std::size_t &maxRows) override;
+
+        /**
+         * @brief: rows are ordered by the byte-wise comparison of their values in the passed column
+         * @param columnName
+         * @return
+         */
+        int setBatchOrder(const std::string &columnName) override;
+
+        /**
+         * @brief: only "SELECT" queries are ordered
+         * @param columnName
+         * @param order
+         * @return
+         */
+        int setOrder(const std::string &columnName, const Order &order) override;
+
+        /**
+         * @brief: only "SELECT" queries are limited
+         * @param limit
+         * @return
+         */
+        int setLimit(const int &limit) override;
+
+        /**
+         * @brief: puts the passed column in conjunction with the guard-conditions, as a member, or not, of the passed
+         * values, e.g. 'where ( "a"='1') and "id" in ('1', '2', '3')', replacing the list set before; the values are
+         * sorted, by value if all of them are integers, and duplicates are dropped
+         * @throws std::logic_error: if the column is empty, or there is no value
+         * @param column
+         * @param values
+         * @param negate: true, for a "not in"-list
+         * @return int: custom error-number
+         */
+        int setInList(const std::string &column, const std::vector<std::string> &values, const bool &negate = false);
+
+        /**
+         * @brief: as setInList(const std::string &, ...), for the row of the passed columns, e.g. of a composite key:
+         * '("a", "b") in (('1', 'x'), ('2', 'y'))'; entries are sorted by their first column, then by the next
+         * @throws std::logic_error: if there is no column, or an empty one, there is no entry, or an entry has not a
+         * value for every column
+         * @param columns: the columns, most significant first
+         * @param entries: the values of the columns, in the order of the columns, for each entry
+         * @param negate: true, for a "not in"-list
+         * @return int: custom error-number
+         */
+        int setInList(const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &entries,
+                      const bool &negate = false);
+
+        /**
+         * @brief: sets the greatest number of entries of the "in"-list of each query of buildQueries() and
+         * buildParameterizedQueries(), which also splits a list that binds more values than setMaxVariables(...)
+         * allows; a longer list is split into consecutive parts, a query each; a "not in"-list is never split, and the
+         * "order by" clause applies to each query alone; a query with a "limit" phrase is rejected rather than split,
+         * as the queries together would return more rows than the limit; zero, the default, leaves the list whole
+         * @param maxEntries
+         * @return int: custom error-number
+         */
+        int setInListLimit(const std::size_t &maxEntries);
+
+        std::string buildQuery() override;
+
+        /**
+         * @brief: "INSERT" queries are split; each has the form "insert into ... values(...), (...), ..."; so are
+         * queries whose "in"-list is longer than the limit of setInListLimit(const std::size_t &)
+         * @throws std::logic_error: if such a query has a "limit" phrase, or is a page of a keyset
+         * @return
+         */
+        std::vector<std::string> buildQueries() override;
+
+        std::size_t buildQueryInto(std::string &buffer) override;
+
+        std::size_t buildQueryInto(char *buffer, const std::size_t &capacity) override;
+
+        /**
+         * @brief: the placeholders of a SQLite-query are numbered, "?1", "?2", ..., in order of appearance, so that the
+         * value of the placeholder "?N" is bound with sqlite3_bind_*(statement, N, ...)
+         * @return
+         */
+        ParameterizedQuery buildParameterizedQuery() override;
+
+        std::size_t buildParameterizedQueryInto(ParameterizedQuery &query) override;
+
+        /**
+         * @brief: returns the query that has been built thus far, with every value replaced by a placeholder; an
+         * "INSERT" query is split into multi-row queries, each binding at most the number of values set by
+         * setMaxVariables(const std::size_t &), and pushing at most the number of rows set by
+         * setBatchLimits(const std::size_t &, const std::size_t &), whose byte-limit is not applied; a query with an
+         * "in"-list is split into queries of whole entries alike, bounded by setInListLimit(const std::size_t &) as well
+         * @throws std::length_error: if a single row or entry, or a query that is not split, has more values than can be
+         * bound
+         * @throws std::logic_error: if a query split by its "in"-list has a "limit" phrase
+         * @return std::vector: the queries, in order, each numbering its placeholders from "?1"
+         */
+        std::vector<ParameterizedQuery> buildParameterizedQueries();
+
+        /**
+         * @brief: values that need no escaping, whether of rows or of guard-conditions, are pointed at where this
+         * builder holds them; escaped values and names are written into the storage of the FragmentedQuery
+         * @return
+         */
+        FragmentedQuery buildFragmentedQuery() override;
+
+        std::size_t buildFragmentedQueryInto(FragmentedQuery &query) override;
+
+        /**
+         * @brief: returns the heap-usage of all the calls of the member-functions of this SQLiteBuilder so far; all of
+         * it is zero unless DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS is defined
+         * @return
+         */
+        Diagnostics::AllocationStats allocationStats() const;
+
+        void resetAllocationStats();
+
+        int reset() override;
+
+        ~SQLiteBuilder() override;
+
+    private:
+        class Core;     //The implementer of SQLiteBuilder
+
+        explicit SQLiteBuilder(Core *core);
+
+        Core *_core;        //pimpl
+    };
+
+}
+
+#endif //DBQUERYBUILDER_SQLITEBUILDER_H
@@ -0,0 +1,426 @@
+//
+// Created by fo on 11/04/2021.
+//
+// This file contains the definition of StaticQuery, a query whose shape is fixed at compile-time, and of the
+// constexpr-functions, in DBQueryBuilder::Builder::Static, that compose it. A StaticQuery renders the same text that
+// MYSQLBuilder renders for the same shape, but only its values are written at runtime
+#include "../types/QueryCondition.h"
+#include "../utils/Escaper.h"
+#include "IQueryBuilder.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#ifndef DBQUERYBUILDER_STATICQUERY_H
+#define DBQUERYBUILDER_STATICQUERY_H
+
+namespace DBQueryBuilder::Builder {
+
+    /**
+     * @brief: the literal text of a query, with the positions of the slots that its values are written into; both are
+     * computed at compile-time
+     * @tparam Length: the number of literal characters
+     * @tparam Slots: the number of values
+     */
+    template<std::size_t Length, std::size_t Slots>
+    class StaticQuery {
+        template<std::size_t, std::size_t>
+        friend class StaticQuery;
+
+        char _text[Length + 1]{};       //the literal text, without its values
+        std::size_t _cuts[Slots + 1]{};     //the position, within _text, of each slot
+
+    public:
+        constexpr StaticQuery() = default;
+
+        /**
+         * @param chars: a string-literal, holding no slot
+         */
+        constexpr explicit StaticQuery(const char (&chars)[Length + 1]) {
+            static_assert(Slots == 0, "a StaticQuery made from a string-literal holds no slot");
+            for (std::size_t i = 0; i < Length; ++i) {
+                _text[i] = chars[i];
+            }
+        }
+
+        /**
+         * @brief: returns the passed StaticQueries, one after the other
+         */
+        template<std::size_t L2, std::size_t S2>
+        constexpr StaticQuery<Length + L2, Slots + S2> operator+(const StaticQuery<L2, S2> &other) const {
+            StaticQuery<Length + L2, Slots + S2> joined;
+            for (std::size_t i = 0; i < Length; ++i) {
+                joined._text[i] = _text[i];
+            }
+            for (std::size_t i = 0; i < L2; ++i) {
+                joined._text[Length + i] = other._text[i];
+            }
+
+            for (std::size_t i = 0; i < Slots; ++i) {
+                joined._cuts[i] = _cuts[i];
+            }
+            for (std::size_t i = 0; i < S2; ++i) {
+                joined._cuts[Slots + i] = Length + other._cuts[i];
+            }
+
+            return joined;
+        }
+
+        static constexpr std::size_t length() {
+            return Length;
+        }
+
+        static constexpr std::size_t slots() {
+            return Slots;
+        }
+
+        /**
+         * @brief: returns the literal text of this StaticQuery, without its values
+         */
+        constexpr std::string_view text() const {
+            return std::string_view(_text, Length);
+        }
+
+        /**
+         * @brief: returns the text of this StaticQuery, with a "?" placeholder in the place of every value
+         */
+        constexpr StaticQuery<Length + Slots, 0> parameterized() const {
+            StaticQuery<Length + Slots, 0> sql;
+            std::size_t begin = 0, out = 0;     //the beginning of the present literal segment, and the next position in sql
+            for (std::size_t i = 0; i <= Slots; ++i) {
+                const std::size_t end = i < Slots ? _cuts[i] : Length;
+                for (std::size_t j = begin; j < end; ++j) {
+                    sql._text[out++] = _text[j];
+                }
+                if (i < Slots) {
+                    sql._text[out++] = '?';
+                }
+                begin = end;
+            }
+
+            return sql;
+        }
+
+        /**
+         * @brief: appends this StaticQuery, with the passed values escaped and quoted in its slots, to the passed buffer,
+         * growing the buffer at most once
+         * @param buffer: the caller-owned buffer that the query is appended to; its previous content is kept
+         * @param values: the values of the slots, in order; anything a std::string_view can be made from
+         * @return std::size_t: the number of characters appended
+         */
+        template<typename... Values>
+        inline std::size_t renderInto(std::string &buffer, const Values &... values) const {
+            static_assert(sizeof...(Values) == Slots, "the number of values does not match the number of slots");
+            const std::string_view views[Slots + 1] = {std::string_view(values)...};
+
+            //measure the query; only the values need to be measured
+            std::size_t length = Length + 2 * Slots;
+            for (std::size_t i = 0; i < Slots; ++i) {
+                length += DBQueryBuilder::Util::Escaper::literalLength(views[i].data(), views[i].size());
+            }
+
+            const std::size_t offset = buffer.size();
+            buffer.resize(offset + length);
+            char *cursor = &buffer[offset];
+
+            std::size_t begin = 0;      //the beginning of the literal segment before the present slot
+            for (std::size_t i = 0; i < Slots; ++i) {
+                std::memcpy(cursor, _text + begin, _cuts[i] - begin);
+                cursor += _cuts[i] - begin;
+
+                *cursor++ = '\'';
+                cursor = DBQueryBuilder::Util::Escaper::escapeLiteral(views[i].data(), views[i].size(), cursor);
+                *cursor++ = '\'';
+
+                begin = _cuts[i];
+            }
+            std::memcpy(cursor, _text + begin, Length - begin);
+
+            return length;
+        }
+
+        /**
+         * @brief: returns this StaticQuery, with the passed values escaped and quoted in its slots
+         */
+        template<typename... Values>
+        inline std::string render(const Values &... values) const {
+            std::string query;      //the query to be returned
+            renderInto(query, values...);
+
+            return query;
+        }
+    };
+
+    namespace Static {
+
+        using QueryCondition = DBQueryBuilder::Type::QueryCondition;
+
+        /**
+         * @brief: a guard-condition whose shape is fixed at compile-time
+         * @tparam Conj: the conjunction that joins the guard-condition to the one before it
+         * @tparam Composite: true, if the guard-condition is parenthesis-delimited
+         */
+        template<QueryCondition::Conjunction Conj, bool Composite, std::size_t Length, std::size_t Slots>
+        struct Condition {
+            StaticQuery<Length, Slots> body;       //the guard-condition, without its conjunction
+        };
+
+        /**
+         * @brief: the names of the columns of a query, each already quoted
+         */
+        template<typename... Names>
+        struct Columns {
+            std::tuple<Names...> names;
+        };
+
+        /**
+         * @brief: returns the passed string-literal, as a StaticQuery
+         */
+        template<std::size_t N>
+        constexpr StaticQuery<N - 1, 0> text(const char (&chars)[N]) {
+            return StaticQuery<N - 1, 0>(chars);
+        }
+
+        /**
+         * @brief: returns the passed name, backtick-quoted; names that would need escaping are rejected, which fails
+         * the compilation of a constant expression
+         * @throws std::logic_error: if the name is empty or holds a backtick or a NUL-character
+         */
+        template<std::size_t N>
+        constexpr StaticQuery<N + 1, 0> identifier(const char (&name)[N]) {
+            if (N == 1) {       //the name is empty
+                throw std::logic_error("In Builder::Static::identifier: empty name");
+            }
+
+            StaticQuery<N + 1, 0> quoted = text("`") + text(name) + text("`");
+            for (std::size_t i = 0; i + 1 < N; ++i) {
+                if (name[i] == '`' || name[i] == '\0') {       //the name would need escaping
+                    throw std::logic_error("In Builder::Static::identifier: a static name cannot hold a backtick or a NUL-character");
+                }
+            }
+
+            return quoted;
+        }
+
+        /**
+         * @brief: returns nothing, e.g. for a clause that a query does not set
+         */
+        constexpr StaticQuery<0, 0> none() {
+            return StaticQuery<0, 0>();
+        }
+
+        /**
+         * @brief: returns a slot, in which a value is written at runtime
+         */
+        constexpr StaticQuery<0, 1> value() {
+            return StaticQuery<0, 1>();     //the only slot is at the beginning
+        }
+
+        /**
+         * @brief: returns the passed StaticQueries, with the passed separator between every two of them
+         */
+        template<std::size_t N, typename First, typename... Rest>
+        constexpr auto join(const char (&separator)[N], const First &first, const Rest &... rest) {
+            return (first + ... + (text(separator) + rest));
+        }
+
+        /**
+         * @brief: returns the names of the passed columns; no name, for every column
+         */
+        template<std::size_t... N>
+        constexpr auto columns(const char (&... names)[N]) {
+            return Columns<StaticQuery<N + 1, 0>...>{std::make_tuple(identifier(names)...)};
+        }
+
+        template<QueryCondition::Conjunction Conj>
+        constexpr auto conjunction() {
+            static_assert(Conj == QueryCondition::AND || Conj == QueryCondition::OR, "the conjunction-type is unknown");
+            if constexpr (Conj == QueryCondition::AND) {
+                return text("and");
+            } else {
+                return text("or");
+            }
+        }
+
+        template<QueryCondition::Operator Op>
+        constexpr auto operation() {
+            static_assert(Op >= QueryCondition::E && Op <= QueryCondition::GE, "the operator-type is unknown");
+            if constexpr (Op == QueryCondition::E) {
+                return text("=");
+            } else if constexpr (Op == QueryCondition::L) {
+                return text("<");
+            } else if constexpr (Op == QueryCondition::G) {
+                return text(">");
+            } else if constexpr (Op == QueryCondition::LE) {
+                return text("<=");
+            } else {
+                return text(">=");
+            }
+        }
+
+        /**
+         * @brief: returns a guard-condition on the passed field, whose value is written at runtime
+         * @tparam Conj: the conjunction that joins the guard-condition to the one before it
+         * @tparam Op: the operator that compares the field with its value
+         * @tparam Negate: true, if the comparison is negated
+         */
+        template<QueryCondition::Conjunction Conj, QueryCondition::Operator Op, bool Negate = false, std::size_t N>
+        constexpr auto condition(const char (&field)[N]) {
+            if constexpr (Negate) {
+                auto body = text(" not ") + identifier(field) + operation<Op>() + value();
+                return Condition<Conj, false, decltype(body)::length(), decltype(body)::slots()>{body};
+            } else {
+                auto body = text(" ") + identifier(field) + operation<Op>() + value();
+                return Condition<Conj, false, decltype(body)::length(), decltype(body)::slots()>{body};
+            }
+        }
+
+        /**
+         * @brief: returns the passed guard-condition, preceded by its conjunction
+         */
+        template<QueryCondition::Conjunction Conj, bool Composite, std::size_t Length, std::size_t Slots>
+        constexpr auto conjoined(const Condition<Conj, Composite, Length, Slots> &qCondition) {
+            if constexpr (Composite) {
+                return text(" ") + conjunction<Conj>() + text(" ") + qCondition.body;
+            } else {
+                return text(" ") + conjunction<Conj>() + qCondition.body;
+            }
+        }
+
+        /**
+         * @brief: returns a parenthesis-delimited composite guard-condition, formed from the passed guard-conditions;
+         * it is joined to the guard-condition before it by the conjunction of its first component
+         */
+        template<QueryCondition::Conjunction Conj, bool Composite, std::size_t Length, std::size_t Slots,
+                typename... Rest>
+        constexpr auto group(const Condition<Conj, Composite, Length, Slots> &first, const Rest &... rest) {
+            auto body = text("(") + (first.body + ... + conjoined(rest)) + text(")");
+            return Condition<Conj, true, decltype(body)::length(), decltype(body)::slots()>{body};
+        }
+
+        /**
+         * @brief: returns the "where"-clause formed from the passed guard-conditions; the conjunction of the first one
+         * is dropped
+         */
+        template<QueryCondition::Conjunction Conj, bool Composite, std::size_t Length, std::size_t Slots,
+                typename... Rest>
+        constexpr auto where(const Condition<Conj, Composite, Length, Slots> &first, const Rest &... rest) {
+            return text("where ") + (first.body + ... + conjoined(rest));
+        }
+
+        /**
+         * @brief: returns the "order by"-clause, on the passed column
+         */
+        template<Order Direction, std::size_t N>
+        constexpr auto orderBy(const char (&columnName)[N]) {
+            static_assert(Direction == Order::ASC || Direction == Order::DEC, "the order is unknown");
+            if constexpr (Direction == Order::ASC) {
+                return text("order by ") + identifier(columnName) + text(" asc");
+            } else {
+                return text("order by ") + identifier(columnName) + text(" desc");
+            }
+        }
+
+        /**
+         * @brief: returns the number of characters of the decimal form of the passed number
+         */
+        constexpr std::size_t digits(long long number) {
+            std::size_t count = number <= 0 ? 1 : 0;
+            for (; number != 0; number /= 10) {
+                ++count;
+            }
+
+            return count;
+        }
+
+        /**
+         * @brief: returns the "limit"-phrase, of the passed number of database-entities
+         */
+        template<int Limit>
+        constexpr auto limit() {
+            char chars[digits(Limit) + 1]{};
+            long long rest = Limit < 0 ? -static_cast<long long>(Limit) : Limit;
+            for (std::size_t i = digits(Limit); i-- > 0;) {
+                chars[i] = static_cast<char>('0' + rest % 10);
+                rest /= 10;
+            }
+            if (Limit < 0) {
+                chars[0] = '-';
+            }
+
+            return text("limit ") + StaticQuery<digits(Limit), 0>(chars);
+        }
+
+        /**
+         * @brief: returns a "SELECT" query; the clauses that are not set are none()
+         * @param columns: the columns to be selected; columns(), for every column
+         * @param tableName: the name of the concerned table
+         * @param whereClause: the "where"-clause, from where(...)
+         * @param orderClause: the "order by"-clause, from orderBy(...)
+         * @param limitPhrase: the "limit"-phrase, from limit<...>()
+         */
+        template<typename... Names, std::size_t N, typename Where = StaticQuery<0, 0>,
+                typename OrderBy = StaticQuery<0, 0>, typename Limit = StaticQuery<0, 0>>
+        constexpr auto select(const Columns<Names...> &columns, const char (&tableName)[N], const Where &whereClause = Where(),
+                              const OrderBy &orderClause = OrderBy(), const Limit &limitPhrase = Limit()) {
+            auto head = [&]() {
+                if constexpr (sizeof...(Names) == 0) {
+                    return text("select *");
+                } else {
+                    return text("select  ") + std::apply([](const auto &... names) { return join(", ", names...); },
+                                                         columns.names);
+                }
+            }();
+
+            return head + text(" from ") + identifier(tableName) + text(" ") + whereClause + text(" ") + orderClause +
+                   text(" ") + limitPhrase;
+        }
+
+        /**
+         * @brief: returns an "INSERT" query of a single row, whose values are written at runtime in the order of the
+         * passed columns
+         */
+        template<typename First, typename... Names, std::size_t N>
+        constexpr auto insert(const char (&tableName)[N], const Columns<First, Names...> &columns) {
+            auto names = std::apply([](const auto &... names) { return join(", ", names...); }, columns.names);
+            auto values = std::apply([](const auto &... names) { return join(", ", (static_cast<void>(names), value())...); },
+                                     columns.names);
+
+            return text("insert into ") + identifier(tableName) + text("(") + names + text(") values(") + values +
+                   text(")");
+        }
+
+        /**
+         * @brief: returns an "UPDATE" query, whose values are written at runtime, first those of the passed columns, in
+         * order, then those of the "where"-clause
+         */
+        template<typename First, typename... Names, std::size_t N, typename Where = StaticQuery<0, 0>,
+                typename OrderBy = StaticQuery<0, 0>, typename Limit = StaticQuery<0, 0>>
+        constexpr auto update(const char (&tableName)[N], const Columns<First, Names...> &columns,
+                              const Where &whereClause = Where(), const OrderBy &orderClause = OrderBy(),
+                              const Limit &limitPhrase = Limit()) {
+            auto assignments = std::apply([](const auto &... names) { return join(", ", (names + text("=") + value())...); },
+                                          columns.names);
+
+            return text("update ") + identifier(tableName) + text(" set") + assignments + text(" ") + whereClause +
+                   text(" ") + orderClause + text(" ") + limitPhrase;
+        }
+
+        /**
+         * @brief: returns a "DELETE" query, whose values are those of the "where"-clause
+         */
+        template<std::size_t N, typename Where = StaticQuery<0, 0>, typename OrderBy = StaticQuery<0, 0>,
+                typename Limit = StaticQuery<0, 0>>
+        constexpr auto remove(const char (&tableName)[N], const Where &whereClause = Where(),
+                              const OrderBy &orderClause = OrderBy(), const Limit &limitPhrase = Limit()) {
+            return text("delete from ") + identifier(tableName) + text(" ") + whereClause + text(" ") + orderClause +
+                   text(" ") + limitPhrase;
+        }
+
+    }
+}
+
+#endif //DBQUERYBUILDER_STATICQUERY_H
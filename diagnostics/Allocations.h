@@ -0,0 +1,171 @@
+//
+// Created by fo on 15/04/2021.
+//
+// This file contains the definition of the allocation-accounting of the builders: AllocationStats, AllocationCounter,
+// AllocationScope and StringWatch. The accounting is compiled only when DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS is
+// defined, for the whole program; otherwise, every counter stays empty and every scope and watch compiles to nothing
+#include <cstddef>
+#include <string>
+
+#ifndef DBQUERYBUILDER_ALLOCATIONS_H
+#define DBQUERYBUILDER_ALLOCATIONS_H
+
+namespace DBQueryBuilder::Diagnostics {
+
+    /**
+     * @brief: the heap-usage of the operations on an object, e.g. the calls of the member-functions of a MYSQLBuilder
+     */
+    struct AllocationStats {
+#ifdef DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS
+        static constexpr bool enabled = true;
+#else
+        static constexpr bool enabled = false;      //whether allocations are being accounted; if not, all is zero
+#endif
+
+        std::size_t operations{0};      //the number of operations accounted
+        std::size_t allocations{0};     //the number of calls of operator new
+        std::size_t bytesAllocated{0};
+        std::size_t deallocations{0};       //the number of calls of operator delete
+        std::size_t bytesDeallocated{0};
+        std::size_t peakBytes{0};       //the greatest growth of the heap during a single operation
+        std::size_t retainedCapacity{0};        //the capacity held by the object after its last operation
+        std::size_t peakRetainedCapacity{0};        //the greatest capacity held by the object after any operation
+        std::size_t stringReallocations{0};     //the number of times a string holding text was moved to a larger buffer
+    };
+
+    /**
+     * @brief: accumulates the AllocationStats of the operations on one object
+     */
+    class AllocationCounter {
+    public:
+        /**
+         * @brief: returns the heap-usage accumulated so far
+         * @return
+         */
+        inline AllocationStats stats() const {
+#ifdef DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS
+            return _stats;
+#else
+            return {};
+#endif
+        }
+
+        inline void reset() {
+#ifdef DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS
+            _stats = AllocationStats();
+#endif
+        }
+
+        /**
+         * @brief: records the capacity held by the object after an operation; the passed function is only called when
+         * allocations are being accounted
+         * @param capacity: returns the capacity, in bytes
+         */
+        template<typename Capacity>
+        inline void retain(const Capacity &capacity) {
+#ifdef DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS
+            _stats.retainedCapacity = capacity();
+            if (_stats.retainedCapacity > _stats.peakRetainedCapacity) {
+                _stats.peakRetainedCapacity = _stats.retainedCapacity;
+            }
+#else
+            (void) capacity;
+#endif
+        }
+
+    private:
+#ifdef DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS
+        friend class AllocationScope;
+
+        AllocationStats _stats;
+#endif
+    };
+
+    /**
+     * @brief: accounts, to an AllocationCounter, as one operation, the allocations made by the calling thread from its
+     * construction to its destruction; the allocations of a scope nested within another are accounted to both
+     */
+    class AllocationScope {
+    public:
+#ifdef DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS
+        explicit AllocationScope(AllocationCounter &counter);
+
+        ~AllocationScope();
+
+        /**
+         * @brief: called by operator new and operator delete, on the innermost scope of the calling thread
+         */
+        void allocated(const std::size_t &bytes);
+
+        void deallocated(const std::size_t &bytes);
+
+        void reallocated();
+
+    private:
+        AllocationCounter &_counter;
+        AllocationScope *_outer;        //the scope this one is nested within, if any
+        AllocationStats _tally;     //the usage within this scope; its peakBytes is the peak of _live
+        std::ptrdiff_t _live{0};        //the growth of the heap since this scope was opened
+#else
+        inline explicit AllocationScope(AllocationCounter &) {}
+#endif
+
+    public:
+        AllocationScope(const AllocationScope &) = delete;
+
+        AllocationScope &operator=(const AllocationScope &) = delete;
+    };
+
+    /**
+     * @brief: watches a string whose text is being extended, and accounts a reallocation to the innermost
+     * AllocationScope every time the string is found to have moved its text to another buffer
+     */
+    class StringWatch {
+    public:
+#ifdef DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS
+        inline explicit StringWatch(const std::string &text) : _text(text), _data(text.data()), _size(text.size()) {}
+
+        /**
+         * @brief: checks whether the string has moved since it was last observed
+         */
+        void observe();
+
+    private:
+        const std::string &_text;
+        const char *_data;
+        std::size_t _size;
+#else
+        inline explicit StringWatch(const std::string &) {}
+
+        inline void observe() {}
+#endif
+    };
+
+    /**
+     * @brief: returns the number of bytes of the heap-buffer of the passed string; zero, if its text is held within the
+     * string itself
+     */
+    inline std::size_t heapCapacity(const std::string &text) {
+        const char *data = text.data();
+        const bool inside = data >= reinterpret_cast<const char *>(&text) && data < reinterpret_cast<const char *>(&text + 1);
+
+        return inside ? 0 : text.capacity() + 1;
+    }
+
+    /**
+     * @brief: returns the AllocationCounter of the rendering of QueryConditions and CompQueryConditions on the calling
+     * thread; conditions are shared between threads, and so are accounted per thread, rather than per instance
+     * @return
+     */
+#ifdef DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS
+    AllocationCounter &conditionRendering();
+#else
+    inline AllocationCounter &conditionRendering() {
+        static AllocationCounter counter;       //empty, and so shared by every thread
+        return counter;
+    }
+#endif
+
+}
+
+#endif //DBQUERYBUILDER_ALLOCATIONS_H
@@ -0,0 +1,240 @@
+//
+// Created by fo on 16/04/2021.
+//
+// This file contains the definition of the latency-accounting of the stages of the builders: LatencyHistogram,
+// LatencySnapshot, LatencyTimer and LatencyTrace. The stages are only timed when DBQUERYBUILDER_INSTRUMENT_LATENCY is
+// defined, for the whole program; otherwise, every timer and trace compiles to nothing, and every snapshot is empty
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifndef DBQUERYBUILDER_LATENCY_H
+#define DBQUERYBUILDER_LATENCY_H
+
+namespace DBQueryBuilder::Diagnostics {
+
+    /**
+     * @brief: the enumeration of the stages of the building of a query that are timed
+     */
+    enum Stage {
+        BUILD_QUERY,        //a whole call of a build-function, e.g. MYSQLBuilder::buildQuery()
+        INSERT_CLAUSE,      //the main-clause of an "INSERT" query, with its rows
+        SELECT_CLAUSE,
+        UPDATE_CLAUSE,
+        DELETE_CLAUSE,
+        WHERE_CLAUSE,       //the "where"-clause, with all its guard-conditions
+        ORDER_CLAUSE,
+        LIMIT_PHRASE,
+        CONDITION_RENDERING,        //QueryCondition::renderTo(...) and QueryCondition::toString(...)
+        STAGES      //the number of stages
+    };
+
+    /**
+     * @brief: returns the name of the passed stage, as it is exported, e.g. "where"
+     */
+    const char *stageName(const Stage &stage);
+
+    /**
+     * @brief: a log-linear histogram of latencies, in nanoseconds, in the manner of HDR-histograms: every power of two is
+     * split into 2^subBucketBits buckets of equal width, so that a latency is known to within 1/2^subBucketBits of itself
+     */
+    class LatencyHistogram {
+    public:
+        static constexpr unsigned subBucketBits = 5;
+        static constexpr unsigned maxBits = 36;     //latencies from 2^36 ns (about 69 s) are counted in the last bucket
+        static constexpr std::size_t buckets = (maxBits - subBucketBits + 1) << subBucketBits;
+
+        /**
+         * @brief: returns the bucket that counts the passed latency
+         */
+        static inline std::size_t bucketOf(std::uint64_t nanoseconds) {
+            constexpr std::uint64_t subBuckets = std::uint64_t(1) << subBucketBits;
+            if (nanoseconds >= (std::uint64_t(1) << maxBits)) {
+                return buckets - 1;
+            }
+            if (nanoseconds < subBuckets) {
+                return static_cast<std::size_t>(nanoseconds);
+            }
+
+            //the position of the highest bit, beyond the bits of a sub-bucket
+            unsigned shift = 0;
+            while ((nanoseconds >> shift) >= 2 * subBuckets) {
+                ++shift;
+            }
+
+            return static_cast<std::size_t>(((shift + 1) << subBucketBits) + ((nanoseconds >> shift) - subBuckets));
+        }
+
+        /**
+         * @brief: returns the greatest latency counted by the passed bucket
+         */
+        static inline std::uint64_t highestOf(const std::size_t &bucket) {
+            constexpr std::uint64_t subBuckets = std::uint64_t(1) << subBucketBits;
+            if (bucket < subBuckets) {
+                return bucket;
+            }
+
+            const unsigned shift = static_cast<unsigned>(bucket >> subBucketBits) - 1;
+            const std::uint64_t lowest = (subBuckets + (bucket & (subBuckets - 1))) << shift;
+
+            return lowest + (std::uint64_t(1) << shift) - 1;
+        }
+
+        inline void record(const std::uint64_t &nanoseconds, const std::uint64_t &times = 1) {
+            _counts[bucketOf(nanoseconds)] += times;
+            _count += times;
+            _sum += nanoseconds * times;
+            if (nanoseconds > _max) {
+                _max = nanoseconds;
+            }
+        }
+
+        /**
+         * @brief: adds the passed counts, of a histogram with the same buckets, into this one
+         */
+        inline void add(const std::size_t &bucket, const std::uint64_t &count) {
+            _counts[bucket] += count;
+        }
+
+        inline void addTotals(const std::uint64_t &count, const std::uint64_t &sum, const std::uint64_t &max) {
+            _count += count;
+            _sum += sum;
+            if (max > _max) {
+                _max = max;
+            }
+        }
+
+        /**
+         * @brief: returns the latency that the passed fraction of the recorded latencies do not exceed, to within the
+         * width of its bucket; zero, if nothing has been recorded
+         * @param quantile: within [0, 1], e.g. 0.99
+         */
+        std::uint64_t percentile(const double &quantile) const;
+
+        inline std::uint64_t count() const {
+            return _count;
+        }
+
+        inline std::uint64_t sum() const {
+            return _sum;
+        }
+
+        inline std::uint64_t max() const {
+            return _max;
+        }
+
+    private:
+        std::array<std::uint64_t, buckets> _counts{};
+        std::uint64_t _count{0}, _sum{0}, _max{0};
+    };
+
+    /**
+     * @brief: the histograms of all the stages, merged from those of every thread
+     */
+    struct LatencySnapshot {
+        std::array<LatencyHistogram, STAGES> stages;
+
+        inline const LatencyHistogram &operator[](const Stage &stage) const {
+            return stages[stage];
+        }
+    };
+
+    /**
+     * @brief: merges the histograms that every thread has recorded into so far; the threads keep recording, without
+     * waiting on the merge
+     * @return
+     */
+    LatencySnapshot latencySnapshot();
+
+    /**
+     * @brief: clears the histograms of every thread; latencies recorded while they are cleared may be kept, or lost
+     */
+    void resetLatencies();
+
+    /**
+     * @brief: returns the passed snapshot in the text-format of Prometheus: a summary of each stage, in seconds, with
+     * its 0.5, 0.9, 0.99 and 0.999 quantiles, and a gauge of the greatest latency of each stage
+     * @return
+     */
+    std::string toPrometheus(const LatencySnapshot &snapshot);
+
+    /**
+     * @brief: writes latencySnapshot(), in the text-format of Prometheus, to the passed file; the file is replaced at
+     * once, so that a collector never reads it half-written
+     * @throws std::runtime_error: if the file cannot be written
+     * @param path: e.g. a file within the directory of the textfile-collector of the node-exporter
+     */
+    void writePrometheus(const std::string &path);
+
+#ifdef DBQUERYBUILDER_INSTRUMENT_LATENCY
+    /**
+     * @brief: records the passed latency of the passed stage; within a LatencyTrace, the latencies of a stage are summed,
+     * and recorded once, when the trace is closed
+     */
+    void recordLatency(const Stage &stage, const std::uint64_t &nanoseconds);
+
+    void openTrace();
+
+    void closeTrace(const std::uint64_t &nanoseconds);
+#endif
+
+    /**
+     * @brief: times a stage, from its construction to its destruction
+     */
+    class LatencyTimer {
+    public:
+#ifdef DBQUERYBUILDER_INSTRUMENT_LATENCY
+        inline explicit LatencyTimer(const Stage &stage) : _stage(stage), _start(std::chrono::steady_clock::now()) {}
+
+        inline ~LatencyTimer() {
+            recordLatency(_stage, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - _start).count()));
+        }
+
+    private:
+        Stage _stage;
+        std::chrono::steady_clock::time_point _start;
+#else
+        inline explicit LatencyTimer(const Stage &) {}
+#endif
+
+    public:
+        LatencyTimer(const LatencyTimer &) = delete;
+
+        LatencyTimer &operator=(const LatencyTimer &) = delete;
+    };
+
+    /**
+     * @brief: times a whole build as BUILD_QUERY, and gathers the stages timed within it, which may be passed through
+     * several times, e.g. once to measure a query and once to write it, so that each stage is recorded once per build;
+     * a trace opened within another is part of it
+     */
+    class LatencyTrace {
+    public:
+#ifdef DBQUERYBUILDER_INSTRUMENT_LATENCY
+        inline LatencyTrace() : _start(std::chrono::steady_clock::now()) {
+            openTrace();
+        }
+
+        inline ~LatencyTrace() {
+            closeTrace(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - _start).count()));
+        }
+
+    private:
+        std::chrono::steady_clock::time_point _start;
+#else
+        inline LatencyTrace() {}
+#endif
+
+    public:
+        LatencyTrace(const LatencyTrace &) = delete;
+
+        LatencyTrace &operator=(const LatencyTrace &) = delete;
+    };
+
+}
+
+#endif //DBQUERYBUILDER_LATENCY_H
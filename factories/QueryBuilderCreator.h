@@ -1,34 +1,163 @@
 //
 // Created by fo on 22/03/2021.
 //
-//This file contains the implementation of a factory-function for QueryBuilder
-#include "../builders/MYSQLBuilder.h"
+//This file contains the declaration of the factory-functions for QueryBuilders, and of the registry of the dialects
+//they create builders of
+#include "../builders/IQueryBuilder.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #ifndef DBQUERYBUILDER_QUERYBUILDERCREATOR_H
 #define DBQUERYBUILDER_QUERYBUILDERCREATOR_H
 
 namespace DBQueryBuilder::Factory {
 
+    /**
+     * @brief: the enumeration of the ids of the dialects known to DialectRegistry; the ids of the dialects registered
+     * at startup are handed out from CUSTOM onwards
+     */
+    enum Dialect : std::uint8_t {
+        MYSQL,
+        POSTGRESQL,
+        SQLITE,
+        CUSTOM      //the first id of the dialects registered through DialectRegistry::add(...)
+    };
+
+    /**
+     * @brief: the dialects, each with the prototype that its builders are cloned from; a builder is created by looking
+     * its dialect up in a table, and cloning the prototype found, so no name is compared
+     */
+    class DialectRegistry {
+    public:
+        static constexpr std::size_t capacity = 32;     //the greatest number of dialects
+
+        /**
+         * @brief: returns the registry of the process, in which the built-in dialects are registered
+         * @return
+         */
+        static DialectRegistry &instance();
+
+        DialectRegistry(const DialectRegistry &) = delete;
+
+        DialectRegistry &operator=(const DialectRegistry &) = delete;
+
+        /**
+         * @brief: registers a dialect, e.g. at startup, under the next free id
+         * @throws std::logic_error: if the name is already registered, the prototype is null, or the registry is full
+         * @param name: the name of the dialect, compared without regard to case
+         * @param prototype: the builder that the builders of the dialect are cloned from
+         * @return Dialect: the id of the dialect
+         */
+        Dialect add(const std::string &name, std::unique_ptr<Builder::IQueryBuilder> prototype);
+
+        /**
+         * @brief: replaces the prototype of a registered dialect, e.g. with one whose buffers have been pre-sized; the
+         * builders already created are not affected
+         * @throws std::logic_error: if the dialect is not registered, or the prototype is null
+         * @return int: custom error-number
+         */
+        int replace(const Dialect &dialect, std::unique_ptr<Builder::IQueryBuilder> prototype);
+
+        /**
+         * @brief: returns the id of the dialect of the passed name
+         * @throws std::logic_error: if no dialect of the passed name is registered
+         * @param name: compared without regard to case
+         * @return
+         */
+        Dialect find(const std::string &name) const;
+
+        bool registered(const Dialect &dialect) const;
+
+        /**
+         * @brief: returns a new builder of the passed dialect, cloned from its prototype
+         * @throws std::logic_error: if the dialect is not registered
+         * @return Builder::IQueryBuilder *: the new builder, owned by the caller
+         */
+        Builder::IQueryBuilder *create(const Dialect &dialect) const;
+
+        /**
+         * @brief: makes the query of the passed builder of the passed dialect that of the prototype of the dialect,
+         * keeping the memory the builder has acquired, e.g. before it is handed out again
+         * @throws std::logic_error: if the dialect is not registered
+         * @return int: custom error-number
+         */
+        int restore(const Dialect &dialect, Builder::IQueryBuilder &builder) const;
+
+    private:
+        DialectRegistry();
+
+        /**
+         * @brief: a dialect; once published, an Entry is never changed or destroyed, so that it can be read without
+         * locking
+         */
+        struct Entry {
+            std::string name;
+            std::unique_ptr<Builder::IQueryBuilder> prototype;
+        };
+
+        /**
+         * @brief: publishes the passed dialect under the passed id; the caller holds _mutex
+         */
+        void publish(const Dialect &dialect, const std::string &name, std::unique_ptr<Builder::IQueryBuilder> prototype);
+
+        std::array<std::atomic<const Entry *>, capacity> _entries{};     //the dialect of each id, or nullptr
+        std::vector<std::unique_ptr<Entry>> _published;     //every Entry ever published, including the replaced ones
+        std::size_t _next{CUSTOM};      //the id of the next dialect added
+        mutable std::mutex _mutex;      //serializes registrations
+    };
+
+    /**
+     * @brief: factory-function that creates a new QueryBuilder of the passed dialect
+     * @throws std::logic_error: if the passed dialect is not registered
+     * @param dialect
+     * @return
+     */
+    DBQueryBuilder::Builder::IQueryBuilder::Ptr makeQueryBuilder(const Dialect &dialect);
+
     /**
      * @brief: factory-function that creates a new QueryBuilder, according to type passed
      * @throws std::logic_error: if the passed type is not known
-     * @param type: the type of
+     * @param type: the name of the dialect, e.g. "mysql", "postgresql" or "sqlite"
      * @return
      */
-    DBQueryBuilder::Builder::IQueryBuilder::Ptr makeQueryBuilder(const std::string &type) {
-        if (type == "mysql" || type == "MYSQL") {
-            //create a new MYSQLBuilder
-            return std::make_shared<DBQueryBuilder::Builder::MYSQLBuilder>();
-        } else {        //The passed type is unknown
-            //build the message to be reported
-            std::string msg = "In Factory::makeQueryBuilder: QueryBuilder type \"";
-            msg += msg;
-            msg += "\" is unknown";
-
-            //report the error
-            throw std::logic_error(msg);
-        }
-    }
+    DBQueryBuilder::Builder::IQueryBuilder::Ptr makeQueryBuilder(const std::string &type);
+
+    /**
+     * @brief: the deleter of pooled QueryBuilders; it returns them to the free-list of their dialect, of the releasing
+     * thread, or destroys them if that free-list was already destroyed with its thread
+     */
+    struct PoolReturner {
+        Dialect dialect{MYSQL};
+
+        void operator()(DBQueryBuilder::Builder::IQueryBuilder *builder) const;
+    };
+
+    using PooledQueryBuilder = std::unique_ptr<DBQueryBuilder::Builder::IQueryBuilder, PoolReturner>;
+
+    /**
+     * @brief: factory-function that hands out a QueryBuilder of the passed dialect from the free-list of the calling
+     * thread; once the free-list is warm, no allocation is made for the builder
+     * @throws std::logic_error: if the passed dialect is not registered
+     * @param dialect
+     * @return PooledQueryBuilder: a builder holding the query of the prototype of its dialect, that is returned to a
+     * free-list when it is destroyed
+     */
+    PooledQueryBuilder makePooledQueryBuilder(const Dialect &dialect);
+
+    /**
+     * @brief: factory-function that hands out a QueryBuilder, according to the type passed, from the free-list of the
+     * calling thread
+     * @throws std::logic_error: if the passed type is not known
+     * @param type: the name of the dialect, e.g. "mysql", "postgresql" or "sqlite"
+     * @return PooledQueryBuilder: a builder holding the query of the prototype of its dialect, that is returned to a
+     * free-list when it is destroyed
+     */
+    PooledQueryBuilder makePooledQueryBuilder(const std::string &type);
 
 }
 
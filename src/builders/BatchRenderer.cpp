@@ -0,0 +1,59 @@
+//
+// Created by fo on 13/04/2021.
+//
+// This file contains the definition of all the member-functions of BatchRenderer
+#include "../../builders/BatchRenderer.h"
+#include <algorithm>
+#include <stdexcept>
+
+using BatchRenderer = DBQueryBuilder::Builder::BatchRenderer;
+
+BatchRenderer::BatchRenderer(const std::size_t &threads, const std::size_t &chunkSize) : _pool(threads),
+                                                                                          _chunkSize(std::max<std::size_t>(1, chunkSize)) {}
+
+std::size_t BatchRenderer::threads() const {
+    return _pool.threads();
+}
+
+std::size_t BatchRenderer::renderInto(const Type::QueryTemplate &qTemplate, const std::string_view *values,
+                                      const std::size_t &count, RenderedBatch &batch) {
+    const std::size_t slots = qTemplate.slots();
+    if (slots == 0 ? count != 0 : count % slots != 0) {     //the values do not form whole records
+        throw std::logic_error("In Builder::BatchRenderer::renderInto: the number of values is not a multiple of the number of slots");
+    }
+
+    //the values of a QueryTemplate without slots form no record
+    const std::size_t records = slots == 0 ? 0 : count / slots;
+    batch.queries.resize(records);
+    batch.buffers.resize((records + _chunkSize - 1) / _chunkSize);
+
+    _pool.run(records, _chunkSize, [&](std::size_t begin, std::size_t end) {
+        //measure the chunk, so that its buffer is grown at most once, then write its queries one after the other
+        std::size_t length = 0;
+        for (std::size_t record = begin; record < end; ++record) {
+            length += qTemplate.length(values + record * slots, slots);
+        }
+
+        const std::size_t chunk = begin / _chunkSize;
+        std::string &buffer = batch.buffers[chunk];
+        buffer.resize(length);
+
+        char *const base = &buffer[0];
+        char *cursor = base;
+        for (std::size_t record = begin; record < end; ++record) {
+            char *query = cursor;
+            cursor = qTemplate.render(values + record * slots, slots, cursor);
+            batch.queries[record] = {chunk, static_cast<std::size_t>(query - base), static_cast<std::size_t>(cursor - query)};
+        }
+    });
+
+    return records;
+}
+
+DBQueryBuilder::Builder::RenderedBatch BatchRenderer::render(const Type::QueryTemplate &qTemplate,
+                                                             const std::vector<std::string_view> &values) {
+    RenderedBatch batch;        //the queries to be returned
+    renderInto(qTemplate, values.data(), values.size(), batch);
+
+    return batch;
+}
@@ -0,0 +1,52 @@
+//
+// Created by fo on 23/04/2021.
+//
+// This file contains the definition of all the member-functions of KeysetScanner
+#include "../../builders/KeysetScanner.h"
+#include <stdexcept>
+
+using KeysetScanner = DBQueryBuilder::Builder::KeysetScanner;
+
+KeysetScanner::KeysetScanner(MYSQLBuilder &builder, const std::vector<std::string> &keyColumns, const int &pageSize,
+                             const Order &order) : _builder(builder), _pageSize(pageSize > 0 ? pageSize : 0) {
+    _builder.setKeyset(keyColumns, pageSize, order);
+}
+
+bool KeysetScanner::done() const {
+    return _done;
+}
+
+const DBQueryBuilder::Builder::ParameterizedQuery &KeysetScanner::query() {
+    if (_done) {        //there is no page left
+        throw std::logic_error("In Builder::KeysetScanner::query: every page has been returned");
+    }
+
+    //the query is appended to, so it is emptied first, keeping its memory
+    _query.sql.clear();
+    _query.binds.clear();
+    _builder.buildParameterizedQueryInto(_query);
+
+    return _query;
+}
+
+void KeysetScanner::advance(const std::size_t &rows, const std::vector<std::string> &lastKey) {
+    if (_done) {        //there is no page left
+        throw std::logic_error("In Builder::KeysetScanner::advance: every page has been returned");
+    }
+
+    if (rows < _pageSize) {     //the page was not full, so no row follows it
+        ++_pages;
+        _done = true;
+        return;
+    } else if (lastKey.empty()) {       //an empty key would seek the first page again, and the scan would not end
+        throw std::logic_error("In Builder::KeysetScanner::advance: the page was full, but no key was passed to "
+                               "seek the next page after");
+    }
+
+    _builder.seekAfter(lastKey);
+    ++_pages;
+}
+
+std::size_t KeysetScanner::pages() const {
+    return _pages;
+}
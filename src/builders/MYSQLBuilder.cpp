@@ -1,404 +1,409 @@
 //
 // Created by fo on 21/03/2021.
 //
-// This file contains the implementation of all the member-functions oc MYSQLBuilder
+// This file contains the implementation of all the member-functions oc MYSQLBuilder, with the writing of the files of
+// "LOAD DATA" statements
 #include "../../builders/MYSQLBuilder.h"
-#include "../../types/CompQueryCondition.h"
-#include <map>
-#include <vector>
-#include <string>
+#include "../../utils/Escaper.h"
+#include "QueryEngine.h"
 
 using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
 
+namespace {
+    /**
+     * @brief: the dialect of MYSQL, as the engine renders it; check src/builders/QueryEngine.h
+     */
+    struct MYSQLDialect {
+        using Clause = DBQueryBuilder::Builder::Engine::Clause;
+
+        static constexpr char builder[] = "MYSQLBuilder";
+        static constexpr char quote = '`';
+        static constexpr char placeholder = '?';
+        static constexpr bool numbersPlaceholders = false;
+        static constexpr bool cachesTemplates = true;
+        static constexpr std::uint64_t seed = 0x6D7973716C000000ull;       //"mysql"
+
+        /**
+         * @brief: the capability-mask of each query-type, indexed by DBQueryBuilder::Action
+         */
+        static constexpr std::uint8_t clauses[] = {
+                0,                                                  //INSERT
+                Clause::WHERE | Clause::ORDER | Clause::LIMIT,      //SELECT
+                Clause::WHERE | Clause::ORDER | Clause::LIMIT,      //UPDATE
+                Clause::WHERE | Clause::ORDER | Clause::LIMIT,      //DELETE
+                Clause::DUPLICATE_KEY_UPDATE,                       //UPSERT
+                0                                                   //NIL
+        };
+
+        static inline std::size_t literalLength(const char *chars, const std::size_t &count) {
+            return DBQueryBuilder::Util::Escaper::literalLength(chars, count);
+        }
 
-class MYSQLBuilder::QueryDescriptor {
-private:
-    DBQueryBuilder::Action _queryType;
-    std::map<std::string, std::map<DBQueryBuilder::Action, bool>> _qDes;
+        static inline char *escapeLiteral(const char *chars, const std::size_t &count, char *out) {
+            return DBQueryBuilder::Util::Escaper::escapeLiteral(chars, count, out);
+        }
 
-public:
-    QueryDescriptor(DBQueryBuilder::Action queryType) : _queryType(queryType) {}
+        static inline std::size_t identifierLength(const char *chars, const std::size_t &count) {
+            return DBQueryBuilder::Util::Escaper::identifierLength(chars, count);
+        }
+
+        static inline char *escapeIdentifier(const char *chars, const std::size_t &count, char *out) {
+            return DBQueryBuilder::Util::Escaper::escapeIdentifier(chars, count, out);
+        }
+    };
 
     /**
-     * @brief: confirms whether or not the concerned query may expect a "where" clause
-     * @return
+     * @brief: the escaping of the fields of the file of a "LOAD DATA" statement, as its LoadDataFormat requires it
      */
-    bool setsWhere(const DBQueryBuilder::Action &action) {
-        //confirm whether or not the "where"-description for the concerned query-type has been cached
-        if (_qDes["where"].find(_queryType) == _qDes["where"].end()) {        //description has not been cached
-            //get and cache description
-            switch (_queryType) {
-                case DBQueryBuilder::Action::INSERT:     //for INSERT
-                    _qDes["where"][_queryType] = false;
-                    break;
-                case DBQueryBuilder::Action::SELECT:     //for SELECT
-                case DBQueryBuilder::Action::UPDATE:      //for UPDATE
-                case DBQueryBuilder::Action::DELETE:      //for DElETE
-                    _qDes["where"][_queryType] = true;
-                    break;
-                default:        //The query-type is not recognized
-                    throw std::logic_error("In Builder::MYSQLBuilder::QueryDescriptor::setsWhere: query-type unknown");
+    class LoadDataEscaper {
+        char _replacement[256]{};       //the character that follows the backslash in the escaped form of each byte; zero, for bytes that are copied as they are
+        char _enclosure;        //encloses every field but NULLs; '\0', if fields are not enclosed
+
+    public:
+        /**
+         * @param format: a LoadDataFormat that has been confirmed not to be ambiguous
+         */
+        inline explicit LoadDataEscaper(const DBQueryBuilder::Builder::LoadDataFormat &format) : _enclosure(format.enclosure) {
+            _replacement[static_cast<unsigned char>('\\')] = '\\';
+            _replacement[0] = '0';
+            if (_enclosure != '\0') {
+                _replacement[static_cast<unsigned char>(_enclosure)] = _enclosure;
+            } else {        //only the escapes tell a terminator from a character of a value
+                _replacement[static_cast<unsigned char>(format.fieldTerminator[0])] = format.fieldTerminator[0];
+                _replacement[static_cast<unsigned char>(format.lineTerminator[0])] = format.lineTerminator[0];
             }
         }
 
-        return _qDes["where"][_queryType];
-    }
+        /**
+         * @brief: writes the passed value as a field, enclosed if fields are, with runs that need no escaping written
+         * whole
+         */
+        template<typename Writer>
+        inline void writeField(Writer &writer, const char *chars, const std::size_t &count) const {
+            if (_enclosure != '\0') {
+                writer.append(&_enclosure, 1);
+            }
 
-    /**
-     * @brief: confirms whether or not the query being built may expect an "order by" clause
-     * @param action
-     * @return
-     */
-    bool setsOrder(const DBQueryBuilder::Action &action) {
-        //confirm whether or not the "order"-description for the concerned query-type has been cached
-        if (_qDes["order"].find(_queryType) == _qDes["order"].end()) {        //description has not been cached
-            //get and cache description
-            switch (_queryType) {
-                case DBQueryBuilder::Action::SELECT:     //for SELECT
-                case DBQueryBuilder::Action::DELETE:      //for DElETE
-                case DBQueryBuilder::Action::UPDATE:      //for UPDATE
-                    _qDes["order"][_queryType] = true;
-                    break;
-                case DBQueryBuilder::Action::INSERT:     //for INSERT
-                    _qDes["order"][_queryType] = false;
-                    break;
-                default:        //The query-type is not recognized
-                    throw std::logic_error("In Builder::MYSQLBuilder::QueryDescriptor::setsOrder: query-type unknown");
+            const char *run = chars;        //the beginning of the run of characters that need no escaping
+            const char *end = chars + count;
+            for (const char *byte = run; byte != end; ++byte) {
+                const char replacement = _replacement[static_cast<unsigned char>(*byte)];
+                if (replacement == 0) {
+                    continue;
+                }
+
+                writer.append(run, byte - run);
+                const char escaped[] = {'\\', replacement};
+                writer.append(escaped, 2);
+                run = byte + 1;
             }
-        }
+            writer.append(run, end - run);
 
-        return _qDes["order"][_queryType];
-    }
+            if (_enclosure != '\0') {
+                writer.append(&_enclosure, 1);
+            }
+        }
+    };
+}
 
+class MYSQLBuilder::Core : public DBQueryBuilder::Builder::Engine::BuilderCore<MYSQLDialect> {
+    using ColumnBatch = DBQueryBuilder::Type::ColumnBatch;
 
     /**
-     * @brief: confirms whether or not the query being built may expect a "limit" phrase
-     * @param action
-     * @return
+     * @brief: confirms that a file of the passed format can be read back unambiguously
+     * @throws std::logic_error: if a terminator is empty, or a terminator or the enclosure begins like another or with
+     * the backslash
      */
-    bool setsLimit(const DBQueryBuilder::Action &action) {
-        //confirm whether or not the "limit"-description for the concerned query-type has been cached
-        if (_qDes["limit"].find(_queryType) == _qDes["limit"].end()) {        //description has not been cached
-            //get and cache description
-            switch (_queryType) {
-                case DBQueryBuilder::Action::INSERT:     //for INSERT
-                    _qDes["limit"][_queryType] = false;
-                    break;
-                case DBQueryBuilder::Action::SELECT:     //for SELECT
-                case DBQueryBuilder::Action::UPDATE:      //for UPDATE
-                case DBQueryBuilder::Action::DELETE:      //for DElETE
-                    _qDes["limit"][_queryType] = true;
-                    break;
-                default:        //The query-type is not recognized
-                    throw std::logic_error("In Builder::MYSQLBuilder::QueryDescriptor::setsLimit: query-type unknown");
-            }
+    static inline void checkFormat(const LoadDataFormat &format, const char *function) {
+        if (format.fieldTerminator.empty() || format.lineTerminator.empty()) {
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>(function) +
+                                   "the terminators of a \"LOAD DATA\" file cannot be empty");
         }
 
-        return _qDes["limit"][_queryType];
+        const char field = format.fieldTerminator[0], line = format.lineTerminator[0];
+        if (field == '\\' || line == '\\' || format.enclosure == '\\') {
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>(function) +
+                                   "the terminators and the enclosure of a \"LOAD DATA\" file cannot begin with its escape-character");
+        } else if (field == line || (format.enclosure != '\0' && (format.enclosure == field || format.enclosure == line))) {
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>(function) +
+                                   "the terminators and the enclosure of a \"LOAD DATA\" file must begin with different characters");
+        }
     }
-};
 
-class MYSQLBuilder::MainClauseCreator {
-public:
     /**
-     * @@brief: returns the main-clause for a "SELECT" query, using the passed parameters
-     * @param columns: the vector of the names of the concerned Columns
-     * @param tableName: the name of the database-table concerned
-     * @return std::string: the main clause
+     * @brief: writes the "LOAD DATA" statement of a file of the passed columns into the passed writer
+     * @param writer: the LengthCounter or BufferWriter that receives the statement
+     * @param columnCount: the number of columns
+     * @param columnName: returns the name of the column at the passed position
      */
-    inline std::string buildSelect(const std::vector<std::string> &columns, const std::string &tableName) {
-        if (tableName.empty()) {        //the passed table-name is empty
-            //report the error
-            throw std::logic_error("In Builder::MYSQLBuilder::Core::buildSelect: empty table-name");
+    template<typename Writer, typename ColumnName>
+    inline void writeLoadDataStatement(Writer &writer, const std::string &path, const LoadDataFormat &format,
+                                       const std::size_t &columnCount, const ColumnName &columnName) {
+        writer.append("load data local infile ");
+        writer.appendValue(path.data(), path.size());
+        writer.append(" into table ");
+        writer.appendIdentifier(_tableName);
+
+        writer.append(" fields terminated by ");
+        writer.appendValue(format.fieldTerminator.data(), format.fieldTerminator.size());
+        if (format.enclosure != '\0') {
+            writer.append(" enclosed by ");
+            writer.appendValue(&format.enclosure, 1);
         }
-
-        //begin the construction of the main-clause
-        std::string clause = "select ";
-
-        //confirm that target-columns were passed
-        if (columns.empty()) {      //no column was passed
-            //construct query to select all available columns
-            clause += "*";
-        } else {        //columns were passed
-            for (const std::string &column : columns) {
-                //add the present column to the collection of columns to be select
-                clause += (columns[0] == column) ? " `" : ", `";
-                clause += column;
-                clause += "`";
+        writer.append(" escaped by '\\\\' lines terminated by ");
+        writer.appendValue(format.lineTerminator.data(), format.lineTerminator.size());
+
+        //append the enumeration of the concerned columns, in the order of the fields of every row of the file
+        writer.append(" (");
+        for (std::size_t column = 0; column < columnCount; ++column) {
+            if (column != 0) {
+                writer.append(", ");
             }
+            writer.appendIdentifier(columnName(column));
         }
-
-        //add the table-name
-        clause += " from `";
-        clause += tableName;
-        clause += "`";
-
-        return clause;
+        writer.append(")");
     }
 
     /**
-     * @brief: returns the main-clause for an "INSERT" query, using the passed parameters
-     * @param tableName: the name of the concerned table
-     * @param resourceRep: the new representation that should be pushed to the database
-     * @return std::string : the main clause
+     * @brief: writes the rows added so far, as the fields of a "LOAD DATA" file, into the passed writer
+     * @param writer: the LengthCounter, BufferWriter or ChunkWriter that receives the file
      */
-    inline std::string buildInsert(const std::string &tableName, std::map<std::string, std::string> resourceRep) {
-
-        //confirm that the table-name is not empty
-        if (tableName.empty()) {        //the passed table-name is empty
-            throw std::logic_error("In Builder::MYSQLBuilder::Core::buildInsert: empty table-name");
-        } else if (resourceRep.empty()) {       //the passed Resource-representation is empty
-            throw std::logic_error("In Builder::MYSQLBuilder::Core::buildInsert: empty Resource-representation");
-        }
-
-        //begin the construction of the main-clause
-        std::string clause = "insert into `";
-        clause += tableName;
-        clause += "`";
-        int counter = 0;        //counts the number of iteration through a loop
-
-        std::string columns = "(", values = "(";
-        for (std::pair attr: resourceRep) {
-            columns += (++counter == 1) ? "`" : ", `", values += (counter == 1) ? "'" : ", '";
-            columns += attr.first, values += attr.second;
-            columns += "`", values += "'";
-
+    template<typename Writer>
+    inline void writeLoadDataPayload(Writer &writer, const LoadDataFormat &format, const LoadDataEscaper &escaper) {
+        for (std::size_t position = 0; position < _rows.rows(); ++position) {
+            for (std::size_t column = 0; column < _rows.columns().size(); ++column) {
+                if (column != 0) {
+                    writer.append(format.fieldTerminator.data(), format.fieldTerminator.size());
+                }
+                const std::string_view value = _rows.cell(position, column);
+                escaper.writeField(writer, value.data(), value.size());
+            }
+            writer.append(format.lineTerminator.data(), format.lineTerminator.size());
         }
-        columns += ")", values += ")";
-
-        //append the enumeration of the concerned columns to the query
-        clause += columns;
-        clause += " values";
-        //append the enumeration of values set for the columns
-        clause += values;
-
-        return clause;
     }
 
     /**
-     * @brief: returns the main-clause for an "UPDATE" query, using the passed parameters
-     * @param tableName: the name of the table being affected
-     * @param resourceRep: the new representation that should be pushed to the database
-     * @return std::string : the main clause
+     * @brief: writes the value of the passed column, at the passed row, as a field of a "LOAD DATA" file into the
+     * passed writer; a NULL is written as "\N", and numbers in their shortest form
+     * @throws std::logic_error: if the value is a number that is not finite
      */
-    inline std::string
-    buildUpdate(const std::string &tableName, const std::map<std::string, std::string> &resourceRep) {
-        //confirm that the table-name is not empty
-        if (tableName.empty()) {        //the passed table-name is empty
-            throw std::logic_error("In Builder::MYSQLBuilder::Core::buildUpdate: empty table-name");
-        } else if (resourceRep.empty()) {       //the passed Resource-representation is empty
-            throw std::logic_error("In Builder::MYSQLBuilder::Core::buildUpdate: empty Resource-representation");
+    template<typename Writer>
+    static inline void writeLoadDataCell(Writer &writer, const LoadDataEscaper &escaper,
+                                         const ColumnBatch::Column &column, const std::size_t &row) {
+        if (column.nulls != nullptr && column.nulls[row]) {      //the value is NULL
+            writer.append("\\N");
+            return;
         }
 
-        //begin the construction of the main-clause
-        std::string clause = "update `";
-        clause += tableName;
-        clause += "` set";
-
-        int counter = 0;        //counts the number of iteration through a loop
-        for (std::pair<std::string, std::string> _attr : resourceRep) {
-            clause += (++counter == 1) ? "`" : ", `";
-            clause += _attr.first;
-            clause += "`='";
-            clause += _attr.second;
-            clause += "'";
+        char digits[32];        //the textual form of a number
+        std::to_chars_result result{digits, std::errc()};
+        switch (column.kind) {
+            case ColumnBatch::Kind::STRING: {
+                const std::string &value = static_cast<const std::string *>(column.values)[row];
+                escaper.writeField(writer, value.data(), value.size());
+                return;
+            }
+            case ColumnBatch::Kind::STRING_VIEW: {
+                const std::string_view &value = static_cast<const std::string_view *>(column.values)[row];
+                escaper.writeField(writer, value.data(), value.size());
+                return;
+            }
+            case ColumnBatch::Kind::INT64:
+                result = std::to_chars(digits, digits + sizeof(digits), static_cast<const std::int64_t *>(column.values)[row]);
+                break;
+            case ColumnBatch::Kind::DOUBLE: {
+                const double value = static_cast<const double *>(column.values)[row];
+                if (!std::isfinite(value)) {        //the value has no SQL-form
+                    throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::streamLoadDataPayload") +
+                                           "the column \"" + column.name + "\" holds a number that is not finite");
+                }
+
+                result = std::to_chars(digits, digits + sizeof(digits), value);
+                break;
+            }
+            default:        //the kind of the column is not recognized
+                throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::streamLoadDataPayload") +
+                                       "the kind of the column \"" + column.name + "\" is unknown");
         }
 
-        return clause;
+        escaper.writeField(writer, digits, result.ptr - digits);
     }
 
     /**
-     * @brief: returns the main-clause for a "DELETE" query, using the passed parameters
-     * @param tableName: the name of the table that is to be affected
-     * @return std::string : the main clause
+     * @brief: returns the statements that set each of the passed checks, keeping or restoring its previous setting
      */
-    inline std::string buildDelete(const std::string &tableName) {
-
-        //confirm that the table-name is not empty
-        if (tableName.empty()) {        //the passed table-name is empty
-            throw std::logic_error("In Builder::MYSQLBuilder::Core::buildDelete: empty table-name");
+    static inline std::vector<std::string> checkStatements(const int &checks, const bool &disable,
+                                                           const char *function) {
+        if ((checks & ~(UNIQUE_CHECKS | FOREIGN_KEY_CHECKS)) != 0) {
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>(function) +
+                                   "unknown flag of LoadDataChecks");
         }
 
-        //begin the main clause
-        std::string clause = "delete from `";
-        clause += tableName;
-        clause += "`";
-
-        return clause;
-    }
-};
-
-class MYSQLBuilder::Core {
-public:
-    QueryDescriptor *_qDescriptor;        //describes type of query being built
-    MainClauseCreator *_mainClauseCreator;      //creates main-clause of query being built
-
-    DBQueryBuilder::Action _action{Action::NIL};     //the action of the query
-    std::string _tableName;     //the name of the concerned table
-    std::vector<std::string> _columns;      //the vector of column-names the query being built is concerned with
-    std::map<std::string, std::string> _resourceRep;        //the representation of the resource being pushed to the database
-
-    std::string _whereClause{""};        //the "where"-clause of the query built so far
-    std::string _orderClause{""};       //the "order"-clause of the query built so far
-    std::string _limitPhrase{""};        //the "limit"-phrase of the query built so far
+        std::vector<std::string> statements;        //the statements to be returned
+        for (const char *check : {"unique_checks", "foreign_key_checks"}) {
+            if ((checks & (check[0] == 'u' ? UNIQUE_CHECKS : FOREIGN_KEY_CHECKS)) == 0) {
+                continue;
+            }
 
-public:
-    Core() {
-        //allocate memory for the main-clause creator
-        _mainClauseCreator = new MainClauseCreator();
-    }
+            const std::string name(check), variable = "@dbquerybuilder_" + name;
+            statements.push_back(disable ? "set " + variable + " = @@" + name + ", " + name + " = 0"
+                                         : "set " + name + " = " + variable);
+        }
+        if (!disable) {     //the checks are restored in the reverse order of their disabling
+            std::reverse(statements.begin(), statements.end());
+        }
 
-    inline int setTableName(const std::string &tableName) {
-        //cache the table Name
-        _tableName = tableName;
-        return 0;
+        return statements;
     }
 
-    inline int setAction(const Action &action) {
-        //cache the action
-        _action = action;
-
-        //allocate memory for the QueryDescriptor
-        _qDescriptor = new QueryDescriptor(_action);
-
-        return 0;
-    }
+public:
+    inline int addUpsertColumn(const std::string &column, const Merge &merge) {
+        using EngineMerge = DBQueryBuilder::Builder::Engine::Merge;
 
-    inline int setTargetColumns(const std::vector<std::string> &columns) {
-        //cache the target-columns
-        _columns = columns;
+        switch (merge) {
+            case Merge::OVERWRITE:
+                _upserts.push_back({column, EngineMerge::OVERWRITE});
+                break;
+            case Merge::ADD:
+                _upserts.push_back({column, EngineMerge::ADD});
+                break;
+            case Merge::GREATEST:
+                _upserts.push_back({column, EngineMerge::GREATEST});
+                break;
+            default:        //the passed merge-expression is not known
+                throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::addUpsertColumn") +
+                                       "the merge-expression is unknown");
+        }
 
         return 0;
     }
 
+    inline int setUpsertSyntax(const UpsertSyntax &syntax) {
+        using EngineSyntax = DBQueryBuilder::Builder::Engine::UpsertSyntax;
 
-    inline int addCondition(const DBQueryBuilder::Type::QueryCondition::Ptr &qCondition) {
-        //check is the "where"-clause has been initialized
-        if (_whereClause.empty()) {     //the "where"-clause has not been initialized
-            //initialize the "where"-clause
-            _whereClause = "where ";
-
-            //append the QueryConjunction to the where-clause
-            _whereClause += qCondition->toString(false);
-        } else {        //the "where"-clause has been initialized
-            //append the QueryConjunction ot the "where"-clause
-            _whereClause += " ";
-            _whereClause += qCondition->toString(true);
+        switch (syntax) {
+            case UpsertSyntax::VALUES_FUNCTION:
+                _upsertSyntax = EngineSyntax::VALUES_FUNCTION;
+                break;
+            case UpsertSyntax::ROW_ALIAS:
+                _upsertSyntax = EngineSyntax::ROW_ALIAS;
+                break;
+            default:        //the passed syntax is not known
+                throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::setUpsertSyntax") +
+                                       "the syntax of upserts is unknown");
         }
 
         return 0;
     }
 
-    inline int addCompositeCondition(const std::vector<DBQueryBuilder::Type::QueryCondition::Ptr> qConditions) {
-        DBQueryBuilder::Type::QueryCondition *qCondition =  new DBQueryBuilder::Type::CompQueryCondition(qConditions);
-
-        //check is the "where"-clause has been initialized
-        if (_whereClause.empty()) {     //the "where"-clause has not been initialized
-            //initialize the "where"-clause
-            _whereClause = "where ";
-
-            //append the QueryConjunction to the where-clause
-            _whereClause += qCondition->toString(false);
-        } else {        //the "where"-clause has been initialized
-            //append the QueryConjunction ot the "where"-clause
-            _whereClause += " ";
-            _whereClause += qCondition->toString(true);
+    inline std::string buildLoadDataStatement(const std::string &path, const LoadDataFormat &format) {
+        checkFormat(format, "Core::buildLoadDataStatement");
+        if (_tableName.empty()) {       //the table-name is empty
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::buildLoadDataStatement") +
+                                   "empty table-name");
+        } else if (_rows.empty()) {     //there is no Resource-representation to load
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::buildLoadDataStatement") +
+                                   "empty Resource-representation");
         }
 
+        std::string statement;      //the statement to be returned
+        renderInto(statement, [&](auto &writer) {
+            writeLoadDataStatement(writer, path, format, _rows.columns().size(),
+                                   [&](const std::size_t &column) -> const std::string & { return _rows.columns()[column]; });
+        });
 
-        //free the temporarily allocated-memory
-        delete qCondition;
-        return  0;
+        return statement;
     }
 
-    inline int addResourceRep(const std::map<std::string, std::string> &resourceRep) {
-        //cache the Resource-representation
-        _resourceRep = resourceRep;
-
-        return 0;
-    }
+    inline std::string buildLoadDataStatement(const std::string &path, const ColumnBatch &batch,
+                                              const LoadDataFormat &format) {
+        checkFormat(format, "Core::buildLoadDataStatement");
+        if (_tableName.empty()) {       //the table-name is empty
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::buildLoadDataStatement") +
+                                   "empty table-name");
+        } else if (batch.columns().empty()) {       //there is no column to load
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::buildLoadDataStatement") +
+                                   "empty Resource-representation");
+        }
 
-    inline int setLimit(const int &limit) {
-        //create the "limit"-phrase of the query being built
-        _limitPhrase = "limit ";
-        _limitPhrase += std::to_string(limit);
+        std::string statement;      //the statement to be returned
+        renderInto(statement, [&](auto &writer) {
+            writeLoadDataStatement(writer, path, format, batch.columns().size(),
+                                   [&](const std::size_t &column) -> const std::string & { return batch.columns()[column].name; });
+        });
 
-        return 0;
+        return statement;
     }
 
-    inline int setOrder(const std::string &columnName, const Order &order) {
-        //create the "order by" clause of the query being built
-        _orderClause = "order by `";
-        _orderClause += columnName;
-        _orderClause += "` ";
-
-        //set the proper ordering for the clause
-        switch (order) {
-            case Order::ASC:
-                _orderClause += "asc";
-                break;
-            case Order::DEC:
-                _orderClause += "desc";
-                break;
-            default:        //the passed order is not known
-                break;
+    inline std::size_t buildLoadDataPayloadInto(std::string &buffer, const LoadDataFormat &format) {
+        DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+        checkFormat(format, "Core::buildLoadDataPayload");
+        if (_rows.empty()) {     //there is no Resource-representation to load
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::buildLoadDataPayload") +
+                                   "empty Resource-representation");
         }
+        _rows.sortBy(_batchOrder);
 
-        return 0;
+        const LoadDataEscaper escaper(format);
+        return renderInto(buffer, [&](auto &writer) { writeLoadDataPayload(writer, format, escaper); });
     }
 
-    inline std::string buildQuery() {
-        std::string query;      //the query to be returned
-
-        //confirm that the action has been set
-        if (_action == Action::NIL) {       //The action has not been set
-            //report the error
-            throw std::logic_error("In Builder::MYSQLBuilder::Core::buildQuery: call to Builder::MYSQLBuilder::Core::setAction(const Action &) must be made before query can be built");
+    inline std::size_t streamLoadDataPayload(const LoadDataSink &sink, const LoadDataFormat &format,
+                                             const std::size_t &chunkSize) {
+        DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+        checkFormat(format, "Core::streamLoadDataPayload");
+        if (_rows.empty()) {     //there is no Resource-representation to load
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::streamLoadDataPayload") +
+                                   "empty Resource-representation");
+        } else if (chunkSize == 0) {       //no chunk could hold anything
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::streamLoadDataPayload") +
+                                   "the size of a chunk cannot be zero");
         }
+        _rows.sortBy(_batchOrder);
 
-        //build the main-clause and append to the query
-        switch (_action) {
-            case Action::INSERT:
-                query = _mainClauseCreator->buildInsert(_tableName, _resourceRep);
-                break;
-            case Action::SELECT:
-                query = _mainClauseCreator->buildSelect(_columns, _tableName);
-                break;
-            case Action::UPDATE:
-                query = _mainClauseCreator->buildUpdate(_tableName, _resourceRep);
-                break;
-            case Action::DELETE:
-                query = _mainClauseCreator->buildDelete(_tableName);
-                break;
-            default:        //_action is not accounted for
-                //report the error
-                throw std::logic_error("In Builder::MYSQLBuilder::Core::buildQuery: the action of the query is not accounted for");
-        }
+        //the file is written once, straight into the chunks
+        const LoadDataEscaper escaper(format);
+        DBQueryBuilder::Builder::Engine::ChunkWriter writer(sink, chunkSize);
+        writeLoadDataPayload(writer, format, escaper);
+        writer.flush();
 
-        //confirm whether or not the query may expect a "where"-clause
-        if (_qDescriptor->setsWhere(_action)) {     //a "where"-cause may be set
-            query += " ";       //space for next subordinate
-            query += _whereClause;
-        }
+        return writer.written();
+    }
 
-        //confirm whether or not the query may expect an "order"-clause
-        if (_qDescriptor->setsOrder(_action)) {        //an "order"-clause may be set
-            query += " ";       //space for next subordinate
-            query += _orderClause;
+    inline std::size_t streamLoadDataPayload(const ColumnBatch &batch, const LoadDataSink &sink,
+                                             const LoadDataFormat &format, const std::size_t &chunkSize) {
+        DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+        checkFormat(format, "Core::streamLoadDataPayload");
+        if (batch.columns().empty()) {      //there is no column to load
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::streamLoadDataPayload") +
+                                   "empty Resource-representation");
+        } else if (chunkSize == 0) {       //no chunk could hold anything
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<MYSQLDialect>("Core::streamLoadDataPayload") +
+                                   "the size of a chunk cannot be zero");
         }
 
-        //confirm whether or not the query may expect a "limit"-phrase
-        if (_qDescriptor->setsLimit(_action)) {     //a "limit-phrase may be set"
-            query += " ";       //space for the next subordinate
-            query += _limitPhrase;
+        const LoadDataEscaper escaper(format);
+        DBQueryBuilder::Builder::Engine::ChunkWriter writer(sink, chunkSize);
+        for (std::size_t row = 0; row < batch.rows(); ++row) {
+            for (std::size_t column = 0; column < batch.columns().size(); ++column) {
+                if (column != 0) {
+                    writer.append(format.fieldTerminator.data(), format.fieldTerminator.size());
+                }
+                writeLoadDataCell(writer, escaper, batch.columns()[column], row);
+            }
+            writer.append(format.lineTerminator.data(), format.lineTerminator.size());
         }
+        writer.flush();
+
+        return writer.written();
+    }
 
-        return query;
+    static inline std::vector<std::string> buildLoadDataPrologue(const int &disabledChecks) {
+        return checkStatements(disabledChecks, true, "Core::buildLoadDataPrologue");
     }
 
-    ~Core() {
-        //free allocated memory
-        delete _qDescriptor, delete _mainClauseCreator;
+    static inline std::vector<std::string> buildLoadDataEpilogue(const int &disabledChecks) {
+        return checkStatements(disabledChecks, false, "Core::buildLoadDataEpilogue");
     }
 };
 
@@ -406,40 +411,187 @@ MYSQLBuilder::MYSQLBuilder() {
     _core = new Core();
 }
 
+MYSQLBuilder::MYSQLBuilder(Core *core) : _core(core) {}
+
+DBQueryBuilder::Builder::IQueryBuilder *MYSQLBuilder::clone() const {
+    auto *core = new Core(*_core);
+    core->reserveAs(*_core);
+
+    return new MYSQLBuilder(core);
+}
+
+int MYSQLBuilder::restore(const IQueryBuilder &prototype) {
+    const auto *source = dynamic_cast<const MYSQLBuilder *>(&prototype);
+    if (source == nullptr) {       //the prototype is of another dialect
+        throw std::logic_error("In Builder::MYSQLBuilder::restore: the prototype is not a MYSQLBuilder");
+    }
+
+    return _core->instrumented([&]() { return Core::restore(*_core, *source->_core); });
+}
+
+int MYSQLBuilder::reserve(const std::size_t &columns, const std::size_t &rows, const std::size_t &conditions,
+                          const std::size_t &textLength) {
+    return _core->instrumented([&]() { return _core->reserve(columns, rows, conditions, textLength); });
+}
+
 int MYSQLBuilder::setTableName(const std::string &tableName) {
-    return _core->setTableName(tableName);
+    return _core->instrumented([&]() { return _core->setTableName(tableName); });
 }
 
 int MYSQLBuilder::setAction(const Action &action) {
-    return _core->setAction(action);
+    return _core->instrumented([&]() { return _core->setAction(action); });
+}
+
+int MYSQLBuilder::addUpsertColumn(const std::string &column, const Merge &merge) {
+    return _core->instrumented([&]() { return _core->addUpsertColumn(column, merge); });
+}
+
+int MYSQLBuilder::setUpsertSyntax(const UpsertSyntax &syntax) {
+    return _core->instrumented([&]() { return _core->setUpsertSyntax(syntax); });
 }
 
 int MYSQLBuilder::setTargetColumns(const std::vector<std::string> &columns) {
-    return _core->setTargetColumns(columns);
+    return _core->instrumented([&]() { return _core->setTargetColumns(columns); });
 }
 
 int MYSQLBuilder::addCondition(const std::shared_ptr<Type::QueryCondition> &qCondition) {
-    return _core->addCondition(qCondition);
+    return _core->instrumented([&]() { return _core->addCondition(qCondition); });
 }
 
 int MYSQLBuilder::addCompositeCondition(const std::vector<std::shared_ptr<Type::QueryCondition>> qConditions) {
-    return _core->addCompositeCondition(qConditions);
+    return _core->instrumented([&]() { return _core->addCompositeCondition(qConditions); });
+}
+
+int MYSQLBuilder::addConditions(const Type::ConditionTree &conditions) {
+    return _core->instrumented([&]() { return _core->addConditions(conditions); });
 }
 
 int MYSQLBuilder::addResourceRep(const std::map<std::string, std::string> &resourceRep) {
-    return _core->addResourceRep(resourceRep);
+    return _core->instrumented([&]() { return _core->addResourceRep(resourceRep); });
+}
+
+int MYSQLBuilder::addRow(const std::map<std::string, std::string> &resourceRep) {
+    return _core->instrumented([&]() { return _core->addRow(resourceRep); });
+}
+
+int MYSQLBuilder::setBatchLimits(const std::size_t &maxBytes, const std::size_t &maxRows) {
+    return _core->instrumented([&]() { return _core->setBatchLimits(maxBytes, maxRows); });
+}
+
+int MYSQLBuilder::setBatchOrder(const std::string &columnName) {
+    return _core->instrumented([&]() { return _core->setBatchOrder(columnName); });
 }
 
 int MYSQLBuilder::setOrder(const std::string &columnName, const Order &order) {
-    return _core->setOrder(columnName, order);
+    return _core->instrumented([&]() { return _core->setOrder(columnName, order); });
 }
 
 int MYSQLBuilder::setLimit(const int &limit) {
-    return _core->setLimit(limit);
+    return _core->instrumented([&]() { return _core->setLimit(limit); });
+}
+
+int MYSQLBuilder::setKeyset(const std::vector<std::string> &keyColumns, const int &pageSize, const Order &order) {
+    return _core->instrumented([&]() { return _core->setKeyset(keyColumns, pageSize, order); });
+}
+
+int MYSQLBuilder::seekAfter(const std::vector<std::string> &lastKey) {
+    return _core->instrumented([&]() { return _core->seekAfter(lastKey); });
+}
+
+int MYSQLBuilder::setInList(const std::string &column, const std::vector<std::string> &values, const bool &negate) {
+    return _core->instrumented([&]() { return _core->setInList({column}, values, negate); });
+}
+
+int MYSQLBuilder::setInList(const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &entries,
+                         const bool &negate) {
+    return _core->instrumented([&]() { return _core->setInList(columns, entries, negate); });
+}
+
+int MYSQLBuilder::setInListLimit(const std::size_t &maxEntries) {
+    return _core->instrumented([&]() { return _core->setInListLimit(maxEntries); });
 }
 
 std::string MYSQLBuilder::buildQuery() {
-    return _core->buildQuery();
+    return _core->instrumented([&]() { return _core->buildQuery(); });
+}
+
+std::size_t MYSQLBuilder::buildQueryInto(std::string &buffer) {
+    return _core->instrumented([&]() { return _core->buildQueryInto(buffer); });
+}
+
+std::size_t MYSQLBuilder::buildQueryInto(char *buffer, const std::size_t &capacity) {
+    return _core->instrumented([&]() { return _core->buildQueryInto(buffer, capacity); });
+}
+
+std::vector<std::string> MYSQLBuilder::buildQueries() {
+    return _core->instrumented([&]() { return _core->buildQueries(); });
+}
+
+std::vector<std::string> MYSQLBuilder::buildColumnarInsert(const Type::ColumnBatch &batch) {
+    return _core->instrumented([&]() { return _core->buildColumnarInsert(batch); });
+}
+
+std::string MYSQLBuilder::buildLoadDataStatement(const std::string &path, const LoadDataFormat &format) {
+    return _core->instrumented([&]() { return _core->buildLoadDataStatement(path, format); });
+}
+
+std::string MYSQLBuilder::buildLoadDataStatement(const std::string &path, const Type::ColumnBatch &batch,
+                                                 const LoadDataFormat &format) {
+    return _core->instrumented([&]() { return _core->buildLoadDataStatement(path, batch, format); });
+}
+
+std::size_t MYSQLBuilder::buildLoadDataPayloadInto(std::string &buffer, const LoadDataFormat &format) {
+    return _core->instrumented([&]() { return _core->buildLoadDataPayloadInto(buffer, format); });
+}
+
+std::size_t MYSQLBuilder::streamLoadDataPayload(const LoadDataSink &sink, const LoadDataFormat &format,
+                                                const std::size_t &chunkSize) {
+    return _core->instrumented([&]() { return _core->streamLoadDataPayload(sink, format, chunkSize); });
+}
+
+std::size_t MYSQLBuilder::streamLoadDataPayload(const Type::ColumnBatch &batch, const LoadDataSink &sink,
+                                                const LoadDataFormat &format, const std::size_t &chunkSize) {
+    return _core->instrumented([&]() { return _core->streamLoadDataPayload(batch, sink, format, chunkSize); });
+}
+
+std::vector<std::string> MYSQLBuilder::buildLoadDataPrologue(const int &disabledChecks) {
+    return Core::buildLoadDataPrologue(disabledChecks);
+}
+
+std::vector<std::string> MYSQLBuilder::buildLoadDataEpilogue(const int &disabledChecks) {
+    return Core::buildLoadDataEpilogue(disabledChecks);
+}
+
+DBQueryBuilder::Builder::ParameterizedQuery MYSQLBuilder::buildParameterizedQuery() {
+    return _core->instrumented([&]() { return _core->buildParameterizedQuery(); });
+}
+
+std::size_t MYSQLBuilder::buildParameterizedQueryInto(ParameterizedQuery &query) {
+    return _core->instrumented([&]() { return _core->buildParameterizedQueryInto(query); });
+}
+
+DBQueryBuilder::Builder::FragmentedQuery MYSQLBuilder::buildFragmentedQuery() {
+    return _core->instrumented([&]() { return _core->buildFragmentedQuery(); });
+}
+
+std::size_t MYSQLBuilder::buildFragmentedQueryInto(FragmentedQuery &query) {
+    return _core->instrumented([&]() { return _core->buildFragmentedQueryInto(query); });
+}
+
+DBQueryBuilder::Type::QueryTemplate::Ptr MYSQLBuilder::compile() {
+    return _core->instrumented([&]() { return _core->compile(); });
+}
+
+int MYSQLBuilder::reset() {
+    return _core->instrumented([&]() { return _core->reset(); });
+}
+
+DBQueryBuilder::Diagnostics::AllocationStats MYSQLBuilder::allocationStats() const {
+    return _core->_allocations.stats();
+}
+
+void MYSQLBuilder::resetAllocationStats() {
+    _core->_allocations.reset();
 }
 
 MYSQLBuilder::~MYSQLBuilder() {
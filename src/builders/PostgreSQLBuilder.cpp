@@ -0,0 +1,382 @@
+//
+// Created by fo on 19/04/2021.
+//
+// This file contains the implementation of all the member-functions of PostgreSQLBuilder, with the writing of the
+// payloads of "COPY" commands
+#include "../../builders/PostgreSQLBuilder.h"
+#include "../../utils/Escaper.h"
+#include "QueryEngine.h"
+#include <limits>
+
+using PostgreSQLBuilder = DBQueryBuilder::Builder::PostgreSQLBuilder;
+
+namespace {
+    /**
+     * @brief: the dialect of PostgreSQL, as the engine renders it; check src/builders/QueryEngine.h
+     */
+    struct PostgreSQLDialect {
+        using Clause = DBQueryBuilder::Builder::Engine::Clause;
+
+        static constexpr char builder[] = "PostgreSQLBuilder";
+        static constexpr char quote = '"';
+        static constexpr char placeholder = '$';
+        static constexpr bool numbersPlaceholders = true;
+        static constexpr bool cachesTemplates = false;
+        static constexpr std::uint64_t seed = 0x706F737467726573ull;       //"postgres"
+
+        /**
+         * @brief: the capability-mask of each query-type, indexed by DBQueryBuilder::Action
+         */
+        static constexpr std::uint8_t clauses[] = {
+                0,                                                  //INSERT
+                Clause::WHERE | Clause::ORDER | Clause::LIMIT,      //SELECT
+                Clause::WHERE,                                      //UPDATE
+                Clause::WHERE,                                      //DELETE
+                0,                                                  //UPSERT
+                0                                                   //NIL
+        };
+
+        /**
+         * @brief: with standard_conforming_strings, the default since PostgreSQL 9.1, only the quotes of a literal are
+         * escaped
+         */
+        static inline std::size_t literalLength(const char *chars, const std::size_t &count) {
+            return DBQueryBuilder::Util::Escaper::quotedLength(chars, count, '\'');
+        }
+
+        static inline char *escapeLiteral(const char *chars, const std::size_t &count, char *out) {
+            return DBQueryBuilder::Util::Escaper::escapeQuoted(chars, count, '\'', out);
+        }
+
+        static inline std::size_t identifierLength(const char *chars, const std::size_t &count) {
+            return DBQueryBuilder::Util::Escaper::quotedLength(chars, count, quote);
+        }
+
+        static inline char *escapeIdentifier(const char *chars, const std::size_t &count, char *out) {
+            return DBQueryBuilder::Util::Escaper::escapeQuoted(chars, count, quote, out);
+        }
+    };
+
+    /**
+     * @brief: the character that follows the backslash in the escaped form of each byte of a field of the text format
+     * of "COPY"; zero, for bytes that are copied as they are
+     */
+    static constexpr struct CopyEscapeTable {
+        char _replacement[256]{};
+
+        constexpr CopyEscapeTable() {
+            _replacement[static_cast<unsigned char>('\\')] = '\\';
+            _replacement[static_cast<unsigned char>('\b')] = 'b';
+            _replacement[static_cast<unsigned char>('\f')] = 'f';
+            _replacement[static_cast<unsigned char>('\n')] = 'n';
+            _replacement[static_cast<unsigned char>('\r')] = 'r';
+            _replacement[static_cast<unsigned char>('\t')] = 't';
+            _replacement[static_cast<unsigned char>('\v')] = 'v';
+        }
+
+        constexpr char operator[](const char &byte) const {
+            return _replacement[static_cast<unsigned char>(byte)];
+        }
+    } copyEscapeTable;
+}
+
+class PostgreSQLBuilder::Core : public DBQueryBuilder::Builder::Engine::BuilderCore<PostgreSQLDialect> {
+    /**
+     * @brief: writes the passed value, in network byte-order, as an integer of the passed number of bytes
+     */
+    template<typename Writer>
+    static inline void writeInteger(Writer &writer, const std::uint32_t &value, const std::size_t &bytes) {
+        char bigEndian[4];
+        for (std::size_t i = 0; i < bytes; ++i) {
+            bigEndian[i] = static_cast<char>(value >> (8u * (bytes - 1 - i)));
+        }
+        writer.append(bigEndian, bytes);
+    }
+
+    /**
+     * @brief: writes the passed value as a field of the text format of "COPY"; backslashes and the control-characters
+     * that could be taken for delimiters are backslash-escaped, and runs that need no escaping are written whole
+     * @throws std::logic_error: if the value holds a NUL-character, which the text format cannot carry
+     */
+    template<typename Writer>
+    static inline void writeTextField(Writer &writer, const std::string_view &value) {
+        if (!value.empty() && std::memchr(value.data(), '\0', value.size()) != nullptr) {
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<PostgreSQLDialect>("Core::writeTextField") +
+                                   "a value of the text format of \"COPY\" cannot hold a NUL-character");
+        }
+
+        const char *run = value.data();     //the beginning of the run of characters that need no escaping
+        const char *end = value.data() + value.size();
+        for (const char *byte = run; byte != end; ++byte) {
+            const char replacement = copyEscapeTable[*byte];
+            if (replacement == 0) {
+                continue;
+            }
+
+            writer.append(run, byte - run);
+            const char escaped[] = {'\\', replacement};
+            writer.append(escaped, 2);
+            run = byte + 1;
+        }
+        writer.append(run, end - run);
+    }
+
+public:
+    /**
+     * @brief: writes the "COPY" command of the rows added so far into the passed writer
+     * @param writer: the LengthCounter or BufferWriter that receives the command
+     */
+    template<typename Writer>
+    inline void writeCopyCommand(Writer &writer, const CopyFormat &format) {
+        //confirm that the table-name is not empty
+        if (_tableName.empty()) {       //the table-name is empty
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<PostgreSQLDialect>("Core::buildCopyCommand") +
+                                   "empty table-name");
+        } else if (_rows.empty()) {     //there is no Resource-representation to load
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<PostgreSQLDialect>("Core::buildCopyCommand") +
+                                   "empty Resource-representation");
+        }
+
+        writer.append("copy ");
+        writer.appendIdentifier(_tableName);
+
+        //append the enumeration of the concerned columns, in the order of the fields of every row of the payload
+        writer.append("(");
+        for (std::size_t column = 0; column < _rows.columns().size(); ++column) {
+            if (column != 0) {
+                writer.append(", ");
+            }
+            writer.appendIdentifier(_rows.columns()[column]);
+        }
+        writer.append(") from stdin");
+
+        if (format == CopyFormat::BINARY) {
+            writer.append(" with (format binary)");
+        }
+    }
+
+    /**
+     * @brief: writes the payload of the "COPY" command of the rows added so far, in the passed format, into the passed
+     * writer; the rows are written in the order set by setBatchOrder(const std::string &)
+     * @param writer: the LengthCounter, BufferWriter or ChunkWriter that receives the payload
+     */
+    template<typename Writer>
+    inline void writeCopyPayload(Writer &writer, const CopyFormat &format) {
+        if (_rows.empty()) {     //there is no Resource-representation to load
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<PostgreSQLDialect>("Core::buildCopyPayload") +
+                                   "empty Resource-representation");
+        }
+
+        const std::size_t columns = _rows.columns().size();
+        if (format == CopyFormat::BINARY) {
+            if (columns > static_cast<std::size_t>(std::numeric_limits<std::int16_t>::max())) {
+                throw std::length_error(DBQueryBuilder::Builder::Engine::origin<PostgreSQLDialect>("Core::buildCopyPayload") +
+                                        "a row of the binary format of \"COPY\" cannot have that many fields");
+            }
+
+            //the signature ends with a NUL-character, which is the terminator of the literal
+            static constexpr char signature[] = "PGCOPY\n\377\r\n";
+            writer.append(signature, sizeof(signature));
+            writeInteger(writer, 0, 4);     //the flags
+            writeInteger(writer, 0, 4);     //the length of the extension of the header
+        }
+
+        for (std::size_t position = 0; position < _rows.rows(); ++position) {
+            if (format == CopyFormat::BINARY) {
+                writeInteger(writer, static_cast<std::uint32_t>(columns), 2);
+            }
+
+            for (std::size_t column = 0; column < columns; ++column) {
+                const std::string_view value = _rows.cell(position, column);
+                if (format == CopyFormat::TEXT) {
+                    if (column != 0) {
+                        writer.append("\t");
+                    }
+                    writeTextField(writer, value);
+                    continue;
+                }
+
+                if (value.size() > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+                    throw std::length_error(DBQueryBuilder::Builder::Engine::origin<PostgreSQLDialect>("Core::buildCopyPayload") +
+                                            "a value is longer than a field of the binary format of \"COPY\" can be");
+                }
+                writeInteger(writer, static_cast<std::uint32_t>(value.size()), 4);
+                writer.append(value.data(), value.size());
+            }
+
+            if (format == CopyFormat::TEXT) {
+                writer.append("\n");
+            }
+        }
+
+        if (format == CopyFormat::BINARY) {
+            writeInteger(writer, 0xFFFFu, 2);       //the trailer, a field-count of -1
+        }
+    }
+
+    inline std::string buildCopyCommand(const CopyFormat &format) {
+        std::string command;        //the command to be returned
+        renderInto(command, [&](auto &writer) { writeCopyCommand(writer, format); });
+
+        return command;
+    }
+
+    inline std::size_t buildCopyPayloadInto(std::string &buffer, const CopyFormat &format) {
+        DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+        _rows.sortBy(_batchOrder);
+
+        return renderInto(buffer, [&](auto &writer) { writeCopyPayload(writer, format); });
+    }
+
+    inline std::size_t streamCopyPayload(const CopySink &sink, const CopyFormat &format, const std::size_t &chunkSize) {
+        DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+        if (chunkSize == 0) {       //no chunk could hold anything
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<PostgreSQLDialect>("Core::streamCopyPayload") +
+                                   "the size of a chunk cannot be zero");
+        }
+        _rows.sortBy(_batchOrder);
+
+        //the payload is written once, straight into the chunks
+        DBQueryBuilder::Builder::Engine::ChunkWriter writer(sink, chunkSize);
+        writeCopyPayload(writer, format);
+        writer.flush();
+
+        return writer.written();
+    }
+};
+
+PostgreSQLBuilder::PostgreSQLBuilder() {
+    _core = new Core();
+}
+
+PostgreSQLBuilder::PostgreSQLBuilder(Core *core) : _core(core) {}
+
+DBQueryBuilder::Builder::IQueryBuilder *PostgreSQLBuilder::clone() const {
+    auto *core = new Core(*_core);
+    core->reserveAs(*_core);
+
+    return new PostgreSQLBuilder(core);
+}
+
+int PostgreSQLBuilder::restore(const IQueryBuilder &prototype) {
+    const auto *source = dynamic_cast<const PostgreSQLBuilder *>(&prototype);
+    if (source == nullptr) {       //the prototype is of another dialect
+        throw std::logic_error("In Builder::PostgreSQLBuilder::restore: the prototype is not a PostgreSQLBuilder");
+    }
+
+    return _core->instrumented([&]() { return Core::restore(*_core, *source->_core); });
+}
+
+int PostgreSQLBuilder::reserve(const std::size_t &columns, const std::size_t &rows, const std::size_t &conditions,
+                               const std::size_t &textLength) {
+    return _core->instrumented([&]() { return _core->reserve(columns, rows, conditions, textLength); });
+}
+
+int PostgreSQLBuilder::setTableName(const std::string &tableName) {
+    return _core->instrumented([&]() { return _core->setTableName(tableName); });
+}
+
+int PostgreSQLBuilder::setAction(const Action &action) {
+    return _core->instrumented([&]() { return _core->setAction(action); });
+}
+
+int PostgreSQLBuilder::setTargetColumns(const std::vector<std::string> &columns) {
+    return _core->instrumented([&]() { return _core->setTargetColumns(columns); });
+}
+
+int PostgreSQLBuilder::addCondition(const std::shared_ptr<Type::QueryCondition> &qCondition) {
+    return _core->instrumented([&]() { return _core->addCondition(qCondition); });
+}
+
+int PostgreSQLBuilder::addCompositeCondition(const std::vector<std::shared_ptr<Type::QueryCondition>> qConditions) {
+    return _core->instrumented([&]() { return _core->addCompositeCondition(qConditions); });
+}
+
+int PostgreSQLBuilder::addConditions(const Type::ConditionTree &conditions) {
+    return _core->instrumented([&]() { return _core->addConditions(conditions); });
+}
+
+int PostgreSQLBuilder::addResourceRep(const std::map<std::string, std::string> &resourceRep) {
+    return _core->instrumented([&]() { return _core->addResourceRep(resourceRep); });
+}
+
+int PostgreSQLBuilder::addRow(const std::map<std::string, std::string> &resourceRep) {
+    return _core->instrumented([&]() { return _core->addRow(resourceRep); });
+}
+
+int PostgreSQLBuilder::setBatchLimits(const std::size_t &maxBytes, const std::size_t &maxRows) {
+    return _core->instrumented([&]() { return _core->setBatchLimits(maxBytes, maxRows); });
+}
+
+int PostgreSQLBuilder::setBatchOrder(const std::string &columnName) {
+    return _core->instrumented([&]() { return _core->setBatchOrder(columnName); });
+}
+
+int PostgreSQLBuilder::setOrder(const std::string &columnName, const Order &order) {
+    return _core->instrumented([&]() { return _core->setOrder(columnName, order); });
+}
+
+int PostgreSQLBuilder::setLimit(const int &limit) {
+    return _core->instrumented([&]() { return _core->setLimit(limit); });
+}
+
+std::string PostgreSQLBuilder::buildQuery() {
+    return _core->instrumented([&]() { return _core->buildQuery(); });
+}
+
+std::size_t PostgreSQLBuilder::buildQueryInto(std::string &buffer) {
+    return _core->instrumented([&]() { return _core->buildQueryInto(buffer); });
+}
+
+std::size_t PostgreSQLBuilder::buildQueryInto(char *buffer, const std::size_t &capacity) {
+    return _core->instrumented([&]() { return _core->buildQueryInto(buffer, capacity); });
+}
+
+std::vector<std::string> PostgreSQLBuilder::buildQueries() {
+    return _core->instrumented([&]() { return _core->buildQueries(); });
+}
+
+DBQueryBuilder::Builder::ParameterizedQuery PostgreSQLBuilder::buildParameterizedQuery() {
+    return _core->instrumented([&]() { return _core->buildParameterizedQuery(); });
+}
+
+std::size_t PostgreSQLBuilder::buildParameterizedQueryInto(ParameterizedQuery &query) {
+    return _core->instrumented([&]() { return _core->buildParameterizedQueryInto(query); });
+}
+
+DBQueryBuilder::Builder::FragmentedQuery PostgreSQLBuilder::buildFragmentedQuery() {
+    return _core->instrumented([&]() { return _core->buildFragmentedQuery(); });
+}
+
+std::size_t PostgreSQLBuilder::buildFragmentedQueryInto(FragmentedQuery &query) {
+    return _core->instrumented([&]() { return _core->buildFragmentedQueryInto(query); });
+}
+
+std::string PostgreSQLBuilder::buildCopyCommand(const CopyFormat &format) {
+    return _core->instrumented([&]() { return _core->buildCopyCommand(format); });
+}
+
+std::size_t PostgreSQLBuilder::buildCopyPayloadInto(std::string &buffer, const CopyFormat &format) {
+    return _core->instrumented([&]() { return _core->buildCopyPayloadInto(buffer, format); });
+}
+
+std::size_t PostgreSQLBuilder::streamCopyPayload(const CopySink &sink, const CopyFormat &format,
+                                                 const std::size_t &chunkSize) {
+    return _core->instrumented([&]() { return _core->streamCopyPayload(sink, format, chunkSize); });
+}
+
+int PostgreSQLBuilder::reset() {
+    return _core->instrumented([&]() { return _core->reset(); });
+}
+
+DBQueryBuilder::Diagnostics::AllocationStats PostgreSQLBuilder::allocationStats() const {
+    return _core->_allocations.stats();
+}
+
+void PostgreSQLBuilder::resetAllocationStats() {
+    _core->_allocations.reset();
+}
+
+PostgreSQLBuilder::~PostgreSQLBuilder() {
+    delete _core;
+}
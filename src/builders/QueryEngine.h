@@ -0,0 +1,2297 @@
+//
+// Created by fo on 19/04/2021.
+//
+// This file contains the definition of the engine that every dialect-specific builder renders its queries with: the
+// writers, the holders of rows and guard-conditions, the creator of main-clauses, and BuilderCore, the implementer that
+// a builder's Core derives from. All of them are parameterized by a dialect, a struct that provides:
+//  builder: the name of the builder, as it appears in the messages of the errors reported
+//  quote: the character that identifiers are quoted with
+//  placeholder, numbersPlaceholders: the character that a placeholder begins with, and whether or not it is followed by
+//      the position of the placeholder, e.g. "$1"
+//  cachesTemplates: whether or not queries are rendered through Type::TemplateCache, whose templates render
+//      MYSQL-literals
+//  seed: the seed of the digest of the shapes of queries
+//  clauses: the capability-mask of each query-type, indexed by DBQueryBuilder::Action
+//  literalLength, escapeLiteral, identifierLength, escapeIdentifier: as those of Util::Escaper, for the dialect
+#include "../../builders/IQueryBuilder.h"
+#include "../../types/CompQueryCondition.h"
+#include "../../types/TemplateCache.h"
+#include "../../types/ColumnBatch.h"
+#include "../../types/ConditionTree.h"
+#include "../../types/QueryTemplate.h"
+#include "../../diagnostics/Allocations.h"
+#include "../../diagnostics/Latency.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+#ifndef DBQUERYBUILDER_QUERYENGINE_H
+#define DBQUERYBUILDER_QUERYENGINE_H
+
+namespace DBQueryBuilder::Builder::Engine {
+
+    /**
+     * @brief: returns the beginning of the message of an error reported by the passed member-function of the builder of
+     * the passed dialect, e.g. "In Builder::MYSQLBuilder::Core::buildSelect: "
+     * @param function: the qualified name of the member-function, within the builder
+     */
+    template<typename Dialect>
+    inline std::string origin(const char *function) {
+        std::string msg = "In Builder::";
+        msg += Dialect::builder;
+        msg += "::";
+        msg += function;
+        msg += ": ";
+
+        return msg;
+    }
+
+    /**
+     * @brief: the subordinate clauses that a query may expect, as bits of the capability-mask of a dialect
+     */
+    enum Clause : std::uint8_t {
+        WHERE = 1u << 0u,
+        ORDER = 1u << 1u,
+        LIMIT = 1u << 2u,
+        DUPLICATE_KEY_UPDATE = 1u << 3u     //the "on duplicate key update"-clause, whose dialect can render Action::UPSERT
+    };
+
+    /**
+     * @brief: the enumeration of the resolutions of the conflicts of the rows of an "INSERT" query with the rows already
+     * held by the table, as SQLite spells them
+     */
+    enum class Conflict : std::uint8_t {
+        ABORT,      //the query fails, as a plain "insert into" does
+        REPLACE,        //"insert or replace into": the conflicting rows are deleted first
+        IGNORE      //"insert or ignore into": the conflicting rows are skipped
+    };
+
+    /**
+     * @brief: the enumeration of the expressions that merge a value of the row of an "UPSERT" query into the value of
+     * the same column of the row already held by the table
+     */
+    enum class Merge : std::uint8_t {
+        OVERWRITE,      //the value of the row replaces the held one
+        ADD,        //the value of the row is added to the held one
+        GREATEST        //the greater of the value of the row and the held one is kept
+    };
+
+    /**
+     * @brief: the enumeration of the ways in which the "on duplicate key update"-clause refers to the values of the row
+     */
+    enum class UpsertSyntax : std::uint8_t {
+        VALUES_FUNCTION,        //"values(`c`)", which MYSQL deprecates since 8.0.20
+        ROW_ALIAS       //"as `new` ... `new`.`c`", which MYSQL accepts since 8.0.19
+    };
+
+    /**
+     * @brief: a column that an "UPSERT" query updates, with the expression that merges its value
+     */
+    struct Upsert {
+        std::string column;
+        Merge merge;
+    };
+
+    /**
+     * @brief: describes the type of the query being built, by the capability-mask of the dialect
+     */
+    template<typename Dialect>
+    class QueryDescriptor {
+        static_assert(sizeof(Dialect::clauses) == DBQueryBuilder::Action::NIL + 1, "every Action must be described");
+
+    public:
+        /**
+         * @brief: confirms whether or not the concerned query may expect a "where" clause
+         * @param action: the type of the concerned query; it must be a known Action
+         * @return
+         */
+        static constexpr bool setsWhere(const DBQueryBuilder::Action &action) {
+            return Dialect::clauses[action] & Clause::WHERE;
+        }
+
+        /**
+         * @brief: confirms whether or not the query being built may expect an "order by" clause
+         * @param action: the type of the concerned query; it must be a known Action
+         * @return
+         */
+        static constexpr bool setsOrder(const DBQueryBuilder::Action &action) {
+            return Dialect::clauses[action] & Clause::ORDER;
+        }
+
+        /**
+         * @brief: confirms whether or not the query being built may expect a "limit" phrase
+         * @param action: the type of the concerned query; it must be a known Action
+         * @return
+         */
+        static constexpr bool setsLimit(const DBQueryBuilder::Action &action) {
+            return Dialect::clauses[action] & Clause::LIMIT;
+        }
+
+        /**
+         * @brief: confirms whether or not the query being built may expect an "on duplicate key update"-clause
+         * @param action: the type of the concerned query; it must be a known Action
+         * @return
+         */
+        static constexpr bool setsDuplicateKeyUpdate(const DBQueryBuilder::Action &action) {
+            return Dialect::clauses[action] & Clause::DUPLICATE_KEY_UPDATE;
+        }
+
+        /**
+         * @brief: confirms whether or not the query being built pushes the rows added to the builder, and so is split
+         * into batches of them
+         * @param action: the type of the concerned query
+         * @return
+         */
+        static constexpr bool pushesRows(const DBQueryBuilder::Action &action) {
+            return action == DBQueryBuilder::Action::INSERT || action == DBQueryBuilder::Action::UPSERT;
+        }
+    };
+
+    /**
+     * @brief: measures the exact length of a query before it is written
+     */
+    template<typename Dialect>
+    class LengthCounter {
+        std::size_t _length{0};     //the number of characters counted so far
+
+    public:
+        /**
+         * @brief: counts the passed characters, without writing them anywhere
+         * @param count: the number of characters being counted
+         */
+        inline void append(const char *, const std::size_t &count) {
+            _length += count;
+        }
+
+        inline void append(const std::string &chars) {
+            _length += chars.size();
+        }
+
+        template<std::size_t N>
+        inline void append(const char (&)[N]) {
+            _length += N - 1;
+        }
+
+        /**
+         * @brief: counts the passed value, as an escaped and quoted literal
+         */
+        inline void appendValue(const char *chars, const std::size_t &count) {
+            _length += Dialect::literalLength(chars, count) + 2;
+        }
+
+        /**
+         * @brief: counts the passed name, as an escaped identifier, quoted by the quote of the dialect
+         */
+        inline void appendIdentifier(const char *chars, const std::size_t &count) {
+            _length += Dialect::identifierLength(chars, count) + 2;
+        }
+
+        inline void appendIdentifier(const std::string &chars) {
+            appendIdentifier(chars.data(), chars.size());
+        }
+
+        inline std::size_t length() const {
+            return _length;
+        }
+    };
+
+    /**
+     * @brief: writes a measured query into a buffer that has already been sized for it
+     */
+    template<typename Dialect>
+    class BufferWriter {
+        char *_cursor;      //the position, within the destination-buffer, of the next character to be written
+
+    public:
+        /**
+         * @param buffer: the destination-buffer; it must be large enough to hold everything that is written into it
+         */
+        inline explicit BufferWriter(char *buffer) : _cursor(buffer) {}
+
+        /**
+         * @brief: copies the passed characters into the destination-buffer
+         * @param chars: the characters being written
+         * @param count: the number of characters being written
+         */
+        inline void append(const char *chars, const std::size_t &count) {
+            std::memcpy(_cursor, chars, count);
+            _cursor += count;
+        }
+
+        inline void append(const std::string &chars) {
+            append(chars.data(), chars.size());
+        }
+
+        template<std::size_t N>
+        inline void append(const char (&literal)[N]) {
+            append(literal, N - 1);
+        }
+
+        /**
+         * @brief: writes the passed value, as an escaped and quoted literal
+         */
+        inline void appendValue(const char *chars, const std::size_t &count) {
+            *_cursor++ = '\'';
+            _cursor = Dialect::escapeLiteral(chars, count, _cursor);
+            *_cursor++ = '\'';
+        }
+
+        /**
+         * @brief: writes the passed name, as an escaped identifier, quoted by the quote of the dialect
+         */
+        inline void appendIdentifier(const char *chars, const std::size_t &count) {
+            *_cursor++ = Dialect::quote;
+            _cursor = Dialect::escapeIdentifier(chars, count, _cursor);
+            *_cursor++ = Dialect::quote;
+        }
+
+        inline void appendIdentifier(const std::string &chars) {
+            appendIdentifier(chars.data(), chars.size());
+        }
+    };
+
+    /**
+     * @brief: receives a payload a chunk at a time, e.g. that of a "COPY" command or of a "LOAD DATA" statement
+     */
+    using ChunkSink = std::function<void(const char *chars, const std::size_t &count)>;
+
+    /**
+     * @brief: passes whatever is written into it to a ChunkSink, in chunks of a fixed size
+     */
+    class ChunkWriter {
+        const ChunkSink &_sink;       //receives the chunks
+        std::size_t _chunkSize;     //the number of bytes of each chunk, but the last
+        std::string _chunk;     //the chunk being filled
+        std::size_t _written{0};        //the number of bytes passed to the sink so far
+
+    public:
+        inline ChunkWriter(const ChunkSink &sink, const std::size_t &chunkSize) : _sink(sink), _chunkSize(chunkSize) {
+            _chunk.reserve(chunkSize);
+        }
+
+        /**
+         * @brief: appends the passed characters to the chunk, passing every chunk that is filled to the sink; whole
+         * chunks of the passed characters are passed without being copied
+         * @param chars: the characters being written
+         * @param count: the number of characters being written
+         */
+        inline void append(const char *chars, std::size_t count) {
+            while (count != 0) {
+                if (_chunk.empty() && count >= _chunkSize) {        //a whole chunk can be passed as it is
+                    _sink(chars, _chunkSize);
+                    _written += _chunkSize;
+                    chars += _chunkSize, count -= _chunkSize;
+                    continue;
+                }
+
+                const std::size_t taken = std::min(count, _chunkSize - _chunk.size());
+                _chunk.append(chars, taken);
+                chars += taken, count -= taken;
+
+                if (_chunk.size() == _chunkSize) {
+                    flush();
+                }
+            }
+        }
+
+        template<std::size_t N>
+        inline void append(const char (&literal)[N]) {
+            append(literal, N - 1);
+        }
+
+        /**
+         * @brief: passes the partly filled chunk, if any, to the sink
+         */
+        inline void flush() {
+            if (!_chunk.empty()) {
+                _sink(_chunk.data(), _chunk.size());
+                _written += _chunk.size();
+                _chunk.clear();
+            }
+        }
+
+        inline std::size_t written() const {
+            return _written;
+        }
+    };
+
+    /**
+     * @brief: writes placeholders, instead of values, into the LengthCounter or BufferWriter that it wraps
+     */
+    template<typename Dialect, typename Writer>
+    class PlaceholderWriter {
+        Writer &_writer;        //the writer that receives the query
+        std::vector<std::string> *_binds;       //receives the values replaced by placeholders; nullptr, if they are not kept
+        std::size_t _placeholders{0};       //the number of placeholders written so far
+
+    public:
+        inline PlaceholderWriter(Writer &writer, std::vector<std::string> *binds) : _writer(writer), _binds(binds) {}
+
+        template<typename... Chars>
+        inline void append(const Chars &... chars) {
+            _writer.append(chars...);
+        }
+
+        template<typename... Chars>
+        inline void appendIdentifier(const Chars &... chars) {
+            _writer.appendIdentifier(chars...);
+        }
+
+        /**
+         * @brief: writes a placeholder in the place of the passed value, and keeps the value as the bind of the placeholder
+         */
+        inline void appendValue(const char *chars, const std::size_t &count) {
+            ++_placeholders;
+            if constexpr (Dialect::numbersPlaceholders) {       //the placeholder names its position, e.g. "$1"
+                char placeholder[24] = {Dialect::placeholder};
+                std::to_chars_result result = std::to_chars(placeholder + 1, placeholder + sizeof(placeholder), _placeholders);
+                _writer.append(placeholder, result.ptr - placeholder);
+            } else {
+                _writer.append(&Dialect::placeholder, 1);
+            }
+
+            if (_binds != nullptr) {
+                _binds->emplace_back(chars, count);
+            }
+        }
+
+        inline std::size_t placeholders() const {
+            return _placeholders;
+        }
+    };
+
+    /**
+     * @brief: measures the storage and the number of fragments that a FragmentedQuery needs
+     */
+    template<typename Dialect>
+    class FragmentCounter {
+        std::size_t _stored{0};     //the number of characters that are written into storage
+        std::size_t _fragments{0};      //the greatest number of fragments that the query can be made of
+
+    public:
+        /**
+         * @brief: counts the passed characters as stored; they are copied, since they may not outlive the query
+         * @param count: the number of characters being counted
+         */
+        inline void append(const char *, const std::size_t &count) {
+            _stored += count;
+            ++_fragments;
+        }
+
+        inline void append(const std::string &chars) {
+            append(chars.data(), chars.size());
+        }
+
+        /**
+         * @brief: counts the passed keyword-literal as a fragment; it is pointed at in static storage
+         */
+        template<std::size_t N>
+        inline void append(const char (&)[N]) {
+            ++_fragments;
+        }
+
+        /**
+         * @brief: counts the passed value as three fragments, if it needs no escaping, or as stored, if it does
+         */
+        inline void appendValue(const char *chars, const std::size_t &count) {
+            const std::size_t length = Dialect::literalLength(chars, count);
+            if (length == count) {
+                _fragments += 3;
+            } else {
+                _stored += length + 2;
+                ++_fragments;
+            }
+        }
+
+        inline void appendIdentifier(const char *chars, const std::size_t &count) {
+            _stored += Dialect::identifierLength(chars, count) + 2;
+            ++_fragments;
+        }
+
+        inline void appendIdentifier(const std::string &chars) {
+            appendIdentifier(chars.data(), chars.size());
+        }
+
+        inline std::size_t stored() const {
+            return _stored;
+        }
+
+        inline std::size_t fragments() const {
+            return _fragments;
+        }
+    };
+
+    /**
+     * @brief: writes a query as fragments, into a FragmentedQuery whose storage has already been sized for it
+     */
+    template<typename Dialect>
+    class FragmentWriter {
+        using Fragment = DBQueryBuilder::Builder::FragmentedQuery::Fragment;
+
+        std::vector<Fragment> &_fragments;      //the fragments of the query
+        char *_storage;     //the beginning of the storage
+        char *_cursor;      //the position, within the storage, of the next character to be stored
+        std::size_t _length{0};     //the length of the text of the query written so far
+
+        /**
+         * @brief: appends the passed characters, outside of the storage, as a fragment, or extends the last fragment if
+         * they follow it in memory
+         */
+        inline void refer(const char *chars, const std::size_t &count) {
+            if (count == 0) {
+                return;
+            }
+
+            _length += count;
+            if (!_fragments.empty() && _fragments.back().chars != nullptr &&
+                _fragments.back().chars + _fragments.back().count == chars) {
+                _fragments.back().count += count;
+            } else {
+                _fragments.push_back({chars, 0, count});
+            }
+        }
+
+        /**
+         * @brief: appends the characters of the storage from the passed one to the cursor as a fragment, or extends the
+         * last fragment if they follow it in the storage
+         */
+        inline void referStored(const char *begin) {
+            const auto offset = static_cast<std::size_t>(begin - _storage);
+            const auto count = static_cast<std::size_t>(_cursor - begin);
+            if (count == 0) {
+                return;
+            }
+
+            _length += count;
+            if (!_fragments.empty() && _fragments.back().chars == nullptr &&
+                _fragments.back().offset + _fragments.back().count == offset) {
+                _fragments.back().count += count;
+            } else {
+                _fragments.push_back({nullptr, offset, count});
+            }
+        }
+
+    public:
+        /**
+         * @param fragments: receives the fragments of the query
+         * @param storage: the storage of the FragmentedQuery; it must be large enough to hold everything stored into it
+         */
+        inline FragmentWriter(std::vector<Fragment> &fragments, char *storage) : _fragments(fragments),
+                                                                                  _storage(storage), _cursor(storage) {}
+
+        /**
+         * @brief: stores the passed characters, then refers to them
+         * @param chars: the characters being written
+         * @param count: the number of characters being written
+         */
+        inline void append(const char *chars, const std::size_t &count) {
+            char *begin = _cursor;
+            std::memcpy(_cursor, chars, count);
+            _cursor += count;
+            referStored(begin);
+        }
+
+        inline void append(const std::string &chars) {
+            append(chars.data(), chars.size());
+        }
+
+        /**
+         * @brief: refers to the passed keyword-literal where it is, in static storage
+         */
+        template<std::size_t N>
+        inline void append(const char (&literal)[N]) {
+            refer(literal, N - 1);
+        }
+
+        /**
+         * @brief: refers to the passed value between quotes, if it needs no escaping; stores it escaped and quoted otherwise
+         */
+        inline void appendValue(const char *chars, const std::size_t &count) {
+            const std::size_t length = Dialect::literalLength(chars, count);
+            if (length == count) {
+                refer("'", 1);
+                refer(chars, count);
+                refer("'", 1);
+                return;
+            }
+
+            char *begin = _cursor;
+            *_cursor++ = '\'';
+            _cursor = Dialect::escapeLiteral(chars, count, _cursor);
+            *_cursor++ = '\'';
+            referStored(begin);
+        }
+
+        /**
+         * @brief: stores the passed name, escaped and quoted by the quote of the dialect, then refers to it
+         */
+        inline void appendIdentifier(const char *chars, const std::size_t &count) {
+            char *begin = _cursor;
+            *_cursor++ = Dialect::quote;
+            _cursor = Dialect::escapeIdentifier(chars, count, _cursor);
+            *_cursor++ = Dialect::quote;
+            referStored(begin);
+        }
+
+        inline void appendIdentifier(const std::string &chars) {
+            appendIdentifier(chars.data(), chars.size());
+        }
+
+        inline std::size_t length() const {
+            return _length;
+        }
+    };
+
+    /**
+     * @brief: keeps the guard-conditions of the query being built as nodes, until the query is built
+     */
+    template<typename Dialect>
+    class ConditionArena {
+    public:
+        using QueryCondition = DBQueryBuilder::Type::QueryCondition;
+        using ConditionTree = DBQueryBuilder::Type::ConditionTree;
+
+    private:
+        ConditionTree _tree;        //every guard-condition added so far, in pre-order
+        std::vector<std::uint32_t> _ends;       //scratch-stack of the ends of the groups being written
+
+        /**
+         * @brief: writes the conjunction and the opening of the passed node into the passed writer
+         * @return bool: true, if the passed node is composite, and so still expects its components and closing parenthesis
+         */
+        template<typename Writer>
+        inline bool writeOpening(Writer &writer, const ConditionTree::Node &node, const bool &addConj) const {
+            if (node.composite) {       //the node is composite
+                if (addConj) {      //the conjunction of the first component should be added
+                    writer.append(strConj(node.conjunction));
+                    writer.append(" (");
+                } else {
+                    writer.append("(");
+                }
+
+                return true;
+            }
+
+            if (addConj) {      //the conjunction should be added
+                writer.append(strConj(node.conjunction));
+            }
+            writer.append(" ");
+
+            if (node.negate) {      //the operation is negated
+                writer.append("not ");
+            }
+
+            //append the concerned field
+            std::string_view field = _tree.field(node);
+            writer.appendIdentifier(field.data(), field.size());
+
+            //append the operator and the value of the field
+            writer.append(strOperator(node._operator));
+            std::string_view value = _tree.value(node);
+            writer.appendValue(value.data(), value.size());
+
+            return false;
+        }
+
+    public:
+        /**
+         * @brief: returns the string form of the passed conjunction
+         */
+        static inline const std::string &strConj(const QueryCondition::Conjunction &conjunction) {
+            static const std::string conjunctions[] = {"and", "or"};
+            return conjunctions[conjunction];
+        }
+
+        /**
+         * @brief: returns the string form of the passed operator
+         */
+        static inline const std::string &strOperator(const QueryCondition::Operator &_operator) {
+            static const std::string operators[] = {"=", "<", ">", "<=", ">="};
+            return operators[_operator];
+        }
+
+        inline bool empty() const {
+            return _tree.empty();
+        }
+
+        /**
+         * @brief: discards all the conditions added so far, keeping the memory acquired for them
+         */
+        inline void clear() {
+            _tree.clear();
+        }
+
+        /**
+         * @brief: acquires the memory for the passed number of guard-conditions, whose field-names and values add up to
+         * the passed length
+         */
+        inline void reserve(const std::size_t &conditions, const std::size_t &textLength) {
+            _tree.reserve(conditions, textLength);
+        }
+
+        inline void reserveAs(const ConditionArena<Dialect> &other) {
+            _tree.reserveAs(other._tree);
+            _ends.reserve(other._ends.capacity());
+        }
+
+        /**
+         * @brief: returns the number of bytes of the memory acquired by this arena
+         */
+        inline std::size_t capacity() const {
+            return _tree.capacity() + _ends.capacity() * sizeof(std::uint32_t);
+        }
+
+        /**
+         * @brief: adds the structure of the passed QueryCondition, and of all of its components, to this arena
+         * @throws std::logic_error: if the conjunction or operator of any of the QueryConditions is unknown
+         * @param qCondition
+         */
+        inline void add(const QueryCondition &qCondition) {
+            _tree.add(qCondition);
+        }
+
+        /**
+         * @brief: adds all the guard-conditions of the passed ConditionTree to this arena
+         * @throws std::logic_error: if the passed ConditionTree has an open group
+         * @param conditions
+         */
+        inline void add(const ConditionTree &conditions) {
+            _tree.append(conditions);
+        }
+
+        /**
+         * @brief: writes the "where"-clause formed from all the conditions added so far; nothing, if none was added
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the "where"-clause
+         * @param introduce: false, to write the conditions without the "where" that introduces them
+         */
+        template<typename Writer>
+        inline void write(Writer &writer, const bool &introduce = true) {
+            const auto &nodes = _tree.nodes();
+            bool first = true;      //true, for the first condition of the "where"-clause or of a group
+
+            //the nodes are in pre-order, so they are written in sequence; a group is closed once its last node is written
+            for (std::uint32_t i = 0; i < nodes.size(); ++i) {
+                while (!_ends.empty() && _ends.back() == i) {
+                    writer.append(")");
+                    _ends.pop_back();
+                }
+
+                //the first condition is introduced by "where", every other one by its conjunction
+                if (!first) {
+                    writer.append(" ");
+                } else if (_ends.empty() && introduce) {
+                    writer.append("where ");
+                }
+
+                first = writeOpening(writer, nodes[i], !first);
+                if (first) {        //the components of the group follow
+                    _ends.push_back(nodes[i].end);
+                }
+            }
+
+            for (; !_ends.empty(); _ends.pop_back()) {
+                writer.append(")");
+            }
+        }
+    };
+
+    /**
+     * @brief: digests the shape of a query, and collects its values, for the lookup of cached QueryTemplates
+     */
+    template<typename Dialect>
+    class HashWriter {
+        static constexpr std::uint64_t _slotMarker = 0xA5A5A5A5A5A5A5A5ull;     //mixed in, in the place of every value
+
+        std::uint64_t _hash{Dialect::seed};     //seeded with the dialect, as templates are shared process-wide
+        std::uint64_t _check{0};
+        std::vector<std::string_view> &_values;     //receives the values, in order of appearance
+
+        /**
+         * @brief: mixes the passed word into both digests
+         */
+        inline void mix(const std::uint64_t &word) {
+            _hash = (_hash ^ word) * 0x9E3779B97F4A7C15ull;
+            _hash ^= _hash >> 32u;
+            _check = (_check + word) * 0xC2B2AE3D27D4EB4Full;
+            _check = (_check << 31u) | (_check >> 33u);
+        }
+
+    public:
+        inline explicit HashWriter(std::vector<std::string_view> &values) : _values(values) {}
+
+        /**
+         * @brief: mixes the passed characters into the digests, eight at a time
+         */
+        inline void append(const char *chars, const std::size_t &count) {
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                std::uint64_t word;
+                std::memcpy(&word, chars + i, 8);
+                mix(word);
+            }
+
+            if (i < count) {        //a partial word remains
+                std::uint64_t word = 0;
+                std::memcpy(&word, chars + i, count - i);
+                mix(word ^ (static_cast<std::uint64_t>(count - i) << 56u));
+            }
+        }
+
+        inline void append(const std::string &chars) {
+            append(chars.data(), chars.size());
+        }
+
+        template<std::size_t N>
+        inline void append(const char (&literal)[N]) {
+            append(literal, N - 1);
+        }
+
+        /**
+         * @brief: mixes the passed name into the digests, as a quoted identifier
+         */
+        inline void appendIdentifier(const char *chars, const std::size_t &count) {
+            append(&Dialect::quote, 1);
+            append(chars, count);
+            append(&Dialect::quote, 1);
+        }
+
+        inline void appendIdentifier(const std::string &chars) {
+            appendIdentifier(chars.data(), chars.size());
+        }
+
+        /**
+         * @brief: mixes a slot, instead of the passed value, into the digests, and keeps the value
+         */
+        inline void appendValue(const char *chars, const std::size_t &count) {
+            mix(_slotMarker);
+            _values.emplace_back(chars, count);
+        }
+
+        inline std::uint64_t hash() const {
+            return _hash;
+        }
+
+        inline std::uint64_t check() const {
+            return _check;
+        }
+    };
+
+    /**
+     * @brief: holds the Resource-representations of the query being built, as rows sharing one set of columns
+     */
+    template<typename Dialect>
+    class RowSet {
+        std::vector<std::string> _columns;      //the names of the columns shared by all rows, in ascending order
+        std::string _text;      //the pool that holds the values of all cells, row after row
+        std::vector<std::size_t> _cuts{0};      //cell i spans [_cuts[i], _cuts[i + 1]) of the pool
+        std::size_t _rows{0};       //the number of rows held
+        std::vector<std::uint32_t> _order;      //the rows, in the order they are rendered
+
+    public:
+        /**
+         * @brief: appends the passed Resource-representation as a row
+         * @throws std::logic_error: if the columns of the passed Resource-representation differ from those of the rows
+         * already held
+         * @param resourceRep
+         */
+        inline void add(const std::map<std::string, std::string> &resourceRep) {
+            if (_rows == 0) {       //the first row determines the columns
+                _columns.clear();
+                for (const auto &attr : resourceRep) {
+                    _columns.push_back(attr.first);
+                }
+            } else if (resourceRep.size() != _columns.size()) {      //the row has a different set of columns
+                throw std::logic_error(origin<Dialect>("RowSet::add") + "the columns of the Resource-representation differ from those of the previous ones");
+            }
+
+            std::size_t column = 0;
+            for (const auto &attr : resourceRep) {
+                if (attr.first != _columns[column++]) {       //the row has a different set of columns
+                    //discard the cells of the row added so far
+                    _cuts.resize(_rows * _columns.size() + 1);
+                    _text.resize(_cuts.back());
+
+                    throw std::logic_error(origin<Dialect>("RowSet::add") + "the columns of the Resource-representation differ from those of the previous ones");
+                }
+
+                _text += attr.second;
+                _cuts.push_back(_text.size());
+            }
+
+            _order.push_back(static_cast<std::uint32_t>(_rows++));
+        }
+
+        /**
+         * @brief: discards all rows, keeping the memory acquired for them
+         */
+        inline void clear() {
+            _columns.clear();
+            _text.clear();
+            _cuts.resize(1);
+            _order.clear();
+            _rows = 0;
+        }
+
+        /**
+         * @brief: confirms whether or not there is any value to be rendered
+         */
+        inline bool empty() const {
+            return _rows == 0 || _columns.empty();
+        }
+
+        /**
+         * @brief: acquires the memory for the passed number of rows of the passed number of columns, whose values add up
+         * to the passed length
+         */
+        inline void reserve(const std::size_t &rows, const std::size_t &columns, const std::size_t &textLength) {
+            _columns.reserve(columns);
+            _text.reserve(textLength);
+            _cuts.reserve(rows * columns + 1);
+            _order.reserve(rows);
+        }
+
+        inline void reserveAs(const RowSet<Dialect> &other) {
+            _columns.reserve(other._columns.capacity());
+            _text.reserve(other._text.capacity());
+            _cuts.reserve(other._cuts.capacity());
+            _order.reserve(other._order.capacity());
+        }
+
+        /**
+         * @brief: returns the number of bytes of the memory acquired by this RowSet
+         */
+        inline std::size_t capacity() const {
+            std::size_t bytes = _columns.capacity() * sizeof(std::string) + Diagnostics::heapCapacity(_text) +
+                                _cuts.capacity() * sizeof(std::size_t) + _order.capacity() * sizeof(std::uint32_t);
+            for (const std::string &column : _columns) {
+                bytes += Diagnostics::heapCapacity(column);
+            }
+
+            return bytes;
+        }
+
+        inline std::size_t rows() const {
+            return _rows;
+        }
+
+        inline const std::vector<std::string> &columns() const {
+            return _columns;
+        }
+
+        /**
+         * @brief: returns the value of the passed column, within the row rendered at the passed position
+         */
+        inline std::string_view cell(const std::size_t &position, const std::size_t &column) const {
+            std::size_t index = _order[position] * _columns.size() + column;
+            return std::string_view(_text.data() + _cuts[index], _cuts[index + 1] - _cuts[index]);
+        }
+
+        /**
+         * @brief: orders the rows by the values of the passed column, or in the order they were added if it is empty
+         * @throws std::logic_error: if the rows do not have the passed column
+         * @param column
+         */
+        inline void sortBy(const std::string &column) {
+            for (std::size_t i = 0; i < _rows; ++i) {
+                _order[i] = static_cast<std::uint32_t>(i);
+            }
+
+            if (column.empty() || _rows == 0) {
+                return;
+            }
+
+            auto found = std::find(_columns.begin(), _columns.end(), column);
+            if (found == _columns.end()) {      //the rows do not have the column
+                throw std::logic_error(origin<Dialect>("RowSet::sortBy") + "the Resource-representations have no column \"" + column + "\"");
+            }
+
+            const std::size_t key = found - _columns.begin();
+            std::stable_sort(_order.begin(), _order.begin() + _rows, [&](const std::uint32_t &a, const std::uint32_t &b) {
+                std::size_t first = a * _columns.size() + key, second = b * _columns.size() + key;
+                return std::string_view(_text.data() + _cuts[first], _cuts[first + 1] - _cuts[first]) <
+                       std::string_view(_text.data() + _cuts[second], _cuts[second + 1] - _cuts[second]);
+            });
+        }
+    };
+
+    /**
+     * @brief: creates the main-clauses of queries
+     */
+    template<typename Dialect>
+    class MainClauseCreator {
+    public:
+        /**
+         * @@brief: writes the main-clause for a "SELECT" query, using the passed parameters, into the passed writer
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the main-clause
+         * @param columns: the vector of the names of the concerned Columns
+         * @param tableName: the name of the database-table concerned
+         */
+        template<typename Writer>
+        inline void buildSelect(Writer &writer, const std::vector<std::string> &columns, const std::string &tableName) {
+            DBQueryBuilder::Diagnostics::LatencyTimer timer(DBQueryBuilder::Diagnostics::SELECT_CLAUSE);
+            if (tableName.empty()) {        //the passed table-name is empty
+                //report the error
+                throw std::logic_error(origin<Dialect>("Core::buildSelect") + "empty table-name");
+            }
+
+            //begin the construction of the main-clause
+            writer.append("select ");
+
+            //confirm that target-columns were passed
+            if (columns.empty()) {      //no column was passed
+                //construct query to select all available columns
+                writer.append("*");
+            } else {        //columns were passed
+                for (std::size_t i = 0; i < columns.size(); ++i) {
+                    //add the present column to the collection of columns to be select
+                    if (i == 0) {
+                        writer.append(" ");
+                    } else {
+                        writer.append(", ");
+                    }
+                    writer.appendIdentifier(columns[i]);
+                }
+            }
+
+            //add the table-name
+            writer.append(" from ");
+            writer.appendIdentifier(tableName);
+        }
+
+        /**
+         * @brief: writes the part of an "INSERT" query that precedes its rows into the passed writer
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the part
+         * @param conflict: the resolution of the conflicts of the rows with those already held by the table
+         * @param tableName: the name of the concerned table
+         * @param columns: the number of the concerned columns
+         * @param nameOf: returns the name of the column at the passed index
+         */
+        template<typename Writer, typename NameOf>
+        inline void buildInsertHead(Writer &writer, const Conflict &conflict, const std::string &tableName,
+                                    const std::size_t &columns, const NameOf &nameOf) {
+            //begin the construction of the main-clause
+            switch (conflict) {
+                case Conflict::REPLACE:
+                    writer.append("insert or replace into ");
+                    break;
+                case Conflict::IGNORE:
+                    writer.append("insert or ignore into ");
+                    break;
+                default:
+                    writer.append("insert into ");
+                    break;
+            }
+            writer.appendIdentifier(tableName);
+
+            //append the enumeration of the concerned columns to the query
+            writer.append("(");
+            for (std::size_t column = 0; column < columns; ++column) {
+                if (column != 0) {
+                    writer.append(", ");
+                }
+                writer.appendIdentifier(nameOf(column));
+            }
+            writer.append(") values");
+        }
+
+        /**
+         * @brief: writes the parenthesized values of the row rendered at the passed position into the passed writer
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the row
+         * @param rows: the rows of the query
+         * @param position: the position of the row
+         */
+        template<typename Writer>
+        inline void buildRow(Writer &writer, const RowSet<Dialect> &rows, const std::size_t &position) {
+            writer.append("(");
+            for (std::size_t column = 0; column < rows.columns().size(); ++column) {
+                if (column != 0) {
+                    writer.append(", ");
+                }
+
+                std::string_view value = rows.cell(position, column);
+                writer.appendValue(value.data(), value.size());
+            }
+            writer.append(")");
+        }
+
+        /**
+         * @brief: writes the main-clause for an "INSERT" query, using the passed parameters, into the passed writer
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the main-clause
+         * @param conflict: the resolution of the conflicts of the rows with those already held by the table
+         * @param tableName: the name of the concerned table
+         * @param rows: the new representations that should be pushed to the database
+         * @param begin: the position of the first row to be inserted
+         * @param end: the position after the last row to be inserted
+         */
+        template<typename Writer>
+        inline void buildInsert(Writer &writer, const Conflict &conflict, const std::string &tableName,
+                                const RowSet<Dialect> &rows, const std::size_t &begin, const std::size_t &end) {
+            DBQueryBuilder::Diagnostics::LatencyTimer timer(DBQueryBuilder::Diagnostics::INSERT_CLAUSE);
+
+            //confirm that the table-name is not empty
+            if (tableName.empty()) {        //the passed table-name is empty
+                throw std::logic_error(origin<Dialect>("Core::buildInsert") + "empty table-name");
+            } else if (rows.empty() || begin >= end) {       //there is no Resource-representation to insert
+                throw std::logic_error(origin<Dialect>("Core::buildInsert") + "empty Resource-representation");
+            }
+
+            buildInsertHead(writer, conflict, tableName, rows.columns().size(), [&](const std::size_t &column) -> const std::string & {
+                return rows.columns()[column];
+            });
+
+            //append the enumeration of values set for the columns, row after row
+            for (std::size_t position = begin; position < end; ++position) {
+                if (position != begin) {
+                    writer.append(", ");
+                }
+                buildRow(writer, rows, position);
+            }
+        }
+
+        /**
+         * @brief: writes the "on duplicate key update"-clause of an "UPSERT" query into the passed writer, preceded, in
+         * the row-alias syntax, by the alias of its rows
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the clause
+         * @param rows: the rows of the query
+         * @param upserts: the columns to be updated, in order, with their merge-expressions; every column of the rows,
+         * overwritten, if empty
+         * @param syntax: the way in which the clause refers to the values of the rows
+         */
+        template<typename Writer>
+        inline void buildDuplicateKeyUpdate(Writer &writer, const RowSet<Dialect> &rows, const std::vector<Upsert> &upserts,
+                                            const UpsertSyntax &syntax) {
+            const std::vector<std::string> &columns = rows.columns();
+
+            //confirm that every column to be updated has a value in the rows
+            for (const Upsert &upsert : upserts) {
+                if (std::find(columns.begin(), columns.end(), upsert.column) == columns.end()) {
+                    throw std::logic_error(origin<Dialect>("Core::buildDuplicateKeyUpdate") + "the upsert-column \"" + upsert.column +
+                                           "\" is not a column of the Resource-representations");
+                }
+            }
+
+            if (syntax == UpsertSyntax::ROW_ALIAS) {
+                writer.append("as ");
+                writer.appendIdentifier("new");
+                writer.append(" ");
+            }
+            writer.append("on duplicate key update ");
+
+            const std::size_t count = upserts.empty() ? columns.size() : upserts.size();
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::string &column = upserts.empty() ? columns[i] : upserts[i].column;
+                const Merge merge = upserts.empty() ? Merge::OVERWRITE : upserts[i].merge;
+                if (i != 0) {
+                    writer.append(", ");
+                }
+
+                writer.appendIdentifier(column);
+                writer.append(" = ");
+                switch (merge) {
+                    case Merge::ADD:
+                        writer.appendIdentifier(column);
+                        writer.append(" + ");
+                        break;
+                    case Merge::GREATEST:
+                        writer.append("greatest(");
+                        writer.appendIdentifier(column);
+                        writer.append(", ");
+                        break;
+                    default:
+                        break;
+                }
+
+                //refer to the value of the row
+                if (syntax == UpsertSyntax::ROW_ALIAS) {
+                    writer.appendIdentifier("new");
+                    writer.append(".");
+                    writer.appendIdentifier(column);
+                } else {
+                    writer.append("values(");
+                    writer.appendIdentifier(column);
+                    writer.append(")");
+                }
+
+                if (merge == Merge::GREATEST) {
+                    writer.append(")");
+                }
+            }
+        }
+
+        /**
+         * @brief: writes the value of the passed column, at the passed row, into the passed writer; strings are quoted,
+         * numbers are not
+         * @throws std::logic_error: if the value is a number that is not finite
+         */
+        template<typename Writer>
+        inline void buildColumnarCell(Writer &writer, const DBQueryBuilder::Type::ColumnBatch::Column &column,
+                                      const std::size_t &row) {
+            using ColumnBatch = DBQueryBuilder::Type::ColumnBatch;
+
+            if (column.nulls != nullptr && column.nulls[row]) {      //the value is NULL
+                writer.append("NULL");
+                return;
+            }
+
+            char digits[32];        //the textual form of a number
+            std::to_chars_result result{digits, std::errc()};
+            switch (column.kind) {
+                case ColumnBatch::Kind::STRING: {
+                    const std::string &value = static_cast<const std::string *>(column.values)[row];
+                    writer.appendValue(value.data(), value.size());
+                    return;
+                }
+                case ColumnBatch::Kind::STRING_VIEW: {
+                    const std::string_view &value = static_cast<const std::string_view *>(column.values)[row];
+                    writer.appendValue(value.data(), value.size());
+                    return;
+                }
+                case ColumnBatch::Kind::INT64:
+                    result = std::to_chars(digits, digits + sizeof(digits), static_cast<const std::int64_t *>(column.values)[row]);
+                    break;
+                case ColumnBatch::Kind::DOUBLE: {
+                    const double value = static_cast<const double *>(column.values)[row];
+                    if (!std::isfinite(value)) {        //the value has no SQL-form
+                        throw std::logic_error(origin<Dialect>("Core::buildColumnarInsert") + "the column \"" + column.name + "\" holds a number that is not finite");
+                    }
+
+                    result = std::to_chars(digits, digits + sizeof(digits), value);
+                    break;
+                }
+                default:        //the kind of the column is not recognized
+                    throw std::logic_error(origin<Dialect>("Core::buildColumnarInsert") + "the kind of the column \"" + column.name + "\" is unknown");
+            }
+
+            writer.append(digits, result.ptr - digits);
+        }
+
+        /**
+         * @brief: writes the parenthesized values of the passed row of the passed ColumnBatch into the passed writer
+         */
+        template<typename Writer>
+        inline void buildColumnarRow(Writer &writer, const DBQueryBuilder::Type::ColumnBatch &batch, const std::size_t &row) {
+            writer.append("(");
+            for (std::size_t column = 0; column < batch.columns().size(); ++column) {
+                if (column != 0) {
+                    writer.append(", ");
+                }
+                buildColumnarCell(writer, batch.columns()[column], row);
+            }
+            writer.append(")");
+        }
+
+        /**
+         * @brief: writes an "INSERT" query of the rows [begin, end) of the passed ColumnBatch into the passed writer
+         * @param writer: the LengthCounter or BufferWriter that receives the query
+         * @param tableName: the name of the concerned table
+         * @param batch: the Resource-representations that should be pushed to the database, column by column
+         * @param begin: the first row to be inserted
+         * @param end: the row after the last row to be inserted
+         */
+        template<typename Writer>
+        inline void buildColumnarInsert(Writer &writer, const std::string &tableName,
+                                        const DBQueryBuilder::Type::ColumnBatch &batch, const std::size_t &begin,
+                                        const std::size_t &end) {
+            DBQueryBuilder::Diagnostics::LatencyTimer timer(DBQueryBuilder::Diagnostics::INSERT_CLAUSE);
+            //confirm that the table-name is not empty
+            if (tableName.empty()) {        //the passed table-name is empty
+                throw std::logic_error(origin<Dialect>("Core::buildColumnarInsert") + "empty table-name");
+            } else if (batch.columns().empty() || begin >= end) {       //there is no Resource-representation to insert
+                throw std::logic_error(origin<Dialect>("Core::buildColumnarInsert") + "empty Resource-representation");
+            }
+
+            buildInsertHead(writer, Conflict::ABORT, tableName, batch.columns().size(), [&](const std::size_t &column) -> const std::string & {
+                return batch.columns()[column].name;
+            });
+
+            for (std::size_t row = begin; row < end; ++row) {
+                if (row != begin) {
+                    writer.append(", ");
+                }
+                buildColumnarRow(writer, batch, row);
+            }
+        }
+
+        /**
+         * @brief: writes the main-clause for an "UPDATE" query, using the passed parameters, into the passed writer
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the main-clause
+         * @param tableName: the name of the table being affected
+         * @param rows: the new representation that should be pushed to the database, as a single row
+         */
+        template<typename Writer>
+        inline void
+        buildUpdate(Writer &writer, const std::string &tableName, const RowSet<Dialect> &rows) {
+            DBQueryBuilder::Diagnostics::LatencyTimer timer(DBQueryBuilder::Diagnostics::UPDATE_CLAUSE);
+            //confirm that the table-name is not empty
+            if (tableName.empty()) {        //the passed table-name is empty
+                throw std::logic_error(origin<Dialect>("Core::buildUpdate") + "empty table-name");
+            } else if (rows.empty()) {       //the passed Resource-representation is empty
+                throw std::logic_error(origin<Dialect>("Core::buildUpdate") + "empty Resource-representation");
+            } else if (rows.rows() > 1) {       //more than one Resource-representation was added
+                throw std::logic_error(origin<Dialect>("Core::buildUpdate") + "an \"UPDATE\" query takes a single Resource-representation");
+            }
+
+            //begin the construction of the main-clause
+            writer.append("update ");
+            writer.appendIdentifier(tableName);
+            writer.append(" set");
+
+            for (std::size_t column = 0; column < rows.columns().size(); ++column) {
+                if (column != 0) {
+                    writer.append(", ");
+                }
+                writer.appendIdentifier(rows.columns()[column]);
+                writer.append("=");
+
+                std::string_view value = rows.cell(0, column);
+                writer.appendValue(value.data(), value.size());
+            }
+        }
+
+        /**
+         * @brief: writes the main-clause for a "DELETE" query, using the passed parameters, into the passed writer
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the main-clause
+         * @param tableName: the name of the table that is to be affected
+         */
+        template<typename Writer>
+        inline void buildDelete(Writer &writer, const std::string &tableName) {
+            DBQueryBuilder::Diagnostics::LatencyTimer timer(DBQueryBuilder::Diagnostics::DELETE_CLAUSE);
+
+            //confirm that the table-name is not empty
+            if (tableName.empty()) {        //the passed table-name is empty
+                throw std::logic_error(origin<Dialect>("Core::buildDelete") + "empty table-name");
+            }
+
+            //begin the main clause
+            writer.append("delete from ");
+            writer.appendIdentifier(tableName);
+        }
+    };
+
+    /**
+     * @brief: the implementer of the builders; the Core of each builder derives from the BuilderCore of its dialect
+     */
+    template<typename Dialect>
+    class BuilderCore {
+    public:
+        MainClauseCreator<Dialect> _mainClauseCreator;      //creates main-clause of query being built
+
+        DBQueryBuilder::Action _action{Action::NIL};     //the action of the query
+        Conflict _conflict{Conflict::ABORT};        //the resolution of the conflicts of the rows of an "INSERT" query
+        std::vector<Upsert> _upserts;       //the columns updated by an "UPSERT" query; every column of the rows, if empty
+        UpsertSyntax _upsertSyntax{UpsertSyntax::VALUES_FUNCTION};      //the way in which an "UPSERT" query refers to its rows
+        std::string _tableName;     //the name of the concerned table
+        std::vector<std::string> _columns;      //the vector of column-names the query being built is concerned with
+        RowSet<Dialect> _rows;        //the representations of the resources being pushed to the database
+        std::size_t _rowBegin{0}, _rowEnd{0};       //the positions of the rows rendered by the next "INSERT" query
+        std::string _batchOrder;        //the column by which rows are ordered; empty, to keep the order they were added in
+        std::size_t _maxBatchBytes{0};      //the maximum length of each "INSERT" query of a batch; zero, if unbounded
+        std::size_t _maxBatchRows{0};       //the maximum number of rows of each "INSERT" query of a batch; zero, if unbounded
+
+        std::vector<std::string_view> _values;      //the values of the query being built, in order of appearance, when templates are cached
+        ConditionArena<Dialect> _conditions;      //the guard-conditions of the query built so far, kept structurally until the query is built
+        std::string _orderClause{""};       //the "order"-clause of the query built so far
+        std::string _limitPhrase{""};        //the "limit"-phrase of the query built so far
+        std::vector<std::string> _keyColumns;       //the columns of the unique key that the query pages through; empty, if it does not
+        std::vector<std::string> _seekKey;       //the key of the row that the page follows; empty, for the first page
+        DBQueryBuilder::Order _keyOrder{Order::ASC};        //the order in which the query pages through the key
+        std::vector<std::string> _inColumns;        //the columns of the "in"-list of the query; empty, if it has none
+        std::vector<std::string> _inValues;     //the entries of the "in"-list, sorted and unique, the values of each adjacent
+        bool _inNegated{false};     //true, if the "in"-list is a "not in"-list
+        std::size_t _maxInEntries{0};       //the maximum number of entries of the "in"-list of each query; zero, if unbounded
+        std::size_t _inBegin{0}, _inEnd{0};     //the positions of the entries rendered by the next query
+
+        DBQueryBuilder::Diagnostics::AllocationCounter _allocations;       //the heap-usage of the calls of the builder
+
+    public:
+        /**
+         * @brief: calls the passed operation, accounting its heap-usage, and the capacity held after it, to _allocations
+         * @return: whatever the operation returns
+         */
+        template<typename Operation>
+        inline auto instrumented(const Operation &operation) {
+            struct Retainer {       //records the capacity held, even if the operation throws
+                BuilderCore &core;
+
+                inline ~Retainer() {
+                    core._allocations.retain([this]() { return core.capacity(); });
+                }
+            } retainer{*this};
+            DBQueryBuilder::Diagnostics::AllocationScope scope(_allocations);
+
+            return operation();
+        }
+
+        /**
+         * @brief: completes this copy of the passed BuilderCore, so that it has acquired at least as much memory as the
+         * passed one has; the copy accounts its heap-usage afresh
+         * @param other: the BuilderCore that this one was copied from
+         */
+        inline void reserveAs(const BuilderCore &other) {
+            _values.clear();      //they point into the passed BuilderCore
+            _allocations.reset();
+
+            //a copied string or vector acquires only the memory its content needs
+            _tableName.reserve(other._tableName.capacity());
+            _columns.reserve(other._columns.capacity());
+            _upserts.reserve(other._upserts.capacity());
+            _rows.reserveAs(other._rows);
+            _batchOrder.reserve(other._batchOrder.capacity());
+            _values.reserve(other._values.capacity());
+            _conditions.reserveAs(other._conditions);
+            _orderClause.reserve(other._orderClause.capacity());
+            _limitPhrase.reserve(other._limitPhrase.capacity());
+            _keyColumns.reserve(other._keyColumns.capacity());
+            _seekKey.reserve(other._seekKey.capacity());
+            _inColumns.reserve(other._inColumns.capacity());
+            _inValues.reserve(other._inValues.capacity());
+        }
+
+        /**
+         * @brief: makes the passed core hold the query of the passed prototype, as a copy of it would; the strings and
+         * vectors assigned keep the memory they have acquired, and the core keeps accounting its own heap-usage
+         * @param core: the core of a builder, of a class derived from BuilderCore
+         * @param prototype: the core of the builder whose query is copied
+         */
+        template<typename Core>
+        static inline int restore(Core &core, const Core &prototype) {
+            const DBQueryBuilder::Diagnostics::AllocationCounter allocations = core._allocations;
+            core = prototype;
+            core._values.clear();       //they point into the prototype
+            core._allocations = allocations;
+
+            return 0;
+        }
+
+        inline int reserve(const std::size_t &columns, const std::size_t &rows, const std::size_t &conditions,
+                           const std::size_t &textLength) {
+            _columns.reserve(columns);
+            _rows.reserve(rows, columns, textLength);
+            _values.reserve(rows * columns + conditions);
+            _conditions.reserve(conditions, textLength);
+
+            return 0;
+        }
+
+        /**
+         * @brief: returns the number of bytes of the memory held by this builder
+         */
+        inline std::size_t capacity() const {
+            std::size_t bytes = DBQueryBuilder::Diagnostics::heapCapacity(_tableName) +
+                                _columns.capacity() * sizeof(std::string) + _upserts.capacity() * sizeof(Upsert) +
+                                _rows.capacity() +
+                                DBQueryBuilder::Diagnostics::heapCapacity(_batchOrder) +
+                                _values.capacity() * sizeof(std::string_view) + _conditions.capacity() +
+                                DBQueryBuilder::Diagnostics::heapCapacity(_orderClause) +
+                                DBQueryBuilder::Diagnostics::heapCapacity(_limitPhrase) +
+                                (_keyColumns.capacity() + _seekKey.capacity()) * sizeof(std::string) +
+                                (_inColumns.capacity() + _inValues.capacity()) * sizeof(std::string);
+            for (const std::string &column : _columns) {
+                bytes += DBQueryBuilder::Diagnostics::heapCapacity(column);
+            }
+            for (const std::string &column : _keyColumns) {
+                bytes += DBQueryBuilder::Diagnostics::heapCapacity(column);
+            }
+            for (const std::string &value : _seekKey) {
+                bytes += DBQueryBuilder::Diagnostics::heapCapacity(value);
+            }
+            for (const Upsert &upsert : _upserts) {
+                bytes += DBQueryBuilder::Diagnostics::heapCapacity(upsert.column);
+            }
+            for (const std::string &column : _inColumns) {
+                bytes += DBQueryBuilder::Diagnostics::heapCapacity(column);
+            }
+            for (const std::string &value : _inValues) {
+                bytes += DBQueryBuilder::Diagnostics::heapCapacity(value);
+            }
+
+            return bytes;
+        }
+
+        inline int setTableName(const std::string &tableName) {
+            //cache the table Name
+            _tableName = tableName;
+            return 0;
+        }
+
+        inline int setAction(const Action &action) {
+            //cache the action; the QueryDescriptor describes it without any state of its own
+            _action = action;
+
+            return 0;
+        }
+
+        inline int setTargetColumns(const std::vector<std::string> &columns) {
+            //cache the target-columns
+            _columns = columns;
+
+            return 0;
+        }
+
+
+        inline int addCondition(const DBQueryBuilder::Type::QueryCondition::Ptr &qCondition) {
+            //keep the structure of the condition; it is rendered when the query is built
+            _conditions.add(*qCondition);
+
+            return 0;
+        }
+
+        inline int addConditions(const DBQueryBuilder::Type::ConditionTree &conditions) {
+            _conditions.add(conditions);
+
+            return 0;
+        }
+
+        inline int addCompositeCondition(const std::vector<DBQueryBuilder::Type::QueryCondition::Ptr> qConditions) {
+            //the composite condition is kept as a node, with the passed conditions as its components
+            DBQueryBuilder::Type::CompQueryCondition qCondition(qConditions);
+            _conditions.add(qCondition);
+
+            return 0;
+        }
+
+        inline int addResourceRep(const std::map<std::string, std::string> &resourceRep) {
+            //the Resource-representation replaces all previous ones
+            _rows.clear();
+            _rows.add(resourceRep);
+
+            return 0;
+        }
+
+        inline int addRow(const std::map<std::string, std::string> &resourceRep) {
+            //the Resource-representation is appended to the previous ones
+            _rows.add(resourceRep);
+
+            return 0;
+        }
+
+        inline int setBatchLimits(const std::size_t &maxBytes, const std::size_t &maxRows) {
+            _maxBatchBytes = maxBytes;
+            _maxBatchRows = maxRows;
+
+            return 0;
+        }
+
+        inline int setBatchOrder(const std::string &columnName) {
+            _batchOrder = columnName;
+
+            return 0;
+        }
+
+        inline int setLimit(const int &limit) {
+            //create the "limit"-phrase of the query being built
+            _limitPhrase = "limit ";
+            _limitPhrase += std::to_string(limit);
+
+            return 0;
+        }
+
+        inline int setOrder(const std::string &columnName, const Order &order) {
+            //create the "order by" clause of the query being built
+            _orderClause = "order by ";
+            renderInto(_orderClause, [&](auto &writer) { writer.appendIdentifier(columnName); });
+            _orderClause += " ";
+
+            //set the proper ordering for the clause
+            switch (order) {
+                case Order::ASC:
+                    _orderClause += "asc";
+                    break;
+                case Order::DEC:
+                    _orderClause += "desc";
+                    break;
+                default:        //the passed order is not known
+                    break;
+            }
+
+            return 0;
+        }
+
+        inline int setKeyset(const std::vector<std::string> &keyColumns, const int &pageSize, const Order &order) {
+            if (keyColumns.empty()) {       //there is no key to page through
+                throw std::logic_error(origin<Dialect>("Core::setKeyset") + "the key has no column");
+            } else if (std::find(keyColumns.begin(), keyColumns.end(), std::string()) != keyColumns.end()) {
+                throw std::logic_error(origin<Dialect>("Core::setKeyset") + "empty key-column");
+            } else if (pageSize <= 0) {     //no page could hold a row
+                throw std::logic_error(origin<Dialect>("Core::setKeyset") + "the size of a page must be positive");
+            } else if (order != Order::ASC && order != Order::DEC) {     //the passed order is not known
+                throw std::logic_error(origin<Dialect>("Core::setKeyset") + "the order is unknown");
+            }
+
+            _keyColumns = keyColumns;
+            _keyOrder = order;
+            _seekKey.clear();
+
+            //the pages are ordered by every column of the key, in the same direction
+            _orderClause = "order by ";
+            for (std::size_t column = 0; column < _keyColumns.size(); ++column) {
+                if (column != 0) {
+                    _orderClause += ", ";
+                }
+                renderInto(_orderClause, [&](auto &writer) { writer.appendIdentifier(_keyColumns[column]); });
+                _orderClause += order == Order::ASC ? " asc" : " desc";
+            }
+            setLimit(pageSize);
+
+            return 0;
+        }
+
+        inline int seekAfter(const std::vector<std::string> &lastKey) {
+            if (_keyColumns.empty()) {      //there is no key to page through
+                throw std::logic_error(origin<Dialect>("Core::seekAfter") + "call to Builder::" + Dialect::builder +
+                                       "::Core::setKeyset(...) must be made before a page can be sought");
+            } else if (!lastKey.empty() && lastKey.size() != _keyColumns.size()) {      //the key is not whole
+                throw std::logic_error(origin<Dialect>("Core::seekAfter") + "the key has " +
+                                       std::to_string(_keyColumns.size()) + " columns, but " +
+                                       std::to_string(lastKey.size()) + " values were passed");
+            }
+
+            _seekKey = lastKey;
+
+            return 0;
+        }
+
+        /**
+         * @brief: confirms whether or not the passed value is an integer written as a number is, without a sign unless it
+         * is negative, and without leading zeros
+         */
+        static inline bool isInteger(const std::string &value) {
+            const std::size_t first = !value.empty() && value[0] == '-' ? 1 : 0;
+            if (first == value.size() || (value[first] == '0' && value.size() != 1)) {     //"", "-", "-0" or "007"
+                return false;
+            }
+
+            return std::all_of(value.begin() + first, value.end(), [](const char &c) { return c >= '0' && c <= '9'; });
+        }
+
+        /**
+         * @brief: compares the passed integers, as isInteger(...) confirms them, by their values
+         */
+        static inline bool integerLess(const std::string &a, const std::string &b) {
+            const bool negative = a[0] == '-';
+            if (negative != (b[0] == '-')) {
+                return negative;
+            } else if (a.size() != b.size()) {      //the longer magnitude is the greater
+                return negative ? a.size() > b.size() : a.size() < b.size();
+            }
+
+            return negative ? b < a : a < b;
+        }
+
+        /**
+         * @brief: sets the "in"-list of the query, whose entries are the values of the passed columns, the values of
+         * each entry adjacent; the entries are sorted, by value in a column that only holds integers, and byte-wise in
+         * any other, and duplicates are dropped
+         * @param columns: the columns of the list, most significant first
+         * @param values: the values of every entry, in order; the number of columns of them per entry
+         * @param negate: true, for a "not in"-list
+         */
+        inline int setInList(const std::vector<std::string> &columns, const std::vector<std::string> &values,
+                             const bool &negate) {
+            if (columns.empty()) {      //there is nothing to compare the entries with
+                throw std::logic_error(origin<Dialect>("Core::setInList") + "the list has no column");
+            } else if (std::find(columns.begin(), columns.end(), std::string()) != columns.end()) {
+                throw std::logic_error(origin<Dialect>("Core::setInList") + "empty list-column");
+            } else if (values.empty()) {        //"in ()" is no query
+                throw std::logic_error(origin<Dialect>("Core::setInList") + "the list has no entry");
+            } else if (values.size() % columns.size() != 0) {       //the last entry is not whole
+                throw std::logic_error(origin<Dialect>("Core::setInList") + "the list has " +
+                                       std::to_string(columns.size()) + " columns, but " +
+                                       std::to_string(values.size()) + " values were passed");
+            }
+
+            //a column is compared by value only if all of its values are integers, so that the order is total
+            const std::size_t arity = columns.size(), entries = values.size() / arity;
+            std::vector<bool> integers(arity, true);
+            for (std::size_t value = 0; value < values.size(); ++value) {
+                if (integers[value % arity] && !isInteger(values[value])) {
+                    integers[value % arity] = false;
+                }
+            }
+
+            std::vector<std::size_t> order(entries);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](const std::size_t &a, const std::size_t &b) {
+                for (std::size_t column = 0; column < arity; ++column) {
+                    const std::string &x = values[a * arity + column], &y = values[b * arity + column];
+                    if (x != y) {
+                        return integers[column] ? integerLess(x, y) : x < y;
+                    }
+                }
+
+                return false;
+            });
+
+            _inColumns = columns;
+            _inNegated = negate;
+            _inValues.clear();
+            _inValues.reserve(values.size());
+            for (std::size_t entry = 0; entry < entries; ++entry) {
+                //equal entries are adjacent, once sorted
+                if (entry != 0 && std::equal(values.begin() + order[entry] * arity,
+                                             values.begin() + (order[entry] + 1) * arity,
+                                             values.begin() + order[entry - 1] * arity)) {
+                    continue;
+                }
+                _inValues.insert(_inValues.end(), values.begin() + order[entry] * arity,
+                                 values.begin() + (order[entry] + 1) * arity);
+            }
+
+            return 0;
+        }
+
+        inline int setInList(const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &entries,
+                             const bool &negate) {
+            std::vector<std::string> values;        //the values of the entries, adjacent
+            values.reserve(entries.size() * columns.size());
+            for (const std::vector<std::string> &entry : entries) {
+                if (entry.size() != columns.size()) {       //the entry is not whole
+                    throw std::logic_error(origin<Dialect>("Core::setInList") + "the list has " +
+                                           std::to_string(columns.size()) + " columns, but an entry has " +
+                                           std::to_string(entry.size()) + " values");
+                }
+                values.insert(values.end(), entry.begin(), entry.end());
+            }
+
+            return setInList(columns, values, negate);
+        }
+
+        inline int setInListLimit(const std::size_t &maxEntries) {
+            _maxInEntries = maxEntries;
+
+            return 0;
+        }
+
+        /**
+         * @brief: returns the number of entries of the "in"-list
+         */
+        inline std::size_t inEntries() const {
+            return _inColumns.empty() ? 0 : _inValues.size() / _inColumns.size();
+        }
+
+        /**
+         * @brief: confirms whether or not the query is split into a query per part of its "in"-list; a "not in"-list is
+         * never split, as every query would select the rows that the others exclude
+         */
+        inline bool splitsInList() const {
+            return !_inColumns.empty() && !_inNegated && QueryDescriptor<Dialect>::setsWhere(_action);
+        }
+
+        /**
+         * @brief: rejects the split of the query by its "in"-list, if the query is limited, or is a page of a keyset:
+         * every query would be limited, or would be the page, alone, and all of them would return more rows than the
+         * limit, or the page, allows
+         * @throws std::logic_error: if the query has a "limit"-phrase or a sought key
+         */
+        inline void checkInListSplit(const char *function) const {
+            if ((QueryDescriptor<Dialect>::setsLimit(_action) && !_limitPhrase.empty()) || !_seekKey.empty()) {
+                throw std::logic_error(origin<Dialect>(function) + "a query with a \"limit\"-phrase, or a page of a "
+                                                                   "keyset, cannot be split by its \"in\"-list");
+            }
+        }
+
+        /**
+         * @brief: writes the comparison of a page with the row of _seekKey that it follows, e.g.
+         * "(`k1`, `k2`) > ('v1', 'v2')"
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the comparison
+         */
+        template<typename Writer>
+        inline void writeSeek(Writer &writer) {
+            //a single column is compared as it is; a composite key, as a row
+            const bool composite = _keyColumns.size() > 1;
+            if (composite) {
+                writer.append("(");
+            }
+            for (std::size_t column = 0; column < _keyColumns.size(); ++column) {
+                if (column != 0) {
+                    writer.append(", ");
+                }
+                writer.appendIdentifier(_keyColumns[column]);
+            }
+            writer.append(composite ? ") " : " ");
+            writer.append(_keyOrder == Order::ASC ? ">" : "<");
+            writer.append(composite ? " (" : " ");
+            for (std::size_t column = 0; column < _seekKey.size(); ++column) {
+                if (column != 0) {
+                    writer.append(", ");
+                }
+                writer.appendValue(_seekKey[column].data(), _seekKey[column].size());
+            }
+            if (composite) {
+                writer.append(")");
+            }
+        }
+
+        /**
+         * @brief: writes the entries [_inBegin, _inEnd) of the "in"-list, e.g. "(`a`, `b`) in (('1', 'x'), ('2', 'y'))"
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the list
+         */
+        template<typename Writer>
+        inline void writeInList(Writer &writer) {
+            //a single column is compared as it is; several, as a row
+            const std::size_t arity = _inColumns.size();
+            const bool composite = arity > 1;
+            if (composite) {
+                writer.append("(");
+            }
+            for (std::size_t column = 0; column < arity; ++column) {
+                if (column != 0) {
+                    writer.append(", ");
+                }
+                writer.appendIdentifier(_inColumns[column]);
+            }
+            if (composite) {
+                writer.append(")");
+            }
+            if (_inNegated) {
+                writer.append(" not in (");
+            } else {
+                writer.append(" in (");
+            }
+
+            for (std::size_t entry = _inBegin; entry < _inEnd; ++entry) {
+                if (entry != _inBegin) {
+                    writer.append(", ");
+                }
+                if (composite) {
+                    writer.append("(");
+                }
+                for (std::size_t column = 0; column < arity; ++column) {
+                    if (column != 0) {
+                        writer.append(", ");
+                    }
+                    const std::string &value = _inValues[entry * arity + column];
+                    writer.appendValue(value.data(), value.size());
+                }
+                if (composite) {
+                    writer.append(")");
+                }
+            }
+            writer.append(")");
+        }
+
+        /**
+         * @brief: writes the "where"-clause formed from the guard-conditions, in conjunction with the comparison of a
+         * page with the row it follows and with the "in"-list, if the query has them, e.g.
+         * "where ( `a`='1') and `id` in ('1', '2')"; nothing, if the query has none of them
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the "where"-clause
+         */
+        template<typename Writer>
+        inline void writeWhere(Writer &writer) {
+            const bool seeks = !_seekKey.empty(), lists = !_inColumns.empty();
+            if (!seeks && !lists) {
+                _conditions.write(writer);
+                return;
+            }
+
+            //the guard-conditions are parenthesized, so that a disjunction among them does not escape the predicates
+            //that follow
+            if (_conditions.empty()) {
+                writer.append("where ");
+            } else {
+                writer.append("where (");
+                _conditions.write(writer, false);
+                writer.append(") and ");
+            }
+
+            if (seeks) {
+                writeSeek(writer);
+                if (lists) {
+                    writer.append(" and ");
+                }
+            }
+            if (lists) {
+                writeInList(writer);
+            }
+        }
+
+        /**
+         * @brief: writes the query that has been built thus far into the passed writer
+         * @param writer: the LengthCounter, BufferWriter or PlaceholderWriter that receives the query
+         */
+        template<typename Writer>
+        inline void writeQuery(Writer &writer) {
+            //confirm that the action has been set
+            if (_action == Action::NIL) {       //The action has not been set
+                //report the error
+                throw std::logic_error(origin<Dialect>("Core::buildQuery") + "call to Builder::" + Dialect::builder + "::Core::setAction(const Action &) must be made before query can be built");
+            }
+
+            //write the main-clause of the query; an action that passes this switch is known to the QueryDescriptor
+            switch (_action) {
+                case Action::INSERT:
+                    _mainClauseCreator.buildInsert(writer, _conflict, _tableName, _rows, _rowBegin, _rowEnd);
+                    break;
+                case Action::SELECT:
+                    _mainClauseCreator.buildSelect(writer, _columns, _tableName);
+                    break;
+                case Action::UPDATE:
+                    _mainClauseCreator.buildUpdate(writer, _tableName, _rows);
+                    break;
+                case Action::DELETE:
+                    _mainClauseCreator.buildDelete(writer, _tableName);
+                    break;
+                case Action::UPSERT:
+                    if (!QueryDescriptor<Dialect>::setsDuplicateKeyUpdate(Action::UPSERT)) {       //the dialect has no upsert
+                        throw std::logic_error(origin<Dialect>("Core::buildQuery") + "the dialect has no \"UPSERT\" query");
+                    }
+                    _mainClauseCreator.buildInsert(writer, Conflict::ABORT, _tableName, _rows, _rowBegin, _rowEnd);
+                    break;
+                default:        //_action is not accounted for
+                    //report the error
+                    throw std::logic_error(origin<Dialect>("Core::buildQuery") + "the action of the query is not accounted for");
+            }
+
+            //confirm whether or not the query may expect an "on duplicate key update"-clause
+            if (QueryDescriptor<Dialect>::setsDuplicateKeyUpdate(_action)) {
+                writer.append(" ");       //space for next subordinate
+                _mainClauseCreator.buildDuplicateKeyUpdate(writer, _rows, _upserts, _upsertSyntax);
+            }
+
+            //confirm whether or not the query may expect a "where"-clause
+            if (QueryDescriptor<Dialect>::setsWhere(_action)) {     //a "where"-cause may be set
+                DBQueryBuilder::Diagnostics::LatencyTimer timer(DBQueryBuilder::Diagnostics::WHERE_CLAUSE);
+                writer.append(" ");       //space for next subordinate
+                writeWhere(writer);
+            }
+
+            //confirm whether or not the query may expect an "order"-clause
+            if (QueryDescriptor<Dialect>::setsOrder(_action)) {        //an "order"-clause may be set
+                DBQueryBuilder::Diagnostics::LatencyTimer timer(DBQueryBuilder::Diagnostics::ORDER_CLAUSE);
+                writer.append(" ");       //space for next subordinate
+                writer.append(_orderClause);
+            }
+
+            //confirm whether or not the query may expect a "limit"-phrase
+            if (QueryDescriptor<Dialect>::setsLimit(_action)) {     //a "limit-phrase may be set"
+                DBQueryBuilder::Diagnostics::LatencyTimer timer(DBQueryBuilder::Diagnostics::LIMIT_PHRASE);
+                writer.append(" ");       //space for the next subordinate
+                writer.append(_limitPhrase);
+            }
+        }
+
+        /**
+         * @brief: returns the cached QueryTemplate of the shape of the query being built, creating and caching it if the
+         * shape has not been cached; the values of the query are collected into _values
+         * @return Type::QueryTemplate::Ptr: the QueryTemplate, or nullptr if QueryTemplates are not being cached, or the
+         * dialect does not render them
+         */
+        inline DBQueryBuilder::Type::QueryTemplate::Ptr cachedTemplate() {
+            if constexpr (!Dialect::cachesTemplates) {      //a QueryTemplate renders MYSQL-literals
+                return nullptr;
+            }
+
+            auto &cache = DBQueryBuilder::Type::TemplateCache::instance();
+            if (!cache.enabled()) {
+                return nullptr;
+            }
+
+            //digest the shape of the query, without rendering it; a hit costs this walk of every clause too
+            _values.clear();
+            HashWriter<Dialect> hasher(_values);
+            writeQuery(hasher);
+
+            auto qTemplate = cache.find(hasher.hash(), hasher.check());
+            if (qTemplate == nullptr) {     //the shape has not been cached
+                auto created = std::make_shared<DBQueryBuilder::Type::QueryTemplate>();
+                writeQuery(*created);
+                cache.insert(hasher.hash(), hasher.check(), created);
+
+                qTemplate = created;
+            }
+
+            return qTemplate;
+        }
+
+        /**
+         * @brief: measures, then writes, whatever the passed render-function writes, after the content of the passed buffer
+         * @param render: a function that writes into any writer it is passed
+         * @return std::size_t: the number of characters appended
+         */
+        template<typename Render>
+        static inline std::size_t renderInto(std::string &buffer, const Render &render) {
+            //measure the query, so that the buffer is grown at most once
+            LengthCounter<Dialect> counter;
+            render(counter);
+
+            //write the query after whatever the buffer already holds
+            DBQueryBuilder::Diagnostics::StringWatch watch(buffer);
+            const std::size_t offset = buffer.size();
+            buffer.resize(offset + counter.length());
+            watch.observe();
+
+            BufferWriter<Dialect> writer(&buffer[offset]);
+            render(writer);
+
+            return counter.length();
+        }
+
+        /**
+         * @brief: orders the rows of the query, and selects all of them, and every entry of the "in"-list, for rendering
+         */
+        inline void selectAllRows() {
+            _rows.sortBy(_batchOrder);
+            _rowBegin = 0, _rowEnd = _rows.rows();
+            _inBegin = 0, _inEnd = inEntries();
+        }
+
+        inline DBQueryBuilder::Type::QueryTemplate::Ptr compile() {
+            DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+            selectAllRows();
+
+            //a cached QueryTemplate is already immutable, and so can be shared
+            if (auto qTemplate = cachedTemplate()) {
+                return qTemplate;
+            }
+
+            auto qTemplate = std::make_shared<DBQueryBuilder::Type::QueryTemplate>();
+            writeQuery(*qTemplate);
+
+            return qTemplate;
+        }
+
+        inline std::size_t buildQueryInto(std::string &buffer) {
+            DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+            selectAllRows();
+
+            if (auto qTemplate = cachedTemplate()) {        //only the values need to be spliced into the cached shape
+                return renderInto(buffer, [&](auto &writer) { qTemplate->write(writer, _values); });
+            }
+
+            return renderInto(buffer, [this](auto &writer) { writeQuery(writer); });
+        }
+
+        inline std::size_t buildQueryInto(char *buffer, const std::size_t &capacity) {
+            DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+            selectAllRows();
+
+            auto qTemplate = cachedTemplate();
+            auto render = [&](auto &writer) {
+                if (qTemplate != nullptr) {     //only the values need to be spliced into the cached shape
+                    qTemplate->write(writer, _values);
+                } else {
+                    writeQuery(writer);
+                }
+            };
+
+            //measure the query, so that nothing is written into a buffer that cannot hold it
+            LengthCounter<Dialect> counter;
+            render(counter);
+
+            if (counter.length() > capacity) {      //the buffer is too small for the query
+                //report the error
+                throw std::length_error(origin<Dialect>("Core::buildQueryInto") + "the buffer cannot hold the query");
+            }
+
+            BufferWriter<Dialect> writer(buffer);
+            render(writer);
+
+            return counter.length();
+        }
+
+        inline std::string buildQuery() {
+            std::string query;      //the query to be returned
+            buildQueryInto(query);
+
+            return query;
+        }
+
+        inline std::size_t buildParameterizedQueryInto(ParameterizedQuery &query) {
+            DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+            selectAllRows();
+
+            return parameterizeInto(query);
+        }
+
+        /**
+         * @brief: appends the query of the rows selected for rendering, with every value replaced by a placeholder, to
+         * the passed ParameterizedQuery
+         * @return std::size_t: the number of characters appended to the text
+         */
+        inline std::size_t parameterizeInto(ParameterizedQuery &query) {
+            //measure the query, and count its placeholders, so that the text and the binds are grown at most once
+            LengthCounter<Dialect> counter;
+            PlaceholderWriter<Dialect, LengthCounter<Dialect>> measurer(counter, nullptr);
+            writeQuery(measurer);
+
+            const std::size_t offset = query.sql.size();
+            query.sql.resize(offset + counter.length());
+            query.binds.reserve(query.binds.size() + measurer.placeholders());
+
+            BufferWriter<Dialect> writer(&query.sql[offset]);
+            PlaceholderWriter<Dialect, BufferWriter<Dialect>> placeholderWriter(writer, &query.binds);
+            writeQuery(placeholderWriter);
+
+            return counter.length();
+        }
+
+        inline std::size_t buildFragmentedQueryInto(FragmentedQuery &query) {
+            DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+            selectAllRows();
+
+            //measure the storage and the fragments, so that neither is grown while the fragments point into them
+            FragmentCounter<Dialect> counter;
+            writeQuery(counter);
+
+            query.fragments.clear();
+            query.fragments.reserve(counter.fragments());
+            query.storage.clear();
+            query.storage.resize(counter.stored());
+
+            //the query is not spliced into a cached QueryTemplate, which could be evicted while the fragments point into it
+            FragmentWriter<Dialect> writer(query.fragments, &query.storage[0]);
+            writeQuery(writer);
+
+            return writer.length();
+        }
+
+        inline FragmentedQuery buildFragmentedQuery() {
+            FragmentedQuery query;      //the query to be returned
+            buildFragmentedQueryInto(query);
+
+            return query;
+        }
+
+        /**
+         * @brief: splits the rows [0, rows) into batches that respect the batch-limits, filling each batch with as many
+         * rows as the limits allow
+         * @throws std::length_error: if a single row cannot fit the byte-limit
+         * @param fixedLength: the length of the part of the query that every batch repeats
+         * @param rows: the number of rows
+         * @param rowLength: returns the length of the row at the passed position
+         * @param emit: receives the positions [begin, end) of each batch, in order
+         */
+        template<typename RowLength, typename Emit>
+        inline void splitBatches(const std::size_t &fixedLength, const std::size_t &rows, const RowLength &rowLength,
+                                 const Emit &emit) {
+            std::size_t begin = 0, length = 0;
+            for (std::size_t position = 0; position < rows; ++position) {
+                const std::size_t rowLen = rowLength(position);
+                if (_maxBatchBytes != 0 && fixedLength + rowLen > _maxBatchBytes) {      //the row cannot fit any batch
+                    throw std::length_error(origin<Dialect>("Core::splitBatches") + "a Resource-representation exceeds the byte-limit of a batch");
+                }
+
+                if (position != begin) {
+                    const bool full = (_maxBatchBytes != 0 && length + 2 + rowLen > _maxBatchBytes) ||
+                                      (_maxBatchRows != 0 && position - begin == _maxBatchRows);
+
+                    if (!full) {
+                        length += 2 + rowLen;       //", " separates rows
+                        continue;
+                    }
+
+                    emit(begin, position);
+                    begin = position;
+                }
+
+                length = fixedLength + rowLen;
+            }
+            emit(begin, rows);
+        }
+
+        /**
+         * @brief: returns the length of the row rendered at the passed position
+         */
+        inline std::size_t rowLength(const std::size_t &position) {
+            LengthCounter<Dialect> counter;
+            _mainClauseCreator.buildRow(counter, _rows, position);
+
+            return counter.length();
+        }
+
+        /**
+         * @brief: renders the rows within [begin, end) as a single "INSERT" query, appended to the passed queries
+         */
+        inline void buildBatch(std::vector<std::string> &queries, const std::size_t &begin, const std::size_t &end) {
+            _rowBegin = begin, _rowEnd = end;
+            queries.emplace_back();
+            renderInto(queries.back(), [this](auto &writer) { writeQuery(writer); });
+        }
+
+        inline std::vector<std::string> buildQueries() {
+            DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+            std::vector<std::string> queries;       //the queries to be returned
+            selectAllRows();
+
+            //a query whose "in"-list exceeds its limit is split by entries
+            if (splitsInList() && _maxInEntries != 0 && inEntries() > _maxInEntries) {
+                checkInListSplit("Core::buildQueries");
+                for (std::size_t begin = 0; begin < inEntries(); begin += _maxInEntries) {
+                    _inBegin = begin, _inEnd = std::min(begin + _maxInEntries, inEntries());
+                    queries.emplace_back();
+                    renderInto(queries.back(), [this](auto &writer) { writeQuery(writer); });
+                }
+
+                return queries;
+            }
+
+            //only "INSERT" and "UPSERT" queries with limits are split
+            if (!QueryDescriptor<Dialect>::pushesRows(_action) || (_maxBatchBytes == 0 && _maxBatchRows == 0)) {
+                queries.emplace_back();
+                renderInto(queries.back(), [this](auto &writer) { writeQuery(writer); });
+
+                return queries;
+            }
+
+            //measure the part of the query that every batch repeats, from a query of the first row alone
+            LengthCounter<Dialect> counter;
+            _rowEnd = std::min<std::size_t>(1, _rows.rows());
+            writeQuery(counter);
+            const std::size_t fixedLength = counter.length() - rowLength(0);
+
+            splitBatches(fixedLength, _rows.rows(), [this](const std::size_t &position) { return rowLength(position); },
+                         [&](const std::size_t &begin, const std::size_t &end) { buildBatch(queries, begin, end); });
+
+            return queries;
+        }
+
+        inline std::vector<std::string> buildColumnarInsert(const DBQueryBuilder::Type::ColumnBatch &batch) {
+            DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+            std::vector<std::string> queries;       //the queries to be returned
+            auto rowLength = [&](const std::size_t &row) {
+                LengthCounter<Dialect> counter;
+                _mainClauseCreator.buildColumnarRow(counter, batch, row);
+
+                return counter.length();
+            };
+
+            //measure the part of the query that every batch repeats, from a query of the first row alone
+            LengthCounter<Dialect> counter;
+            _mainClauseCreator.buildColumnarInsert(counter, _tableName, batch, 0, std::min<std::size_t>(1, batch.rows()));
+            const std::size_t fixedLength = counter.length() - rowLength(0);
+
+            splitBatches(fixedLength, batch.rows(), rowLength, [&](const std::size_t &begin, const std::size_t &end) {
+                queries.emplace_back();
+                renderInto(queries.back(), [&](auto &writer) {
+                    _mainClauseCreator.buildColumnarInsert(writer, _tableName, batch, begin, end);
+                });
+            });
+
+            return queries;
+        }
+
+        inline ParameterizedQuery buildParameterizedQuery() {
+            ParameterizedQuery query;       //the query to be returned
+            buildParameterizedQueryInto(query);
+
+            return query;
+        }
+
+        /**
+         * @brief: returns the query that has been built thus far, with every value replaced by a placeholder, split
+         * into as many queries as binding at most the passed number of values each requires; "INSERT" queries are
+         * split, by whole rows, and by the row-limit of setBatchLimits(...) as well, while the byte-limit is left to the
+         * queries with values; queries with an "in"-list are split by whole entries, and by the limit of
+         * setInListLimit(...) as well
+         * @throws std::length_error: if a single row or entry, or a query that is not split, has more values than can be
+         * bound
+         * @param maxBinds: the greatest number of values that a query can bind
+         * @return std::vector: the queries, in order, each numbering its placeholders from the first
+         */
+        inline std::vector<ParameterizedQuery> buildParameterizedQueries(const std::size_t &maxBinds) {
+            DBQueryBuilder::Diagnostics::LatencyTrace trace;        //times the build, and the stages within it
+            std::vector<ParameterizedQuery> queries;        //the queries to be returned
+            selectAllRows();
+
+            if (splitsInList()) {
+                //every query binds the values of the rest of the query, and as many whole entries as it can bind besides
+                _inEnd = _inBegin;
+                LengthCounter<Dialect> counter;
+                PlaceholderWriter<Dialect, LengthCounter<Dialect>> measurer(counter, nullptr);
+                writeQuery(measurer);
+
+                const std::size_t arity = _inColumns.size();
+                if (measurer.placeholders() + arity > maxBinds) {       //not even a single entry can be bound
+                    throw std::length_error(origin<Dialect>("Core::buildParameterizedQueries") +
+                                            "the query has more values than can be bound");
+                }
+
+                std::size_t perQuery = (maxBinds - measurer.placeholders()) / arity;
+                if (_maxInEntries != 0) {
+                    perQuery = std::min(perQuery, _maxInEntries);
+                }
+                if (perQuery < inEntries()) {
+                    checkInListSplit("Core::buildParameterizedQueries");
+                }
+
+                for (std::size_t begin = 0; begin < inEntries(); begin += perQuery) {
+                    _inBegin = begin, _inEnd = std::min(begin + perQuery, inEntries());
+                    queries.emplace_back();
+                    parameterizeInto(queries.back());
+                }
+
+                return queries;
+            }
+
+            if (!QueryDescriptor<Dialect>::pushesRows(_action)) {
+                queries.emplace_back();
+                parameterizeInto(queries.back());
+                if (queries.back().binds.size() > maxBinds) {       //the query cannot be split
+                    throw std::length_error(origin<Dialect>("Core::buildParameterizedQueries") +
+                                            "the query has more values than can be bound");
+                }
+
+                return queries;
+            }
+
+            //every batch takes as many whole rows as it can bind
+            const std::size_t columns = std::max<std::size_t>(1, _rows.columns().size());
+            if (columns > maxBinds) {       //a single row cannot be bound
+                throw std::length_error(origin<Dialect>("Core::buildParameterizedQueries") +
+                                        "a Resource-representation has more values than can be bound");
+            }
+
+            std::size_t perBatch = maxBinds / columns;
+            if (_maxBatchRows != 0) {
+                perBatch = std::min(perBatch, _maxBatchRows);
+            }
+
+            std::size_t begin = 0;
+            do {
+                _rowBegin = begin, _rowEnd = std::min(begin + perBatch, _rows.rows());
+                queries.emplace_back();
+                parameterizeInto(queries.back());
+
+                begin += perBatch;
+            } while (begin < _rows.rows());
+
+            return queries;
+        }
+
+        inline int reset() {
+            //clear every part of the query, without releasing the capacity of any of them
+            _action = Action::NIL;
+            _conflict = Conflict::ABORT;
+            _upserts.clear();
+            _upsertSyntax = UpsertSyntax::VALUES_FUNCTION;
+            _tableName.clear();
+            _columns.clear();
+            _rows.clear();
+            _batchOrder.clear();
+            _maxBatchBytes = 0, _maxBatchRows = 0;
+            _conditions.clear();
+            _orderClause.clear();
+            _limitPhrase.clear();
+            _keyColumns.clear();
+            _seekKey.clear();
+            _keyOrder = Order::ASC;
+            _inColumns.clear();
+            _inValues.clear();
+            _inNegated = false;
+            _maxInEntries = 0;
+
+            return 0;
+        }
+    };
+
+}
+
+#endif //DBQUERYBUILDER_QUERYENGINE_H
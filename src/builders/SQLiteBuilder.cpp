@@ -0,0 +1,247 @@
+//
+// Created by fo on 20/04/2021.
+//
+// This file contains the implementation of all the member-functions of SQLiteBuilder
+#include "../../builders/SQLiteBuilder.h"
+#include "../../utils/Escaper.h"
+#include "QueryEngine.h"
+
+using SQLiteBuilder = DBQueryBuilder::Builder::SQLiteBuilder;
+
+namespace {
+    /**
+     * @brief: the dialect of SQLite, as the engine renders it; check src/builders/QueryEngine.h
+     */
+    struct SQLiteDialect {
+        using Clause = DBQueryBuilder::Builder::Engine::Clause;
+
+        static constexpr char builder[] = "SQLiteBuilder";
+        static constexpr char quote = '"';
+        static constexpr char placeholder = '?';
+        static constexpr bool numbersPlaceholders = true;       //"?NNN"
+        static constexpr bool cachesTemplates = false;
+        static constexpr std::uint64_t seed = 0x73716C6974650000ull;       //"sqlite"
+
+        /**
+         * @brief: the capability-mask of each query-type, indexed by DBQueryBuilder::Action
+         */
+        static constexpr std::uint8_t clauses[] = {
+                0,                                                  //INSERT
+                Clause::WHERE | Clause::ORDER | Clause::LIMIT,      //SELECT
+                Clause::WHERE,                                      //UPDATE
+                Clause::WHERE,                                      //DELETE
+                0,                                                  //UPSERT
+                0                                                   //NIL
+        };
+
+        /**
+         * @brief: a string-literal of SQLite knows no backslash-escapes; only its quotes are escaped
+         */
+        static inline std::size_t literalLength(const char *chars, const std::size_t &count) {
+            return DBQueryBuilder::Util::Escaper::quotedLength(chars, count, '\'');
+        }
+
+        static inline char *escapeLiteral(const char *chars, const std::size_t &count, char *out) {
+            return DBQueryBuilder::Util::Escaper::escapeQuoted(chars, count, '\'', out);
+        }
+
+        static inline std::size_t identifierLength(const char *chars, const std::size_t &count) {
+            return DBQueryBuilder::Util::Escaper::quotedLength(chars, count, quote);
+        }
+
+        static inline char *escapeIdentifier(const char *chars, const std::size_t &count, char *out) {
+            return DBQueryBuilder::Util::Escaper::escapeQuoted(chars, count, quote, out);
+        }
+    };
+}
+
+class SQLiteBuilder::Core : public DBQueryBuilder::Builder::Engine::BuilderCore<SQLiteDialect> {
+public:
+    std::size_t _maxVariables{defaultMaxVariables};     //the greatest number of values that a parameterized query binds
+
+    inline int setConflict(const Conflict &conflict) {
+        using EngineConflict = DBQueryBuilder::Builder::Engine::Conflict;
+
+        switch (conflict) {
+            case Conflict::ABORT:
+                _conflict = EngineConflict::ABORT;
+                break;
+            case Conflict::REPLACE:
+                _conflict = EngineConflict::REPLACE;
+                break;
+            case Conflict::IGNORE:
+                _conflict = EngineConflict::IGNORE;
+                break;
+            default:        //the passed resolution is not known
+                throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<SQLiteDialect>("Core::setConflict") +
+                                       "the resolution of conflicts is unknown");
+        }
+
+        return 0;
+    }
+
+    inline int setMaxVariables(const std::size_t &maxVariables) {
+        if (maxVariables == 0) {        //no value could be bound
+            throw std::logic_error(DBQueryBuilder::Builder::Engine::origin<SQLiteDialect>("Core::setMaxVariables") +
+                                   "the greatest number of variables cannot be zero");
+        }
+
+        _maxVariables = maxVariables;
+
+        return 0;
+    }
+
+    inline int reset() {
+        _maxVariables = defaultMaxVariables;
+
+        return BuilderCore::reset();
+    }
+};
+
+SQLiteBuilder::SQLiteBuilder() {
+    _core = new Core();
+}
+
+SQLiteBuilder::SQLiteBuilder(Core *core) : _core(core) {}
+
+DBQueryBuilder::Builder::IQueryBuilder *SQLiteBuilder::clone() const {
+    auto *core = new Core(*_core);
+    core->reserveAs(*_core);
+
+    return new SQLiteBuilder(core);
+}
+
+int SQLiteBuilder::restore(const IQueryBuilder &prototype) {
+    const auto *source = dynamic_cast<const SQLiteBuilder *>(&prototype);
+    if (source == nullptr) {       //the prototype is of another dialect
+        throw std::logic_error("In Builder::SQLiteBuilder::restore: the prototype is not a SQLiteBuilder");
+    }
+
+    return _core->instrumented([&]() { return Core::restore(*_core, *source->_core); });
+}
+
+int SQLiteBuilder::reserve(const std::size_t &columns, const std::size_t &rows, const std::size_t &conditions,
+                           const std::size_t &textLength) {
+    return _core->instrumented([&]() { return _core->reserve(columns, rows, conditions, textLength); });
+}
+
+int SQLiteBuilder::setTableName(const std::string &tableName) {
+    return _core->instrumented([&]() { return _core->setTableName(tableName); });
+}
+
+int SQLiteBuilder::setAction(const Action &action) {
+    return _core->instrumented([&]() { return _core->setAction(action); });
+}
+
+int SQLiteBuilder::setConflict(const Conflict &conflict) {
+    return _core->instrumented([&]() { return _core->setConflict(conflict); });
+}
+
+int SQLiteBuilder::setMaxVariables(const std::size_t &maxVariables) {
+    return _core->instrumented([&]() { return _core->setMaxVariables(maxVariables); });
+}
+
+int SQLiteBuilder::setTargetColumns(const std::vector<std::string> &columns) {
+    return _core->instrumented([&]() { return _core->setTargetColumns(columns); });
+}
+
+int SQLiteBuilder::addCondition(const std::shared_ptr<Type::QueryCondition> &qCondition) {
+    return _core->instrumented([&]() { return _core->addCondition(qCondition); });
+}
+
+int SQLiteBuilder::addCompositeCondition(const std::vector<std::shared_ptr<Type::QueryCondition>> qConditions) {
+    return _core->instrumented([&]() { return _core->addCompositeCondition(qConditions); });
+}
+
+int SQLiteBuilder::addConditions(const Type::ConditionTree &conditions) {
+    return _core->instrumented([&]() { return _core->addConditions(conditions); });
+}
+
+int SQLiteBuilder::addResourceRep(const std::map<std::string, std::string> &resourceRep) {
+    return _core->instrumented([&]() { return _core->addResourceRep(resourceRep); });
+}
+
+int SQLiteBuilder::addRow(const std::map<std::string, std::string> &resourceRep) {
+    return _core->instrumented([&]() { return _core->addRow(resourceRep); });
+}
+
+int SQLiteBuilder::setBatchLimits(const std::size_t &maxBytes, const std::size_t &maxRows) {
+    return _core->instrumented([&]() { return _core->setBatchLimits(maxBytes, maxRows); });
+}
+
+int SQLiteBuilder::setBatchOrder(const std::string &columnName) {
+    return _core->instrumented([&]() { return _core->setBatchOrder(columnName); });
+}
+
+int SQLiteBuilder::setOrder(const std::string &columnName, const Order &order) {
+    return _core->instrumented([&]() { return _core->setOrder(columnName, order); });
+}
+
+int SQLiteBuilder::setLimit(const int &limit) {
+    return _core->instrumented([&]() { return _core->setLimit(limit); });
+}
+
+int SQLiteBuilder::setInList(const std::string &column, const std::vector<std::string> &values, const bool &negate) {
+    return _core->instrumented([&]() { return _core->setInList({column}, values, negate); });
+}
+
+int SQLiteBuilder::setInList(const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &entries,
+                          const bool &negate) {
+    return _core->instrumented([&]() { return _core->setInList(columns, entries, negate); });
+}
+
+int SQLiteBuilder::setInListLimit(const std::size_t &maxEntries) {
+    return _core->instrumented([&]() { return _core->setInListLimit(maxEntries); });
+}
+
+std::string SQLiteBuilder::buildQuery() {
+    return _core->instrumented([&]() { return _core->buildQuery(); });
+}
+
+std::size_t SQLiteBuilder::buildQueryInto(std::string &buffer) {
+    return _core->instrumented([&]() { return _core->buildQueryInto(buffer); });
+}
+
+std::size_t SQLiteBuilder::buildQueryInto(char *buffer, const std::size_t &capacity) {
+    return _core->instrumented([&]() { return _core->buildQueryInto(buffer, capacity); });
+}
+
+std::vector<std::string> SQLiteBuilder::buildQueries() {
+    return _core->instrumented([&]() { return _core->buildQueries(); });
+}
+
+DBQueryBuilder::Builder::ParameterizedQuery SQLiteBuilder::buildParameterizedQuery() {
+    return _core->instrumented([&]() { return _core->buildParameterizedQuery(); });
+}
+
+std::size_t SQLiteBuilder::buildParameterizedQueryInto(ParameterizedQuery &query) {
+    return _core->instrumented([&]() { return _core->buildParameterizedQueryInto(query); });
+}
+
+std::vector<DBQueryBuilder::Builder::ParameterizedQuery> SQLiteBuilder::buildParameterizedQueries() {
+    return _core->instrumented([&]() { return _core->buildParameterizedQueries(_core->_maxVariables); });
+}
+
+DBQueryBuilder::Builder::FragmentedQuery SQLiteBuilder::buildFragmentedQuery() {
+    return _core->instrumented([&]() { return _core->buildFragmentedQuery(); });
+}
+
+std::size_t SQLiteBuilder::buildFragmentedQueryInto(FragmentedQuery &query) {
+    return _core->instrumented([&]() { return _core->buildFragmentedQueryInto(query); });
+}
+
+int SQLiteBuilder::reset() {
+    return _core->instrumented([&]() { return _core->reset(); });
+}
+
+DBQueryBuilder::Diagnostics::AllocationStats SQLiteBuilder::allocationStats() const {
+    return _core->_allocations.stats();
+}
+
+void SQLiteBuilder::resetAllocationStats() {
+    _core->_allocations.reset();
+}
+
+SQLiteBuilder::~SQLiteBuilder() {
+    delete _core;
+}
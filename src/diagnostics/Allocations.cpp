@@ -0,0 +1,188 @@
+//
+// Created by fo on 15/04/2021.
+//
+// This file contains the definition of all the member-functions of AllocationScope and StringWatch, and the
+// replacements of the global operator new and operator delete that account to them; all of it is compiled only when
+// DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS is defined
+#include "../../diagnostics/Allocations.h"
+
+#ifdef DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+using AllocationScope = DBQueryBuilder::Diagnostics::AllocationScope;
+using StringWatch = DBQueryBuilder::Diagnostics::StringWatch;
+
+namespace {
+    //the innermost AllocationScope of each thread; constant-initialized, so that it is safe to read from operator new
+    //at any point of the life of a thread
+    thread_local AllocationScope *innermost = nullptr;
+
+    //every allocation is preceded by a header that holds its size, so that operator delete can account the bytes it
+    //frees; the header keeps the alignment that malloc guarantees
+    constexpr std::size_t headerSize = alignof(std::max_align_t);
+
+    inline void *allocate(const std::size_t &size) noexcept {
+        auto *block = static_cast<unsigned char *>(std::malloc(headerSize + size));
+        if (block == nullptr) {
+            return nullptr;
+        }
+
+        *reinterpret_cast<std::size_t *>(block) = size;
+        if (AllocationScope *scope = innermost) {
+            scope->allocated(size);
+        }
+
+        return block + headerSize;
+    }
+
+    inline void deallocate(void *memory) noexcept {
+        if (memory == nullptr) {
+            return;
+        }
+
+        unsigned char *block = static_cast<unsigned char *>(memory) - headerSize;
+        if (AllocationScope *scope = innermost) {
+            scope->deallocated(*reinterpret_cast<std::size_t *>(block));
+        }
+
+        std::free(block);
+    }
+
+    inline void *allocateOrThrow(const std::size_t &size) {
+        //keep calling the new-handler, as the default operator new does, until the allocation succeeds
+        while (true) {
+            if (void *memory = allocate(size)) {
+                return memory;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+}
+
+AllocationScope::AllocationScope(AllocationCounter &counter) : _counter(counter), _outer(innermost) {
+    innermost = this;
+}
+
+void AllocationScope::allocated(const std::size_t &bytes) {
+    ++_tally.allocations;
+    _tally.bytesAllocated += bytes;
+
+    _live += static_cast<std::ptrdiff_t>(bytes);
+    if (_live > static_cast<std::ptrdiff_t>(_tally.peakBytes)) {
+        _tally.peakBytes = static_cast<std::size_t>(_live);
+    }
+}
+
+void AllocationScope::deallocated(const std::size_t &bytes) {
+    ++_tally.deallocations;
+    _tally.bytesDeallocated += bytes;
+    _live -= static_cast<std::ptrdiff_t>(bytes);
+}
+
+void AllocationScope::reallocated() {
+    ++_tally.stringReallocations;
+}
+
+AllocationScope::~AllocationScope() {
+    innermost = _outer;
+
+    AllocationStats &stats = _counter._stats;
+    ++stats.operations;
+    stats.allocations += _tally.allocations;
+    stats.bytesAllocated += _tally.bytesAllocated;
+    stats.deallocations += _tally.deallocations;
+    stats.bytesDeallocated += _tally.bytesDeallocated;
+    stats.stringReallocations += _tally.stringReallocations;
+    if (_tally.peakBytes > stats.peakBytes) {
+        stats.peakBytes = _tally.peakBytes;
+    }
+
+    //the usage of this scope is part of that of the scope it is nested within
+    if (_outer != nullptr) {
+        _outer->_tally.allocations += _tally.allocations;
+        _outer->_tally.bytesAllocated += _tally.bytesAllocated;
+        _outer->_tally.deallocations += _tally.deallocations;
+        _outer->_tally.bytesDeallocated += _tally.bytesDeallocated;
+        _outer->_tally.stringReallocations += _tally.stringReallocations;
+
+        const std::ptrdiff_t peak = _outer->_live + static_cast<std::ptrdiff_t>(_tally.peakBytes);
+        if (peak > static_cast<std::ptrdiff_t>(_outer->_tally.peakBytes)) {
+            _outer->_tally.peakBytes = static_cast<std::size_t>(peak);
+        }
+        _outer->_live += _live;
+    }
+}
+
+void StringWatch::observe() {
+    //a string that held no text is merely given its first buffer
+    if (_text.data() != _data && _size != 0) {
+        if (AllocationScope *scope = innermost) {
+            scope->reallocated();
+        }
+    }
+
+    _data = _text.data();
+    _size = _text.size();
+}
+
+DBQueryBuilder::Diagnostics::AllocationCounter &DBQueryBuilder::Diagnostics::conditionRendering() {
+    thread_local AllocationCounter counter;
+    return counter;
+}
+
+void *operator new(std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void *operator new[](std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return allocateOrThrow(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return allocateOrThrow(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void *memory) noexcept {
+    deallocate(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    deallocate(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    deallocate(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+    deallocate(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+    deallocate(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept {
+    deallocate(memory);
+}
+
+#endif
@@ -0,0 +1,267 @@
+//
+// Created by fo on 16/04/2021.
+//
+// This file contains the definition of the per-thread recording of latencies, their merging, and their export in the
+// text-format of Prometheus
+#include "../../diagnostics/Latency.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace Diagnostics = DBQueryBuilder::Diagnostics;
+using LatencyHistogram = Diagnostics::LatencyHistogram;
+
+namespace {
+    /**
+     * @brief: the histograms of the stages, as recorded by one thread at a time; only that thread writes them, so
+     * every counter is written with a plain load and store, and read by merges without locking
+     */
+    struct alignas(64) Block {
+        struct Histogram {
+            std::atomic<std::uint64_t> counts[LatencyHistogram::buckets];
+            std::atomic<std::uint64_t> count, sum, max;
+        };
+
+        Histogram stages[Diagnostics::STAGES];
+
+        inline Block() {
+            clear();
+        }
+
+        inline void clear() {
+            for (Histogram &histogram : stages) {
+                for (std::atomic<std::uint64_t> &count : histogram.counts) {
+                    count.store(0, std::memory_order_relaxed);
+                }
+                histogram.count.store(0, std::memory_order_relaxed);
+                histogram.sum.store(0, std::memory_order_relaxed);
+                histogram.max.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        static inline void bump(std::atomic<std::uint64_t> &counter, const std::uint64_t &by) {
+            counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+        inline void record(const Diagnostics::Stage &stage, const std::uint64_t &nanoseconds) {
+            Histogram &histogram = stages[stage];
+            bump(histogram.counts[LatencyHistogram::bucketOf(nanoseconds)], 1);
+            bump(histogram.count, 1);
+            bump(histogram.sum, nanoseconds);
+            if (nanoseconds > histogram.max.load(std::memory_order_relaxed)) {
+                histogram.max.store(nanoseconds, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    /**
+     * @brief: every Block ever handed to a thread; the Block of a thread that has exited is handed to the next thread
+     * that starts recording, keeping what it has recorded, so that no Block is ever freed while it may be merged
+     */
+    class Registry {
+        std::mutex _mutex;
+        std::vector<std::unique_ptr<Block>> _blocks;
+        std::vector<Block *> _idle;
+
+    public:
+        static inline Registry &instance() {
+            //never destroyed, as threads may return their Blocks after the static objects are destroyed
+            static Registry *registry = new Registry();
+            return *registry;
+        }
+
+        inline Block *acquire() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_idle.empty()) {
+                Block *block = _idle.back();
+                _idle.pop_back();
+
+                return block;
+            }
+
+            _blocks.push_back(std::make_unique<Block>());
+            return _blocks.back().get();
+        }
+
+        inline void release(Block *block) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _idle.push_back(block);
+        }
+
+        template<typename Visit>
+        inline void forEach(const Visit &visit) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const std::unique_ptr<Block> &block : _blocks) {
+                visit(*block);
+            }
+        }
+    };
+
+#ifdef DBQUERYBUILDER_INSTRUMENT_LATENCY
+    /**
+     * @brief: the recording-state of a thread: its Block, and the stages timed within its open LatencyTraces
+     */
+    struct Recorder {
+        Block *block{Registry::instance().acquire()};
+        unsigned depth{0};      //the number of LatencyTraces open
+        std::uint64_t pending[Diagnostics::STAGES]{};      //the latency of each stage within the outermost trace
+        bool touched[Diagnostics::STAGES]{};        //whether each stage was timed within the outermost trace
+
+        inline ~Recorder() {
+            Registry::instance().release(block);
+        }
+    };
+
+    inline Recorder &recorder() {
+        thread_local Recorder recorder;
+        return recorder;
+    }
+#endif
+}
+
+const char *Diagnostics::stageName(const Stage &stage) {
+    static const char *names[] = {"build", "insert", "select", "update", "delete", "where", "order", "limit",
+                                  "condition"};
+    return stage < STAGES ? names[stage] : "unknown";
+}
+
+std::uint64_t LatencyHistogram::percentile(const double &quantile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    //the rank of the latency sought, counted from 1
+    const double clamped = quantile < 0 ? 0 : (quantile > 1 ? 1 : quantile);
+    auto rank = static_cast<std::uint64_t>(clamped * static_cast<double>(_count) + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+        seen += _counts[bucket];
+        if (seen >= rank) {
+            //no latency recorded exceeds the greatest one
+            const std::uint64_t highest = highestOf(bucket);
+            return highest < _max ? highest : _max;
+        }
+    }
+
+    return _max;
+}
+
+Diagnostics::LatencySnapshot Diagnostics::latencySnapshot() {
+    LatencySnapshot snapshot;
+    Registry::instance().forEach([&](const Block &block) {
+        for (std::size_t stage = 0; stage < STAGES; ++stage) {
+            const Block::Histogram &recorded = block.stages[stage];
+            LatencyHistogram &merged = snapshot.stages[stage];
+
+            for (std::size_t bucket = 0; bucket < LatencyHistogram::buckets; ++bucket) {
+                if (std::uint64_t count = recorded.counts[bucket].load(std::memory_order_relaxed)) {
+                    merged.add(bucket, count);
+                }
+            }
+            merged.addTotals(recorded.count.load(std::memory_order_relaxed),
+                             recorded.sum.load(std::memory_order_relaxed),
+                             recorded.max.load(std::memory_order_relaxed));
+        }
+    });
+
+    return snapshot;
+}
+
+void Diagnostics::resetLatencies() {
+    Registry::instance().forEach([](Block &block) { block.clear(); });
+}
+
+std::string Diagnostics::toPrometheus(const LatencySnapshot &snapshot) {
+    static const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    char line[192];
+    std::string text;
+
+    text += "# HELP dbquerybuilder_stage_latency_seconds The latency of each stage of the building of queries.\n";
+    text += "# TYPE dbquerybuilder_stage_latency_seconds summary\n";
+    for (std::size_t stage = 0; stage < STAGES; ++stage) {
+        const LatencyHistogram &histogram = snapshot.stages[stage];
+        const char *name = stageName(static_cast<Stage>(stage));
+
+        for (const double &quantile : quantiles) {
+            std::snprintf(line, sizeof(line), "dbquerybuilder_stage_latency_seconds{stage=\"%s\",quantile=\"%g\"} %.9g\n",
+                          name, quantile, histogram.percentile(quantile) * 1e-9);
+            text += line;
+        }
+        std::snprintf(line, sizeof(line), "dbquerybuilder_stage_latency_seconds_sum{stage=\"%s\"} %.9g\n", name,
+                      histogram.sum() * 1e-9);
+        text += line;
+        std::snprintf(line, sizeof(line), "dbquerybuilder_stage_latency_seconds_count{stage=\"%s\"} %llu\n", name,
+                      static_cast<unsigned long long>(histogram.count()));
+        text += line;
+    }
+
+    text += "# HELP dbquerybuilder_stage_latency_max_seconds The greatest latency of each stage of the building of queries.\n";
+    text += "# TYPE dbquerybuilder_stage_latency_max_seconds gauge\n";
+    for (std::size_t stage = 0; stage < STAGES; ++stage) {
+        std::snprintf(line, sizeof(line), "dbquerybuilder_stage_latency_max_seconds{stage=\"%s\"} %.9g\n",
+                      stageName(static_cast<Stage>(stage)), snapshot.stages[stage].max() * 1e-9);
+        text += line;
+    }
+
+    return text;
+}
+
+void Diagnostics::writePrometheus(const std::string &path) {
+    const std::string text = toPrometheus(latencySnapshot());
+
+    //write a temporary file beside the passed one, then move it over the passed one
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file << text;
+        if (!file) {
+            throw std::runtime_error("In Diagnostics::writePrometheus: \"" + temporary + "\" cannot be written");
+        }
+    }
+
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("In Diagnostics::writePrometheus: \"" + path + "\" cannot be replaced");
+    }
+}
+
+#ifdef DBQUERYBUILDER_INSTRUMENT_LATENCY
+void Diagnostics::recordLatency(const Stage &stage, const std::uint64_t &nanoseconds) {
+    Recorder &state = recorder();
+    if (state.depth == 0) {
+        state.block->record(stage, nanoseconds);
+        return;
+    }
+
+    state.pending[stage] += nanoseconds;
+    state.touched[stage] = true;
+}
+
+void Diagnostics::openTrace() {
+    ++recorder().depth;
+}
+
+void Diagnostics::closeTrace(const std::uint64_t &nanoseconds) {
+    Recorder &state = recorder();
+    if (--state.depth != 0) {       //the trace is part of another
+        return;
+    }
+
+    state.block->record(BUILD_QUERY, nanoseconds);
+    for (std::size_t stage = 0; stage < STAGES; ++stage) {
+        if (state.touched[stage]) {
+            state.block->record(static_cast<Stage>(stage), state.pending[stage]);
+            state.pending[stage] = 0;
+            state.touched[stage] = false;
+        }
+    }
+}
+#endif
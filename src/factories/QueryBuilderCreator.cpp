@@ -0,0 +1,231 @@
+//
+// Created by fo on 17/04/2021.
+//
+// This file contains the definition of the factory-functions for QueryBuilders, of all the member-functions of
+// DialectRegistry, and of the per-thread free-lists of pooled QueryBuilders
+#include "../../factories/QueryBuilderCreator.h"
+#include "../../builders/MYSQLBuilder.h"
+#include "../../builders/PostgreSQLBuilder.h"
+#include "../../builders/SQLiteBuilder.h"
+#include <cctype>
+#include <stdexcept>
+
+using DialectRegistry = DBQueryBuilder::Factory::DialectRegistry;
+using IQueryBuilder = DBQueryBuilder::Builder::IQueryBuilder;
+
+namespace {
+    /**
+     * @brief: confirms whether or not the passed names are equal, without regard to case
+     */
+    inline bool sameName(const std::string &a, const std::string &b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //whether or not the BuilderPool of the calling thread may still be used; trivially destructible, so that it can be
+    //read by the deleters of pooled builders that outlive the BuilderPool of their thread
+    thread_local bool poolAlive = true;
+
+    /**
+     * @brief: the per-thread free-lists of idle builders, one per dialect
+     */
+    class BuilderPool {
+        static constexpr std::size_t _capacity = 32;     //the maximum number of idle builders kept by a thread, per dialect
+
+        std::array<std::vector<IQueryBuilder *>, DialectRegistry::capacity> _idle;
+
+    public:
+        /**
+         * @brief: returns the free-lists of the calling thread
+         * @return
+         */
+        static inline BuilderPool &local() {
+            thread_local BuilderPool pool;
+            return pool;
+        }
+
+        /**
+         * @brief: returns an idle builder of the passed dialect, or a new one if its free-list is empty
+         * @return
+         */
+        inline IQueryBuilder *acquire(const DBQueryBuilder::Factory::Dialect &dialect) {
+            if (dialect >= DialectRegistry::capacity || _idle[dialect].empty()) {
+                return DialectRegistry::instance().create(dialect);
+            }
+
+            IQueryBuilder *builder = _idle[dialect].back();
+            _idle[dialect].pop_back();
+
+            return builder;
+        }
+
+        /**
+         * @brief: restores the passed builder to the prototype of its dialect, so that it is handed out as a new clone
+         * would be, and keeps it for reuse, or destroys it if the free-list is full
+         * @param builder
+         */
+        inline void release(const DBQueryBuilder::Factory::Dialect &dialect, IQueryBuilder *builder) {
+            std::vector<IQueryBuilder *> &idle = _idle[dialect];
+            if (idle.size() == _capacity) {
+                delete builder;
+                return;
+            }
+
+            if (idle.capacity() == 0) {
+                idle.reserve(_capacity);
+            }
+
+            //the builder is released by a deleter, which cannot throw; one that cannot be restored is not kept
+            try {
+                DialectRegistry::instance().restore(dialect, *builder);
+            } catch (...) {
+                delete builder;
+                return;
+            }
+            idle.push_back(builder);
+        }
+
+        inline ~BuilderPool() {
+            poolAlive = false;
+            for (std::vector<IQueryBuilder *> &idle : _idle) {
+                for (IQueryBuilder *builder : idle) {
+                    delete builder;
+                }
+            }
+        }
+    };
+}
+
+DialectRegistry::DialectRegistry() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    publish(MYSQL, "mysql", std::make_unique<DBQueryBuilder::Builder::MYSQLBuilder>());
+    publish(POSTGRESQL, "postgresql", std::make_unique<DBQueryBuilder::Builder::PostgreSQLBuilder>());
+    publish(SQLITE, "sqlite", std::make_unique<DBQueryBuilder::Builder::SQLiteBuilder>());
+}
+
+DialectRegistry &DialectRegistry::instance() {
+    static DialectRegistry registry;
+    return registry;
+}
+
+void DialectRegistry::publish(const Dialect &dialect, const std::string &name, std::unique_ptr<IQueryBuilder> prototype) {
+    _published.push_back(std::make_unique<Entry>(Entry{name, std::move(prototype)}));
+    _entries[dialect].store(_published.back().get(), std::memory_order_release);
+}
+
+DBQueryBuilder::Factory::Dialect DialectRegistry::add(const std::string &name, std::unique_ptr<IQueryBuilder> prototype) {
+    if (prototype == nullptr) {
+        throw std::logic_error("In Factory::DialectRegistry::add: the prototype of dialect \"" + name + "\" is null");
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto &entry : _entries) {
+        const Entry *registered = entry.load(std::memory_order_acquire);
+        if (registered != nullptr && sameName(registered->name, name)) {
+            throw std::logic_error("In Factory::DialectRegistry::add: dialect \"" + name + "\" is already registered");
+        }
+    }
+
+    if (_next == capacity) {        //every id has been handed out
+        throw std::logic_error("In Factory::DialectRegistry::add: no more dialects can be registered");
+    }
+
+    auto dialect = static_cast<Dialect>(_next++);
+    publish(dialect, name, std::move(prototype));
+
+    return dialect;
+}
+
+int DialectRegistry::replace(const Dialect &dialect, std::unique_ptr<IQueryBuilder> prototype) {
+    if (prototype == nullptr) {
+        throw std::logic_error("In Factory::DialectRegistry::replace: the prototype is null");
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!registered(dialect)) {
+        throw std::logic_error("In Factory::DialectRegistry::replace: the dialect is not registered");
+    }
+
+    //the replaced Entry is kept, as other threads may still be cloning its prototype
+    publish(dialect, _entries[dialect].load(std::memory_order_relaxed)->name, std::move(prototype));
+
+    return 0;
+}
+
+DBQueryBuilder::Factory::Dialect DialectRegistry::find(const std::string &name) const {
+    for (std::size_t dialect = 0; dialect < capacity; ++dialect) {
+        const Entry *entry = _entries[dialect].load(std::memory_order_acquire);
+        if (entry != nullptr && sameName(entry->name, name)) {
+            return static_cast<Dialect>(dialect);
+        }
+    }
+
+    //build the message to be reported
+    std::string msg = "In Factory::DialectRegistry::find: QueryBuilder type \"";
+    msg += name;
+    msg += "\" is unknown";
+
+    //report the error
+    throw std::logic_error(msg);
+}
+
+bool DialectRegistry::registered(const Dialect &dialect) const {
+    return dialect < capacity && _entries[dialect].load(std::memory_order_acquire) != nullptr;
+}
+
+IQueryBuilder *DialectRegistry::create(const Dialect &dialect) const {
+    const Entry *entry = dialect < capacity ? _entries[dialect].load(std::memory_order_acquire) : nullptr;
+    if (entry == nullptr) {     //the dialect is not registered
+        throw std::logic_error("In Factory::DialectRegistry::create: the dialect is not registered");
+    }
+
+    return entry->prototype->clone();
+}
+
+int DialectRegistry::restore(const Dialect &dialect, IQueryBuilder &builder) const {
+    const Entry *entry = dialect < capacity ? _entries[dialect].load(std::memory_order_acquire) : nullptr;
+    if (entry == nullptr) {     //the dialect is not registered
+        throw std::logic_error("In Factory::DialectRegistry::restore: the dialect is not registered");
+    }
+
+    return builder.restore(*entry->prototype);
+}
+
+DBQueryBuilder::Builder::IQueryBuilder::Ptr DBQueryBuilder::Factory::makeQueryBuilder(const Dialect &dialect) {
+    return IQueryBuilder::Ptr(DialectRegistry::instance().create(dialect));
+}
+
+DBQueryBuilder::Builder::IQueryBuilder::Ptr DBQueryBuilder::Factory::makeQueryBuilder(const std::string &type) {
+    return makeQueryBuilder(DialectRegistry::instance().find(type));
+}
+
+void DBQueryBuilder::Factory::PoolReturner::operator()(IQueryBuilder *builder) const {
+    //a builder released after the BuilderPool of its thread was destroyed, such as one held by a static, is not kept
+    if (!poolAlive) {
+        delete builder;
+        return;
+    }
+
+    BuilderPool::local().release(dialect, builder);
+}
+
+DBQueryBuilder::Factory::PooledQueryBuilder DBQueryBuilder::Factory::makePooledQueryBuilder(const Dialect &dialect) {
+    if (!poolAlive) {       //the BuilderPool of the calling thread was destroyed
+        return PooledQueryBuilder(DialectRegistry::instance().create(dialect), PoolReturner{dialect});
+    }
+
+    return PooledQueryBuilder(BuilderPool::local().acquire(dialect), PoolReturner{dialect});
+}
+
+DBQueryBuilder::Factory::PooledQueryBuilder DBQueryBuilder::Factory::makePooledQueryBuilder(const std::string &type) {
+    return makePooledQueryBuilder(DialectRegistry::instance().find(type));
+}
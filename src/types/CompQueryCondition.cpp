@@ -3,42 +3,25 @@
 //
 // this file contains the definition of all the member-functions and nested class of CompQueryCondition
 #include "../../types/CompQueryCondition.h"
+#include <stdexcept>
 
+using QueryCondition = DBQueryBuilder::Type::QueryCondition;
 using CompQueryCondition = DBQueryBuilder::Type::CompQueryCondition;
 
 class CompQueryCondition::Core {
-    std::vector<QueryCondition::Ptr> _queryConditions;      //The collection of QueryConditions to aggregate
     std::string firstConj;      //the string form of the conjunction of the first QueryCondition within this CompQueryCondition
 
 public:
-    inline Core(std::vector<QueryCondition::Ptr> queryConditions) : _queryConditions(queryConditions) {
-        //initialize the firstConj
-        firstConj = queryConditions[0]->strConj();
-    }
+    std::vector<QueryCondition::Ptr> _queryConditions;      //The collection of QueryConditions to aggregate
 
-    inline std::string toString(const bool &addFirstConj) {
-        //begin the construction of the string-form of this QueryCondition
-        std::string condition;
-        int counter = 0;        //the number of iterations through the concerned loop, so far
-
-        if (addFirstConj) {     //the conjunction of the first component-query should be added
-            for (QueryCondition::Ptr qCondition : _queryConditions)  {
-                condition += (++counter == 1) ? firstConj : " ";
-                condition += (counter == 1) ? " (" : "";
-                condition += (counter == 1) ? qCondition->toString(false) : qCondition->toString(true);
-            }
-        } else {        //the conjunction of the first component-query should not be added
-            condition += "(";
-            for (QueryCondition::Ptr qCondition : _queryConditions)  {
-                condition += (++counter == 1) ? "" : " ";
-                condition += (counter == 1) ? qCondition->toString(false) : qCondition->toString(true);
-            }
+    inline Core(std::vector<QueryCondition::Ptr> queryConditions) : _queryConditions(queryConditions) {
+        if (_queryConditions.empty()) {     //there is no QueryCondition to aggregate
+            //report the error
+            throw std::logic_error("In Type::CompQueryCondition::CompQueryCondition: empty collection of QueryConditions");
         }
 
-        //close the composite query-condition
-        condition += ")";
-
-        return condition;
+        //initialize the firstConj
+        firstConj = queryConditions[0]->strConj();
     }
 
     inline std::string strConj() {
@@ -51,13 +34,30 @@ CompQueryCondition::CompQueryCondition(const std::vector<QueryCondition::Ptr> &c
 }
 
 std::string CompQueryCondition::toString(const bool &addFirstConj) {
-    return _core->toString(addFirstConj);
+    std::string condition;      //the string-form of this CompQueryCondition
+    renderTo(condition, addFirstConj);
+
+    return condition;
 }
 
 std::string CompQueryCondition::strConj() {
     return _core->strConj();
 }
 
+QueryCondition::Conjunction CompQueryCondition::conjunction() const {
+    //descend through the first components, without recursion, down to the first one that is not composite
+    const QueryCondition *first = _core->_queryConditions[0].get();
+    while (!first->components().empty()) {
+        first = first->components()[0].get();
+    }
+
+    return first->conjunction();
+}
+
+const std::vector<QueryCondition::Ptr> &CompQueryCondition::components() const {
+    return _core->_queryConditions;
+}
+
 CompQueryCondition::~CompQueryCondition() {
     delete _core;
 }
\ No newline at end of file
@@ -3,19 +3,22 @@
 //
 // This file contains the definition of  all the member-functions of QueryCondition and its nested class, Core
 #include "../../types/QueryCondition.h"
+#include "../../diagnostics/Allocations.h"
+#include "../../diagnostics/Latency.h"
+#include "../../utils/Escaper.h"
 #include <system_error>
+#include <utility>
 
 using QueryCondition = DBQueryBuilder::Type::QueryCondition;
 
 class QueryCondition::Core {
+public:
     QueryCondition::Conjunction _conjunction;
     std::string _field;
     QueryCondition::Operator _operator;
     bool _negate;
     std::string _value;
 
-
-public:
     std::string strConj;        //the string form of the _conjunction
 
     inline Core(const Conjunction &conjunction, const std::string &field, const Operator &_operator, const bool &negate,
@@ -35,10 +38,8 @@ public:
         }
     }
 
-    inline std::string toString(bool addConj = true) {
-        //construct the string-form of this QueryCondition
-        std::string queryCondition;
-
+    inline void renderTo(std::string &queryCondition, bool addConj = true) const {
+        //append the string-form of this QueryCondition
         if (addConj) {      //the conjunction should be added
             queryCondition += strConj;
         }
@@ -48,10 +49,13 @@ public:
             queryCondition += "not ";
         }
 
-        //append the concerned field
-        queryCondition += "`";
-        queryCondition += _field;
-        queryCondition += "`";
+        //append the concerned field, escaped as the engine's writers escape it
+        std::size_t offset = queryCondition.size();
+        queryCondition.resize(offset + DBQueryBuilder::Util::Escaper::identifierLength(_field.data(), _field.size()) + 2);
+        char *cursor = &queryCondition[offset];
+        *cursor++ = '`';
+        cursor = DBQueryBuilder::Util::Escaper::escapeIdentifier(_field.data(), _field.size(), cursor);
+        *cursor = '`';
 
         //determine the operator to be added
         switch (_operator) {
@@ -71,32 +75,119 @@ public:
                 queryCondition += ">='";
                 break;
             default:
-                throw std::logic_error("In Type::QueryCondition::toString: the operator-type is unknown");
+                throw std::logic_error("In Type::QueryCondition::renderTo: the operator-type is unknown");
         }
 
-        //append the value of the field
-        queryCondition += _value;
-        queryCondition += "'";
-
-        return  queryCondition;
+        //append the value of the field, escaped as the body of the literal opened by the operator
+        offset = queryCondition.size();
+        queryCondition.resize(offset + DBQueryBuilder::Util::Escaper::literalLength(_value.data(), _value.size()) + 1);
+        cursor = DBQueryBuilder::Util::Escaper::escapeLiteral(_value.data(), _value.size(), &queryCondition[offset]);
+        *cursor = '\'';
     }
-
 };
 
 QueryCondition::QueryCondition(const Conjunction &conjunction, const std::string &field, const Operator &_operator,
                                const bool &negate, const std::string value) {
     _core = new Core(conjunction, field, _operator, negate, value);
 }
-QueryCondition::QueryCondition() {}
+QueryCondition::QueryCondition() : _core(nullptr) {}
 
 std::string QueryCondition::toString(const bool &addConj) {
-    return _core != nullptr ? _core->toString(addConj) : std::string("");
+    std::string queryCondition;     //the string-form of this QueryCondition
+    renderTo(queryCondition, addConj);
+
+    return queryCondition;
+}
+
+bool QueryCondition::renderOpening(std::string &out, const bool &addConj) const {
+    if (!components().empty()) {        //this QueryCondition is composite
+        if (addConj) {      //the conjunction of the first component should be added
+            out += conjunction() == Conjunction::OR ? "or" : "and";
+            out += " (";
+        } else {
+            out += "(";
+        }
+
+        return true;
+    }
+
+    if (_core != nullptr) {
+        _core->renderTo(out, addConj);
+    }
+
+    return false;
+}
+
+void QueryCondition::renderTo(std::string &out, const bool &addConj) const {
+    //time the rendering, and account it to the calling thread, when latencies and allocations are being accounted
+    DBQueryBuilder::Diagnostics::LatencyTimer timer(DBQueryBuilder::Diagnostics::CONDITION_RENDERING);
+    DBQueryBuilder::Diagnostics::AllocationScope scope(DBQueryBuilder::Diagnostics::conditionRendering());
+    DBQueryBuilder::Diagnostics::StringWatch watch(out);
+
+    const bool composite = renderOpening(out, addConj);
+    watch.observe();
+    if (!composite) {
+        return;
+    }
+
+    //the composite QueryConditions whose components are being rendered, each with the index of its next component
+    std::vector<std::pair<const QueryCondition *, std::size_t>> frames{{this, 0}};
+    while (!frames.empty()) {
+        auto &[condition, next] = frames.back();
+        const auto &components = condition->components();
+
+        if (next == components.size()) {        //all components have been rendered
+            out += ")";
+            watch.observe();
+            frames.pop_back();
+            continue;
+        }
+
+        //only the first component of a composite QueryCondition goes without its conjunction
+        const QueryCondition &component = *components[next];
+        const bool conjoined = next++ != 0;
+        if (conjoined) {
+            out += " ";
+        }
+
+        if (component.renderOpening(out, conjoined)) {
+            frames.emplace_back(&component, 0);
+        }
+        watch.observe();
+    }
 }
 
 std::string QueryCondition::strConj() {
     return _core != nullptr ? _core->strConj : "";
 }
 
+QueryCondition::Conjunction QueryCondition::conjunction() const {
+    return _core != nullptr ? _core->_conjunction : Conjunction::AND;
+}
+
+const std::string &QueryCondition::field() const {
+    static const std::string none;
+    return _core != nullptr ? _core->_field : none;
+}
+
+QueryCondition::Operator QueryCondition::getOperator() const {
+    return _core != nullptr ? _core->_operator : Operator::E;
+}
+
+bool QueryCondition::isNegated() const {
+    return _core != nullptr && _core->_negate;
+}
+
+const std::string &QueryCondition::value() const {
+    static const std::string none;
+    return _core != nullptr ? _core->_value : none;
+}
+
+const std::vector<QueryCondition::Ptr> &QueryCondition::components() const {
+    static const std::vector<Ptr> none;
+    return none;
+}
+
 QueryCondition::~QueryCondition() {
     delete _core;
 }
\ No newline at end of file
@@ -0,0 +1,204 @@
+//
+// Created by fo on 02/04/2021.
+//
+// This file contains the definition of all the member-functions of TemplateCache and its nested class, Core
+#include "../../types/TemplateCache.h"
+#include <atomic>
+#include <shared_mutex>
+#include <mutex>
+#include <unordered_map>
+
+using TemplateCache = DBQueryBuilder::Type::TemplateCache;
+
+class TemplateCache::Core {
+    static constexpr std::size_t _shardCount = 16;      //the number of independently locked partitions of the cache
+
+    /**
+     * @brief: a cached QueryTemplate, with the tick of its latest use
+     */
+    struct Entry {
+        std::uint64_t _check;
+        QueryTemplate::Ptr _template;
+        std::atomic<std::uint64_t> _lastUse;
+
+        Entry(const std::uint64_t &check, const QueryTemplate::Ptr &qTemplate, const std::uint64_t &tick)
+                : _check(check), _template(qTemplate), _lastUse(tick) {}
+    };
+
+    /**
+     * @brief: a partition of the cache; lookups share its lock, insertions and evictions hold it exclusively
+     */
+    struct alignas(64) Shard {
+        mutable std::shared_mutex _mutex;
+        std::unordered_map<std::uint64_t, Entry> _entries;
+        std::atomic<std::uint64_t> _hits{0};
+        std::atomic<std::uint64_t> _misses{0};
+        std::atomic<std::uint64_t> _evictions{0};
+    };
+
+    Shard _shards[_shardCount];
+
+    std::atomic<std::size_t> _capacity{0};
+    std::atomic<std::size_t> _size{0};      //the number of entries held by all shards
+    std::atomic<std::uint64_t> _clock{0};       //the source of the ticks that order entries by recency
+
+    static inline std::size_t shardIndexOf(const std::uint64_t &hash) {
+        return (hash >> 58u) % _shardCount;
+    }
+
+    inline Shard &shardOf(const std::uint64_t &hash) {
+        return _shards[shardIndexOf(hash)];
+    }
+
+    /**
+     * @brief: evicts the least recently used entry of the whole cache; every entry is scanned, so a cache whose
+     * capacity exceeds the shapes in use seldom pays for it
+     * @return bool: false, if every shard was empty
+     */
+    inline bool evictOldest() {
+        while (true) {
+            //find the oldest entry, a shard at a time
+            Shard *oldestShard = nullptr;
+            std::uint64_t oldestHash = 0, oldestUse = 0;
+            for (Shard &shard : _shards) {
+                std::shared_lock lock(shard._mutex);
+                for (const auto &entry : shard._entries) {
+                    const std::uint64_t lastUse = entry.second._lastUse.load(std::memory_order_relaxed);
+                    if (oldestShard == nullptr || lastUse < oldestUse) {
+                        oldestShard = &shard;
+                        oldestHash = entry.first;
+                        oldestUse = lastUse;
+                    }
+                }
+            }
+
+            if (oldestShard == nullptr) {       //every shard was empty
+                return false;
+            }
+
+            //evict it, unless it has been used, or evicted, in the meantime, in which case the search is repeated
+            std::unique_lock lock(oldestShard->_mutex);
+            auto oldest = oldestShard->_entries.find(oldestHash);
+            if (oldest == oldestShard->_entries.end() ||
+                oldest->second._lastUse.load(std::memory_order_relaxed) != oldestUse) {
+                continue;
+            }
+
+            oldestShard->_entries.erase(oldest);
+            oldestShard->_evictions.fetch_add(1, std::memory_order_relaxed);
+            _size.fetch_sub(1, std::memory_order_relaxed);
+
+            return true;
+        }
+    }
+
+public:
+    inline void setCapacity(const std::size_t &capacity) {
+        _capacity.store(capacity, std::memory_order_relaxed);
+
+        //shrink the cache to its new capacity
+        while (_size.load(std::memory_order_relaxed) > capacity && evictOldest()) {}
+    }
+
+    inline bool enabled() const {
+        return _capacity.load(std::memory_order_relaxed) != 0;
+    }
+
+    inline QueryTemplate::Ptr find(const std::uint64_t &hash, const std::uint64_t &check) {
+        Shard &shard = shardOf(hash);
+        std::shared_lock lock(shard._mutex);
+
+        auto entry = shard._entries.find(hash);
+        if (entry == shard._entries.end() || entry->second._check != check) {      //the shape has not been cached
+            shard._misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        entry->second._lastUse.store(_clock.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+        shard._hits.fetch_add(1, std::memory_order_relaxed);
+
+        return entry->second._template;
+    }
+
+    inline void insert(const std::uint64_t &hash, const std::uint64_t &check, const QueryTemplate::Ptr &qTemplate) {
+        const std::size_t capacity = _capacity.load(std::memory_order_relaxed);
+        if (capacity == 0) {        //caching is disabled
+            return;
+        }
+
+        //make room; concurrent insertions may overshoot briefly
+        while (_size.load(std::memory_order_relaxed) >= capacity && evictOldest()) {}
+
+        Shard &shard = shardOf(hash);
+        std::unique_lock lock(shard._mutex);
+
+        //a colliding or concurrently inserted entry is replaced
+        if (shard._entries.erase(hash) == 0) {
+            _size.fetch_add(1, std::memory_order_relaxed);
+        }
+        shard._entries.try_emplace(hash, check, qTemplate, _clock.fetch_add(1, std::memory_order_relaxed));
+    }
+
+    inline Stats stats() const {
+        Stats stats;
+        stats.capacity = _capacity.load(std::memory_order_relaxed);
+
+        for (const Shard &shard : _shards) {
+            std::shared_lock lock(shard._mutex);
+            stats.hits += shard._hits.load(std::memory_order_relaxed);
+            stats.misses += shard._misses.load(std::memory_order_relaxed);
+            stats.evictions += shard._evictions.load(std::memory_order_relaxed);
+            stats.size += shard._entries.size();
+        }
+
+        return stats;
+    }
+
+    inline void clear() {
+        for (Shard &shard : _shards) {
+            std::unique_lock lock(shard._mutex);
+            _size.fetch_sub(shard._entries.size(), std::memory_order_relaxed);
+            shard._entries.clear();
+            shard._hits.store(0, std::memory_order_relaxed);
+            shard._misses.store(0, std::memory_order_relaxed);
+            shard._evictions.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+TemplateCache::TemplateCache() {
+    _core = new Core();
+}
+
+TemplateCache &TemplateCache::instance() {
+    static TemplateCache cache;
+    return cache;
+}
+
+void TemplateCache::setCapacity(const std::size_t &capacity) {
+    _core->setCapacity(capacity);
+}
+
+bool TemplateCache::enabled() const {
+    return _core->enabled();
+}
+
+DBQueryBuilder::Type::QueryTemplate::Ptr TemplateCache::find(const std::uint64_t &hash, const std::uint64_t &check) {
+    return _core->find(hash, check);
+}
+
+void TemplateCache::insert(const std::uint64_t &hash, const std::uint64_t &check, const QueryTemplate::Ptr &qTemplate) {
+    _core->insert(hash, check, qTemplate);
+}
+
+TemplateCache::Stats TemplateCache::stats() const {
+    return _core->stats();
+}
+
+void TemplateCache::clear() {
+    _core->clear();
+}
+
+TemplateCache::~TemplateCache() {
+    delete _core;
+}
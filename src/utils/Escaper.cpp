@@ -0,0 +1,316 @@
+//
+// Created by fo on 09/04/2021.
+//
+// This file contains the definition of all the member-functions of Escaper, with the vectorized scanning of values
+#include "../../utils/Escaper.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DBQUERYBUILDER_ESCAPER_X86
+#include <immintrin.h>
+#endif
+
+using Escaper = DBQueryBuilder::Util::Escaper;
+
+namespace DBQueryBuilder::Util {
+
+    /**
+     * @brief: the character that follows the backslash in the escaped form of each byte; zero, for bytes that are
+     * copied as they are
+     */
+    static constexpr struct EscapeTable {
+        char _replacement[256]{};
+
+        constexpr EscapeTable() {
+            _replacement[0x00] = '0';
+            _replacement[0x08] = 'b';
+            _replacement[0x09] = 't';
+            _replacement[0x0A] = 'n';
+            _replacement[0x0D] = 'r';
+            _replacement[0x1A] = 'Z';
+            _replacement[static_cast<unsigned char>('\'')] = '\'';
+            _replacement[static_cast<unsigned char>('"')] = '"';
+            _replacement[static_cast<unsigned char>('\\')] = '\\';
+        }
+
+        constexpr char operator[](const char &byte) const {
+            return _replacement[static_cast<unsigned char>(byte)];
+        }
+    } escapeTable;
+
+    static std::atomic<int> currentLevel{-1};       //the Escaper::Level in use; negative, until it is detected
+
+    /**
+     * @brief: writes the escaped form of the passed byte, which must need escaping
+     */
+    static inline char *escapeByte(const char &byte, char *out) {
+        out[0] = '\\';
+        out[1] = escapeTable[byte];
+
+        return out + 2;
+    }
+
+    static std::size_t literalLengthScalar(const char *chars, const std::size_t &count, std::size_t i = 0) {
+        std::size_t length = count;
+        for (; i < count; ++i) {
+            length += escapeTable[chars[i]] != 0;
+        }
+
+        return length;
+    }
+
+    static char *escapeLiteralScalar(const char *chars, const std::size_t &count, char *out, std::size_t i = 0) {
+        std::size_t run = i;        //the beginning of the run of bytes that need no escaping
+        for (; i < count; ++i) {
+            if (escapeTable[chars[i]] != 0) {
+                std::memcpy(out, chars + run, i - run);
+                out = escapeByte(chars[i], out + (i - run));
+                run = i + 1;
+            }
+        }
+        std::memcpy(out, chars + run, count - run);
+
+        return out + (count - run);
+    }
+
+#ifdef DBQUERYBUILDER_ESCAPER_X86
+    /**
+     * @brief: returns the mask of the bytes of the passed block that need escaping
+     */
+    __attribute__((target("sse2")))
+    static inline std::uint32_t escapeMask(const __m128i &block) {
+        __m128i mask = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\'')),
+                                                 _mm_cmpeq_epi8(block, _mm_set1_epi8('"'))),
+                                    _mm_cmpeq_epi8(block, _mm_set1_epi8('\\')));
+
+        //control-characters are rare, so they are only told apart once a byte not above Ctrl-Z is seen
+        const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(0x1A)), block);
+        if (_mm_movemask_epi8(control) != 0) {
+            mask = _mm_or_si128(mask, _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(block, _mm_setzero_si128()), _mm_cmpeq_epi8(block, _mm_set1_epi8(0x08))),
+                    _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(0x09)), _mm_cmpeq_epi8(block, _mm_set1_epi8(0x0A))),
+                                 _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(0x0D)), _mm_cmpeq_epi8(block, _mm_set1_epi8(0x1A))))));
+        }
+
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(mask));
+    }
+
+    __attribute__((target("avx2")))
+    static inline std::uint32_t escapeMask(const __m256i &block) {
+        __m256i mask = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\'')),
+                                                       _mm256_cmpeq_epi8(block, _mm256_set1_epi8('"'))),
+                                       _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\\')));
+
+        //control-characters are rare, so they are only told apart once a byte not above Ctrl-Z is seen
+        const __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(block, _mm256_set1_epi8(0x1A)), block);
+        if (_mm256_movemask_epi8(control) != 0) {
+            mask = _mm256_or_si256(mask, _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_setzero_si256()), _mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x08))),
+                    _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x09)), _mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x0A))),
+                                    _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x0D)), _mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x1A))))));
+        }
+
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(mask));
+    }
+
+    /**
+     * @brief: writes a block whose escape-mask is known; the whole block is stored at once when it needs no escaping
+     */
+    static inline char *escapeBlock(const char *block, const std::size_t &width, std::uint32_t mask, char *out) {
+        std::size_t run = 0;        //the beginning of the run of bytes that need no escaping
+        while (mask != 0) {
+            const std::size_t special = __builtin_ctz(mask);
+            std::memcpy(out, block + run, special - run);
+            out = escapeByte(block[special], out + (special - run));
+
+            run = special + 1;
+            mask &= mask - 1;
+        }
+        std::memcpy(out, block + run, width - run);
+
+        return out + (width - run);
+    }
+
+    __attribute__((target("sse2")))
+    static std::size_t literalLengthSSE2(const char *chars, const std::size_t &count) {
+        std::size_t i = 0, escapes = 0;
+        for (; i + 16 <= count; i += 16) {
+            escapes += __builtin_popcount(escapeMask(_mm_loadu_si128(reinterpret_cast<const __m128i *>(chars + i))));
+        }
+
+        return escapes + literalLengthScalar(chars, count, i);
+    }
+
+    __attribute__((target("sse2")))
+    static char *escapeLiteralSSE2(const char *chars, const std::size_t &count, char *out) {
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(chars + i));
+            const std::uint32_t mask = escapeMask(block);
+
+            if (mask == 0) {        //the block is copied whole
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), block);
+                out += 16;
+            } else {
+                out = escapeBlock(chars + i, 16, mask, out);
+            }
+        }
+
+        return escapeLiteralScalar(chars, count, out, i);
+    }
+
+    __attribute__((target("avx2")))
+    static std::size_t literalLengthAVX2(const char *chars, const std::size_t &count) {
+        std::size_t i = 0, escapes = 0;
+        for (; i + 32 <= count; i += 32) {
+            escapes += __builtin_popcount(escapeMask(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(chars + i))));
+        }
+
+        return escapes + literalLengthSSE2(chars + i, count - i) + i;
+    }
+
+    __attribute__((target("avx2")))
+    static char *escapeLiteralAVX2(const char *chars, const std::size_t &count, char *out) {
+        std::size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(chars + i));
+            const std::uint32_t mask = escapeMask(block);
+
+            if (mask == 0) {        //the block is copied whole
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), block);
+                out += 32;
+            } else {
+                out = escapeBlock(chars + i, 32, mask, out);
+            }
+        }
+
+        return escapeLiteralSSE2(chars + i, count - i, out);
+    }
+#endif
+
+    /**
+     * @brief: returns the widest implementation, no wider than the passed one, that the processor supports
+     */
+    static Escaper::Level supportedLevel(const Escaper::Level &level) {
+#ifdef DBQUERYBUILDER_ESCAPER_X86
+        if (level >= Escaper::Level::AVX2 && __builtin_cpu_supports("avx2")) {
+            return Escaper::Level::AVX2;
+        } else if (level >= Escaper::Level::SSE2 && __builtin_cpu_supports("sse2")) {
+            return Escaper::Level::SSE2;
+        }
+#endif
+        return Escaper::Level::SCALAR;
+    }
+
+    static inline Escaper::Level activeLevel() {
+        int level = currentLevel.load(std::memory_order_relaxed);
+        if (level < 0) {        //the implementation has not been chosen yet
+            level = supportedLevel(Escaper::Level::AVX2);
+            currentLevel.store(level, std::memory_order_relaxed);
+        }
+
+        return static_cast<Escaper::Level>(level);
+    }
+
+    /**
+     * @brief: returns the length of the passed characters, once every passed quote is doubled; the characters are
+     * already known to hold no NUL-character
+     */
+    static inline std::size_t quotedLengthUnchecked(const char *chars, const std::size_t &count, const char &quote) {
+        //names and most values are short, so the vectorized std::memchr is relied upon to find what needs attention
+        std::size_t length = count;
+        if (count == 0) {
+            return length;
+        }
+
+        for (const char *found = static_cast<const char *>(std::memchr(chars, quote, count)); found != nullptr;
+             found = static_cast<const char *>(std::memchr(found + 1, quote, count - (found + 1 - chars)))) {
+            ++length;
+        }
+
+        return length;
+    }
+
+}
+
+std::size_t Escaper::literalLength(const char *chars, const std::size_t &count) {
+    switch (DBQueryBuilder::Util::activeLevel()) {
+#ifdef DBQUERYBUILDER_ESCAPER_X86
+        case Level::AVX2:
+            return DBQueryBuilder::Util::literalLengthAVX2(chars, count);
+        case Level::SSE2:
+            return DBQueryBuilder::Util::literalLengthSSE2(chars, count);
+#endif
+        default:
+            return DBQueryBuilder::Util::literalLengthScalar(chars, count);
+    }
+}
+
+char *Escaper::escapeLiteral(const char *chars, const std::size_t &count, char *out) {
+    switch (DBQueryBuilder::Util::activeLevel()) {
+#ifdef DBQUERYBUILDER_ESCAPER_X86
+        case Level::AVX2:
+            return DBQueryBuilder::Util::escapeLiteralAVX2(chars, count, out);
+        case Level::SSE2:
+            return DBQueryBuilder::Util::escapeLiteralSSE2(chars, count, out);
+#endif
+        default:
+            return DBQueryBuilder::Util::escapeLiteralScalar(chars, count, out);
+    }
+}
+
+std::size_t Escaper::identifierLength(const char *chars, const std::size_t &count) {
+    //names are short, so the vectorized std::memchr is relied upon to find what needs attention
+    if (count != 0 && std::memchr(chars, '\0', count) != nullptr) {       //no identifier may hold a NUL-character
+        throw std::logic_error("In Util::Escaper::identifierLength: an identifier cannot hold a NUL-character");
+    }
+
+    return DBQueryBuilder::Util::quotedLengthUnchecked(chars, count, '`');
+}
+
+char *Escaper::escapeIdentifier(const char *chars, const std::size_t &count, char *out) {
+    return escapeQuoted(chars, count, '`', out);
+}
+
+std::size_t Escaper::quotedLength(const char *chars, const std::size_t &count, const char &quote) {
+    if (count != 0 && std::memchr(chars, '\0', count) != nullptr) {       //no quoted string may hold a NUL-character
+        throw std::logic_error("In Util::Escaper::quotedLength: a quoted string cannot hold a NUL-character");
+    }
+
+    return DBQueryBuilder::Util::quotedLengthUnchecked(chars, count, quote);
+}
+
+char *Escaper::escapeQuoted(const char *chars, const std::size_t &count, const char &quote, char *out) {
+    if (count == 0) {
+        return out;
+    }
+
+    const char *run = chars;        //the beginning of the run of characters that need no escaping
+    const char *end = chars + count;
+    for (const char *found = static_cast<const char *>(std::memchr(run, quote, count)); found != nullptr;
+         found = static_cast<const char *>(std::memchr(run, quote, end - run))) {
+        //copy the run, including the quote, then double the quote
+        std::memcpy(out, run, found + 1 - run);
+        out += found + 1 - run;
+        *out++ = quote;
+
+        run = found + 1;
+    }
+    std::memcpy(out, run, end - run);
+
+    return out + (end - run);
+}
+
+Escaper::Level Escaper::level() {
+    return DBQueryBuilder::Util::activeLevel();
+}
+
+Escaper::Level Escaper::setLevel(const Level &level) {
+    Level supported = DBQueryBuilder::Util::supportedLevel(level);
+    DBQueryBuilder::Util::currentLevel.store(supported, std::memory_order_relaxed);
+
+    return supported;
+}
@@ -0,0 +1,192 @@
+//
+// Created by fo on 13/04/2021.
+//
+// This file contains the definition of all the member-functions of WorkStealingPool and its nested class, Core
+#include "../../utils/WorkStealingPool.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using WorkStealingPool = DBQueryBuilder::Util::WorkStealingPool;
+
+class WorkStealingPool::Core {
+    /**
+     * @brief: the chunks [front, back) not yet taken from the run of a worker; the worker takes from the front, thieves
+     * from the back, so that each keeps working through memory that is contiguous
+     */
+    struct alignas(64) Run {
+        std::mutex mutex;
+        std::size_t front{0};
+        std::size_t back{0};
+    };
+
+    std::vector<std::thread> _threads;      //the workers, other than the thread that calls run(...)
+    std::unique_ptr<Run[]> _runs;       //the run of each worker; the thread that calls run(...) is worker 0
+    std::size_t _workers;
+
+    std::mutex _runMutex;       //serializes the calls of run(...)
+    std::mutex _mutex;      //guards everything below
+    std::condition_variable _started;
+    std::condition_variable _finished;
+    std::uint64_t _generation{0};       //incremented by every call of run(...), to wake the workers
+    std::size_t _busy{0};       //the number of workers, other than worker 0, that have not finished the present run
+    bool _stopping{false};
+
+    //the work of the present run
+    const std::function<void(std::size_t, std::size_t)> *_task{nullptr};
+    std::size_t _count{0}, _chunkSize{1};
+    std::atomic<bool> _failed{false};
+    std::exception_ptr _error;
+
+    /**
+     * @brief: takes the next chunk of the passed worker, stealing one if its own run is exhausted
+     * @return bool: false, if no chunk is left in any run
+     */
+    inline bool take(const std::size_t &worker, std::size_t &chunk) {
+        {
+            Run &own = _runs[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.front < own.back) {
+                chunk = own.front++;
+                return true;
+            }
+        }
+
+        //steal from the back of the run of the next worker that still has chunks
+        for (std::size_t i = 1; i < _workers; ++i) {
+            Run &victim = _runs[(worker + i) % _workers];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.front < victim.back) {
+                chunk = --victim.back;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    inline void work(const std::size_t &worker) {
+        std::size_t chunk;
+        while (!_failed.load(std::memory_order_relaxed) && take(worker, chunk)) {
+            const std::size_t begin = chunk * _chunkSize;
+            try {
+                (*_task)(begin, std::min(_count, begin + _chunkSize));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_failed.exchange(true)) {
+                    _error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    inline void loop(const std::size_t worker) {
+        std::uint64_t seen = 0;     //the last run worked on
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _started.wait(lock, [&]() { return _stopping || _generation != seen; });
+                if (_stopping) {
+                    return;
+                }
+                seen = _generation;
+            }
+
+            work(worker);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_busy == 0) {
+                _finished.notify_one();
+            }
+        }
+    }
+
+public:
+    inline explicit Core(const std::size_t &threads) {
+        _workers = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+        _runs.reset(new Run[_workers]);
+
+        _threads.reserve(_workers - 1);
+        for (std::size_t worker = 1; worker < _workers; ++worker) {
+            _threads.emplace_back(&Core::loop, this, worker);
+        }
+    }
+
+    inline std::size_t threads() const {
+        return _workers;
+    }
+
+    inline void run(const std::size_t &count, const std::size_t &chunkSize,
+                    const std::function<void(std::size_t, std::size_t)> &task) {
+        if (count == 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> runLock(_runMutex);
+        _task = &task;
+        _count = count;
+        _chunkSize = std::max<std::size_t>(1, chunkSize);
+        _failed = false;
+        _error = nullptr;
+
+        //deal every worker an equal, contiguous run of chunks; no worker is working, so the runs need no locking
+        const std::size_t chunks = (count + _chunkSize - 1) / _chunkSize;
+        for (std::size_t worker = 0; worker < _workers; ++worker) {
+            _runs[worker].front = chunks * worker / _workers;
+            _runs[worker].back = chunks * (worker + 1) / _workers;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _busy = _workers - 1;
+            ++_generation;
+        }
+        _started.notify_all();
+
+        //the calling thread is worker 0
+        work(0);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _finished.wait(lock, [&]() { return _busy == 0; });
+        _task = nullptr;
+
+        if (_error != nullptr) {
+            std::rethrow_exception(_error);
+        }
+    }
+
+    inline ~Core() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _started.notify_all();
+
+        for (std::thread &thread : _threads) {
+            thread.join();
+        }
+    }
+};
+
+WorkStealingPool::WorkStealingPool(const std::size_t &threads) {
+    _core = new Core(threads);
+}
+
+std::size_t WorkStealingPool::threads() const {
+    return _core->threads();
+}
+
+void WorkStealingPool::run(const std::size_t &count, const std::size_t &chunkSize,
+                           const std::function<void(std::size_t, std::size_t)> &task) {
+    _core->run(count, chunkSize, task);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    delete _core;
+}
@@ -0,0 +1,55 @@
+//
+// Created by fo on 24/04/2021.
+//
+// This file contains the helpers shared by the use-cases whose queries are run against an in-memory SQLite-database:
+// a query is run with its values bound to its placeholders, and its rows are passed on, or counted
+#include "../builders/IQueryBuilder.h"
+#include <sqlite3.h>
+#include <stdexcept>
+#include <string>
+
+#ifndef DBQUERYBUILDER_TESTS_SQLITEUSECASE_H
+#define DBQUERYBUILDER_TESTS_SQLITEUSECASE_H
+
+/**
+ * @brief: runs the passed query, binding its values in order, and passes every row it returns to the passed function
+ */
+template<typename OnRow>
+void run(sqlite3 *db, const DBQueryBuilder::Builder::ParameterizedQuery &query, const OnRow &onRow) {
+    sqlite3_stmt *statement = nullptr;
+    if (sqlite3_prepare_v2(db, query.sql.data(), static_cast<int>(query.sql.size()), &statement, nullptr) != SQLITE_OK) {
+        throw std::runtime_error(std::string(sqlite3_errmsg(db)) + " in: " + query.sql);
+    }
+
+    for (std::size_t i = 0; i < query.binds.size(); ++i) {       //the value of "?N" is the Nth bind
+        sqlite3_bind_text(statement, static_cast<int>(i + 1), query.binds[i].data(),
+                          static_cast<int>(query.binds[i].size()), SQLITE_TRANSIENT);
+    }
+
+    int status;
+    while ((status = sqlite3_step(statement)) == SQLITE_ROW) {
+        onRow(statement);
+    }
+    sqlite3_finalize(statement);
+
+    if (status != SQLITE_DONE) {
+        throw std::runtime_error(std::string(sqlite3_errmsg(db)) + " in: " + query.sql);
+    }
+}
+
+/**
+ * @brief: runs the passed query, binding its values in order
+ * @return int: the number of rows that the query returns
+ */
+inline int run(sqlite3 *db, const DBQueryBuilder::Builder::ParameterizedQuery &query) {
+    int rows = 0;
+    run(db, query, [&rows](sqlite3_stmt *) { ++rows; });
+
+    return rows;
+}
+
+inline int run(sqlite3 *db, const std::string &query) {
+    return run(db, DBQueryBuilder::Builder::ParameterizedQuery{query, {}});
+}
+
+#endif //DBQUERYBUILDER_TESTS_SQLITEUSECASE_H
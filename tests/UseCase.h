@@ -0,0 +1,38 @@
+//
+// Created by fo on 24/04/2021.
+//
+// This file contains the helpers shared by the use-cases: the check of a result against the expected one, and the
+// capture of the std::logic_error that a function throws
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#ifndef DBQUERYBUILDER_TESTS_USECASE_H
+#define DBQUERYBUILDER_TESTS_USECASE_H
+
+/**
+ * @brief: prints the passed result, or an error if it is not the expected one
+ */
+inline void check(const std::string &label, const std::string &result, const std::string &expected) {
+    if (result == expected) {
+        std::cout << label << ": " << result << std::endl;
+    } else {
+        std::cout << "\aError: " << label << ": \"" << result << "\" instead of \"" << expected << "\"" << std::endl;
+    }
+}
+
+/**
+ * @brief: returns the message of the std::logic_error that the passed function throws; empty, if it throws none
+ */
+template<typename Function>
+std::string rejection(const Function &function) {
+    try {
+        function();
+    } catch (std::logic_error &error) {
+        return error.what();
+    }
+
+    return "";
+}
+
+#endif //DBQUERYBUILDER_TESTS_USECASE_H
@@ -0,0 +1,99 @@
+//
+// Created by fo on 03/04/2021.
+//
+// This file contains a use-case of the batched "INSERT" queries of MYSQLBuilder: the same rows are split by a row-limit,
+// by a byte-limit, and by both, and every batch must push its rows, in order, within its limits
+#include "../../builders/MYSQLBuilder.h"
+#include <iostream>
+#include <stdexcept>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+
+static const std::string head = "insert into `note`(`id`, `text`) values";
+static const std::string rows[5] = {"('1', 'it\\'s')", "('2', 'b')", "('3', 'line\\n')", "('4', 'd')", "('5', 'e')"};
+
+/**
+ * @brief: returns the "INSERT" query of the rows within [begin, end)
+ */
+std::string batch(const std::size_t &begin, const std::size_t &end) {
+    std::string query = head;
+    for (std::size_t i = begin; i < end; ++i) {
+        query += (i == begin ? "" : ", ") + rows[i];
+    }
+
+    return query;
+}
+
+/**
+ * @brief: builds the queries of the rows, split by the passed limits, and prints them, or an error if they are not
+ * the batches of the passed sizes
+ */
+void check(const std::string &label, const std::size_t &maxBytes, const std::size_t &maxRows,
+           const std::vector<std::size_t> &sizes) {
+    MYSQLBuilder builder;
+    builder.setTableName("note");
+    builder.setAction(DBQueryBuilder::Action::INSERT);
+    builder.addRow({{"id", "1"}, {"text", "it's"}});
+    builder.addRow({{"id", "2"}, {"text", "b"}});
+    builder.addRow({{"id", "3"}, {"text", "line\n"}});
+    builder.addRow({{"id", "4"}, {"text", "d"}});
+    builder.addRow({{"id", "5"}, {"text", "e"}});
+    builder.setBatchLimits(maxBytes, maxRows);
+    const std::vector<std::string> queries = builder.buildQueries();
+
+    std::vector<std::string> expected;
+    std::size_t begin = 0;
+    for (const std::size_t &size : sizes) {
+        expected.push_back(batch(begin, begin + size));
+        begin += size;
+    }
+
+    if (queries != expected) {
+        std::cout << "\aError: " << label << ": " << queries.size() << " queries, instead of " << expected.size()
+                  << std::endl;
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            std::cout << "\aError: \"" << queries[i] << "\"" << (i < expected.size() ? " instead of \"" + expected[i] + "\"" : "")
+                      << std::endl;
+        }
+        return;
+    }
+
+    for (const std::string &query : queries) {
+        if (maxBytes != 0 && query.size() > maxBytes) {
+            std::cout << "\aError: " << label << ": " << query.size() << " bytes exceed " << maxBytes << std::endl;
+        }
+        std::cout << label << ": " << query << std::endl;
+    }
+}
+
+int main() {
+    try {
+        //a single query, unless a limit is set
+        check("Unlimited", 0, 0, {5});
+        check("Rows", 0, 2, {2, 2, 1});
+
+        //a byte-limit that fits the first two rows exactly, then one byte less; the longer third row is pushed alone
+        const std::size_t twoRows = batch(0, 2).size();
+        check("Bytes", twoRows, 0, {2, 1, 2});
+        check("Fewer bytes", twoRows - 1, 0, {1, 1, 1, 2});
+
+        //whichever limit is reached first closes the batch
+        check("Both", batch(0, 5).size(), 3, {3, 2});
+        check("Either", batch(1, 4).size(), 4, {2, 3});
+
+        //a row that cannot fit any batch
+        try {
+            check("Too few bytes", head.size() + rows[0].size() - 1, 0, {});
+            std::cout << "\aError: a row exceeding the byte-limit was not rejected" << std::endl;
+        } catch (std::length_error &error) {
+            std::cout << "Rejected: " << error.what() << std::endl;
+        }
+
+        std::cout << "Checked: every batch" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
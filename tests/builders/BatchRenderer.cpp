@@ -0,0 +1,99 @@
+//
+// Created by fo on 13/04/2021.
+//
+// This file contains a use-case of BatchRenderer: a compiled "INSERT" query is rendered once for every record, across a
+// few threads, and the query of every record must read as the one that its QueryTemplate renders alone, in the order
+// of the records, in the RenderedBatch and in its copies
+#include "../../builders/BatchRenderer.h"
+#include "../../builders/MYSQLBuilder.h"
+#include <iostream>
+#include <utility>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using BatchRenderer = DBQueryBuilder::Builder::BatchRenderer;
+using RenderedBatch = DBQueryBuilder::Builder::RenderedBatch;
+
+/**
+ * @brief: returns the number of queries of the passed RenderedBatch that do not read as the passed ones
+ */
+std::size_t mismatches(const RenderedBatch &batch, const std::vector<std::string> &expected) {
+    std::size_t mismatched = batch.size() == expected.size() ? 0 : 1;
+    for (std::size_t i = 0; i < batch.size() && i < expected.size(); ++i) {
+        mismatched += batch.query(i) != expected[i];
+    }
+
+    return mismatched;
+}
+
+/**
+ * @brief: prints the passed number of mismatches, or an error if there are any
+ */
+void check(const std::string &label, const std::size_t &mismatched, const std::size_t &records) {
+    if (mismatched == 0) {
+        std::cout << label << ": " << records << " records" << std::endl;
+    } else {
+        std::cout << "\aError: " << label << ": " << mismatched << " of " << records << " records mismatched" << std::endl;
+    }
+}
+
+int main() {
+    try {
+        MYSQLBuilder builder;
+        builder.setTableName("note");
+        builder.setAction(DBQueryBuilder::Action::INSERT);
+        builder.addResourceRep({{"id", "0"}, {"text", ""}});
+        const auto qTemplate = builder.compile();
+
+        //the values of the records, some needing escaping, and the query of each, rendered alone
+        const std::size_t records = 1000;
+        std::vector<std::string> texts;
+        std::vector<std::string_view> values;
+        std::vector<std::string> expected(records);
+        for (std::size_t record = 0; record < records; ++record) {
+            texts.push_back(std::to_string(record));
+            texts.push_back(record % 3 == 0 ? "it's\n" + std::to_string(record) : std::string(record % 40, 'x'));
+        }
+        for (std::size_t record = 0; record < records; ++record) {
+            values.emplace_back(texts[2 * record]);
+            values.emplace_back(texts[2 * record + 1]);
+            qTemplate->render({values[2 * record], values[2 * record + 1]}, expected[record]);
+        }
+        std::cout << "First: " << expected.front() << std::endl;
+
+        //chunks smaller than the share of a thread, so that threads steal them
+        BatchRenderer renderer(4, 16);
+        RenderedBatch batch = renderer.render(*qTemplate, values);
+        check("Rendered", mismatches(batch, expected), records);
+
+        //the buffers are reused by a second batch, of fewer records
+        const std::size_t rendered = renderer.renderInto(*qTemplate, values.data(), 2 * 100, batch);
+        check("Rerendered", mismatches(batch, std::vector<std::string>(expected.begin(), expected.begin() + 100)) +
+                            (rendered != 100), rendered);
+
+        //a RenderedBatch is a value
+        batch = renderer.render(*qTemplate, values);
+        RenderedBatch copied(batch);
+        RenderedBatch moved(std::move(batch));
+        batch = RenderedBatch();
+        check("Copied", mismatches(copied, expected), records);
+        check("Moved", mismatches(moved, expected), records);
+
+        //a single thread renders the same queries
+        check("Single thread", mismatches(BatchRenderer(1).render(*qTemplate, values), expected), records);
+
+        //a record must have a value for every slot
+        try {
+            renderer.renderInto(*qTemplate, values.data(), 3, batch);
+            std::cout << "\aError: a partial record was not rejected" << std::endl;
+        } catch (std::logic_error &error) {
+            std::cout << "Rejected: " << error.what() << std::endl;
+        }
+
+        std::cout << "Checked: every rendered batch" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
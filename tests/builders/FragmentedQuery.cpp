@@ -0,0 +1,69 @@
+//
+// Created by fo on 17/04/2021.
+//
+// This file contains a use-case of the fragmented output of MYSQLBuilder: a query, whose storage is short enough to be
+// held within the string itself, is copied and moved, and the fragments of every copy must still read as the query
+#include "../../builders/MYSQLBuilder.h"
+#include <iostream>
+#include <utility>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using FragmentedQuery = DBQueryBuilder::Builder::FragmentedQuery;
+
+/**
+ * @brief: confirms whether or not the fragments of the passed FragmentedQuery, and its iovecs, read as the passed text
+ */
+bool reads(const FragmentedQuery &query, const std::string &text) {
+    std::string fragments;
+    for (std::size_t i = 0; i < query.fragments.size(); ++i) {
+        fragments += query.fragment(i);
+    }
+
+#ifdef DBQUERYBUILDER_HAS_IOVEC
+    std::string vectors;
+    for (const iovec &vector : query.iovecs()) {
+        vectors.append(static_cast<const char *>(vector.iov_base), vector.iov_len);
+    }
+    if (vectors != text) {
+        return false;
+    }
+#endif
+
+    return fragments == text && query.str() == text && query.length() == text.size();
+}
+
+int main() {
+    try {
+        //the escaped value and the quoted names are stored; the rest is referred to where it is
+        MYSQLBuilder builder;
+        builder.setTableName("t");
+        builder.setAction(DBQueryBuilder::Action::DELETE);
+        builder.addCondition(std::make_shared<DBQueryBuilder::Type::QueryCondition>(
+                DBQueryBuilder::Type::QueryCondition::Conjunction::AND, "a", DBQueryBuilder::Type::QueryCondition::Operator::E,
+                false, "it's"));
+        const std::string text = builder.buildQuery();
+
+        FragmentedQuery built = builder.buildFragmentedQuery();
+        std::cout << "Fragments: " << built.fragments.size() << ", stored: " << built.storage.size() << " chars"
+                  << std::endl;
+
+        FragmentedQuery copied(built);
+        FragmentedQuery assigned;
+        assigned = copied;
+        FragmentedQuery moved(std::move(built));
+        FragmentedQuery moveAssigned;
+        moveAssigned = std::move(assigned);
+        built = FragmentedQuery();      //the original, and its storage, are gone
+
+        if (!reads(copied, text) || !reads(moved, text) || !reads(moveAssigned, text)) {
+            std::cout << "\aError: a copied or moved FragmentedQuery does not read as: " << text << std::endl;
+            return 1;
+        }
+        std::cout << "Copied and moved: " << moveAssigned.str() << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+//
+// Created by fo on 24/04/2021.
+//
+// This file contains a use-case of the "in"-lists of MYSQLBuilder and SQLiteBuilder, whose queries are run against an
+// in-memory SQLite-database, which reads the backtick-quoted names and the "?" placeholders of MYSQLBuilder alike: rows
+// are looked up by a list of ids, split into a few queries, and by a list of composite keys, and every row must be
+// returned exactly once
+#include "../../builders/MYSQLBuilder.h"
+#include "../../builders/SQLiteBuilder.h"
+#include "../../types/ConditionTree.h"
+#include "../SQLiteUseCase.h"
+#include "../UseCase.h"
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using SQLiteBuilder = DBQueryBuilder::Builder::SQLiteBuilder;
+using ParameterizedQuery = DBQueryBuilder::Builder::ParameterizedQuery;
+using ConditionTree = DBQueryBuilder::Type::ConditionTree;
+
+int main() {
+    sqlite3 *db = nullptr;
+    sqlite3_open(":memory:", &db);
+
+    try {
+        auto ignore = [](sqlite3_stmt *) {};
+        run(db, {"create table item(tenant text, id integer, payload text, primary key(tenant, id))", {}}, ignore);
+
+        //fill the table with 1000 rows, of 4 tenants
+        SQLiteBuilder filler;
+        filler.setTableName("item");
+        filler.setAction(DBQueryBuilder::Action::INSERT);
+        for (int id = 0; id < 1000; ++id) {
+            filler.addRow({{"tenant", std::string(1, static_cast<char>('a' + id % 4))}, {"id", std::to_string(id)},
+                           {"payload", "item-" + std::to_string(id)}});
+        }
+        for (const ParameterizedQuery &query : filler.buildParameterizedQueries()) {
+            run(db, query, ignore);
+        }
+
+        //a few ids, out of order and repeated, are sorted by value and rendered once each
+        MYSQLBuilder builder;
+        builder.setTableName("item");
+        builder.setAction(DBQueryBuilder::Action::SELECT);
+        builder.setTargetColumns({"id", "payload"});
+        ConditionTree tenants;
+        tenants.add(ConditionTree::Conjunction::AND, "tenant", ConditionTree::Operator::E, false, "a")
+                .add(ConditionTree::Conjunction::OR, "tenant", ConditionTree::Operator::E, false, "b");
+        builder.addConditions(tenants);
+        builder.setInList("id", {"12", "4", "100", "-3", "12", "9"});
+        check("In", builder.buildQuery(), "select  `id`, `payload` from `item` where ( `tenant`='a' or `tenant`='b') "
+                                          "and `id` in ('-3', '4', '9', '12', '100')  ");
+        builder.setInList("id", {"12", "4"}, true);
+        check("Not in", builder.buildQuery(), "select  `id`, `payload` from `item` where ( `tenant`='a' or "
+                                              "`tenant`='b') and `id` not in ('4', '12')  ");
+
+        //the multiples of 3, of the tenants "a" and "b", in queries of at most 100 ids
+        std::vector<std::string> ids;
+        for (int id = 999; id >= 0; id -= 3) {
+            ids.push_back(std::to_string(id));
+            ids.push_back(std::to_string(id));
+        }
+        builder.setInList("id", ids);
+        builder.setInListLimit(100);
+        const std::vector<std::string> queries = builder.buildQueries();
+
+        std::set<std::string> seen;
+        std::size_t returned = 0;
+        for (const std::string &query : queries) {
+            run(db, {query, {}}, [&](sqlite3_stmt *row) {
+                seen.insert(reinterpret_cast<const char *>(sqlite3_column_text(row, 0)));
+                ++returned;
+            });
+        }
+        check("Looked up", std::to_string(returned) + " rows, " + std::to_string(seen.size()) + " distinct, in " +
+                           std::to_string(queries.size()) + " queries", "167 rows, 167 distinct, in 4 queries");
+
+        //a limited query, or a page of a keyset, is not split, as the queries together would return too many rows
+        const std::string unsplittable = "a query with a \"limit\"-phrase, or a page of a keyset, cannot be split by "
+                                         "its \"in\"-list";
+        builder.setInList("id", {"1", "2", "3", "4", "5"});
+        builder.setInListLimit(2);
+        builder.setLimit(3);
+        check("Limited", rejection([&]() { builder.buildQueries(); }),
+              "In Builder::MYSQLBuilder::Core::buildQueries: " + unsplittable);
+        builder.setKeyset({"id"}, 2);
+        builder.seekAfter({"0"});
+        check("Paged", rejection([&]() { builder.buildQueries(); }),
+              "In Builder::MYSQLBuilder::Core::buildQueries: " + unsplittable);
+
+        //composite keys, bound in queries of at most 50 values, i.e. 25 keys
+        SQLiteBuilder lookup;
+        lookup.setTableName("item");
+        lookup.setAction(DBQueryBuilder::Action::SELECT);
+        lookup.setTargetColumns({"tenant", "id"});
+        lookup.setMaxVariables(50);
+        std::vector<std::vector<std::string>> keys;
+        for (int id = 0; id < 1000; id += 10) {
+            keys.push_back({std::string(1, static_cast<char>('a' + id % 4)), std::to_string(id)});
+            keys.push_back({"z", std::to_string(id)});      //no row has the key
+        }
+        lookup.setInList({"tenant", "id"}, keys);
+
+        const std::vector<ParameterizedQuery> bound = lookup.buildParameterizedQueries();
+        check("Keys", bound.front().sql.substr(0, bound.front().sql.find("), (")),
+              "select  \"tenant\", \"id\" from \"item\" where (\"tenant\", \"id\") in ((?1, ?2");
+        returned = 0;
+        std::size_t binds = 0;
+        for (const ParameterizedQuery &query : bound) {
+            run(db, query, [&](sqlite3_stmt *) { ++returned; });
+            binds = std::max(binds, query.binds.size());
+        }
+        check("Keyed", std::to_string(returned) + " rows in " + std::to_string(bound.size()) + " queries of at most " +
+                       std::to_string(binds) + " values", "100 rows in 8 queries of at most 50 values");
+        lookup.setLimit(10);
+        check("Limited", rejection([&]() { lookup.buildParameterizedQueries(); }),
+              "In Builder::SQLiteBuilder::Core::buildParameterizedQueries: " + unsplittable);
+
+        //an entry must have a value for every column
+        check("Rejected", rejection([&]() {
+            lookup.setInList(std::vector<std::string>{"tenant", "id"}, {{"a", "1"}, {"b"}});
+        }), "In Builder::SQLiteBuilder::Core::setInList: the list has 2 columns, but an entry has 1 values");
+
+        std::cout << "Checked: every in-list" << std::endl;
+    } catch (std::exception &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    sqlite3_close(db);
+    return 0;
+}
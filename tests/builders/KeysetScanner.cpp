@@ -0,0 +1,91 @@
+//
+// Created by fo on 23/04/2021.
+//
+// This file contains a use-case of KeysetScanner, whose pages are run against an in-memory SQLite-database, which reads
+// the backtick-quoted names and the "?" placeholders of MYSQLBuilder alike: a table is scanned through its composite
+// primary key, and every row that the guard-conditions select must be returned exactly once
+#include "../../builders/KeysetScanner.h"
+#include "../../builders/SQLiteBuilder.h"
+#include "../../types/ConditionTree.h"
+#include "../SQLiteUseCase.h"
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
+//perform type-aliasing for convenience
+using KeysetScanner = DBQueryBuilder::Builder::KeysetScanner;
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using SQLiteBuilder = DBQueryBuilder::Builder::SQLiteBuilder;
+using ParameterizedQuery = DBQueryBuilder::Builder::ParameterizedQuery;
+using ConditionTree = DBQueryBuilder::Type::ConditionTree;
+
+int main() {
+    sqlite3 *db = nullptr;
+    sqlite3_open(":memory:", &db);
+
+    try {
+        auto ignore = [](sqlite3_stmt *) {};
+        run(db, {"create table item(tenant text, id integer, payload text, primary key(tenant, id))", {}}, ignore);
+
+        //fill the table with 1000 rows, of 4 tenants
+        SQLiteBuilder filler;
+        filler.setTableName("item");
+        filler.setAction(DBQueryBuilder::Action::INSERT);
+        for (int id = 0; id < 1000; ++id) {
+            filler.addRow({{"tenant", std::string(1, static_cast<char>('a' + id % 4))}, {"id", std::to_string(id)},
+                           {"payload", "item-" + std::to_string(id)}});
+        }
+        for (const ParameterizedQuery &query : filler.buildParameterizedQueries()) {
+            run(db, query, ignore);
+        }
+
+        //scan the rows of the tenants "a" and "b", a page of 64 rows at a time
+        MYSQLBuilder builder;
+        builder.setTableName("item");
+        builder.setAction(DBQueryBuilder::Action::SELECT);
+        builder.setTargetColumns({"tenant", "id", "payload"});
+        ConditionTree tenants;
+        tenants.add(ConditionTree::Conjunction::AND, "tenant", ConditionTree::Operator::E, false, "a")
+                .add(ConditionTree::Conjunction::OR, "tenant", ConditionTree::Operator::E, false, "b");
+        builder.addConditions(tenants);
+
+        std::set<std::string> seen;
+        std::size_t returned = 0;
+        for (KeysetScanner scanner(builder, {"tenant", "id"}, 64); !scanner.done();) {
+            const ParameterizedQuery &page = scanner.query();
+            if (scanner.pages() < 2) {
+                std::cout << "Page " << scanner.pages() << ": " << page.sql << std::endl;
+            }
+
+            std::size_t rows = 0;
+            std::vector<std::string> lastKey(2);
+            run(db, page, [&](sqlite3_stmt *row) {
+                lastKey[0] = reinterpret_cast<const char *>(sqlite3_column_text(row, 0));
+                lastKey[1] = reinterpret_cast<const char *>(sqlite3_column_text(row, 1));
+                seen.insert(lastKey[0] + "/" + lastKey[1]);
+                ++rows;
+            });
+            returned += rows;
+
+            scanner.advance(rows, lastKey);
+            if (scanner.done()) {
+                std::cout << "Scanned: " << returned << " rows in " << scanner.pages() << " pages, "
+                          << (seen.size() == 500 && returned == 500 ? "each once" : "not each once") << std::endl;
+            }
+        }
+
+        //a full page must be followed by its last key, or the scan would restart from the first page, forever
+        KeysetScanner restarting(builder, {"tenant", "id"}, 64);
+        try {
+            restarting.advance(64, {});
+            std::cout << "\aError: a full page was advanced past without a key" << std::endl;
+        } catch (std::logic_error &error) {
+            std::cout << "Rejected: " << error.what() << std::endl;
+        }
+    } catch (std::exception &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    sqlite3_close(db);
+    return 0;
+}
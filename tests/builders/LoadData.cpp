@@ -0,0 +1,86 @@
+//
+// Created by fo on 21/04/2021.
+//
+// This file contains a use-case of the bulk-load of rows through "LOAD DATA LOCAL INFILE" by MYSQLBuilder: a TSV-file of
+// the rows added to the builder, and a CSV-file of the rows of a ColumnBatch, are compared byte for byte with the golden
+// files in the directory passed as the first argument, e.g. tests/builders/golden
+#include "../../builders/MYSQLBuilder.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using LoadDataFormat = DBQueryBuilder::Builder::LoadDataFormat;
+using ColumnBatch = DBQueryBuilder::Type::ColumnBatch;
+
+/**
+ * @brief: confirms whether or not the passed file is, byte for byte, the content of the passed golden file
+ */
+bool matchesGolden(const std::string &file, const std::string &path) {
+    std::ifstream golden(path, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(golden)), std::istreambuf_iterator<char>());
+
+    return golden.good() || golden.eof() ? file == content : false;
+}
+
+int main(int argc, char *argv[]) {
+    const std::string goldenDir = argc > 1 ? argv[1] : "tests/builders/golden";
+
+    try {
+        //the statements that disable the checks of keys around the load, then restore them
+        const int checks = MYSQLBuilder::UNIQUE_CHECKS | MYSQLBuilder::FOREIGN_KEY_CHECKS;
+        for (const std::string &statement : MYSQLBuilder::buildLoadDataPrologue(checks)) {
+            std::cout << "Prologue: " << statement << std::endl;
+        }
+
+        //load the rows added to the builder, ordered by their ids, as a TSV-file
+        MYSQLBuilder loader;
+        loader.setTableName("note");
+        loader.setBatchOrder("id");
+        loader.addRow({{"id", "2"}, {"name", "back\\slash"}, {"note", "line1\nline2"}});
+        loader.addRow({{"id", "1"}, {"name", "tab\there"}, {"note", "\\N"}});
+        loader.addRow({{"id", "3"}, {"name", ""}, {"note", std::string("nul\0byte", 8)}});
+        std::cout << "Statement: " << loader.buildLoadDataStatement("/tmp/note.tsv") << std::endl;
+
+        //the file, whole, then streamed in chunks of a few bytes
+        std::string file, streamed;
+        loader.buildLoadDataPayloadInto(file);
+        loader.streamLoadDataPayload([&](const char *chars, const std::size_t &count) { streamed.append(chars, count); },
+                                     LoadDataFormat(), 5);
+        if (!matchesGolden(file, goldenDir + "/load.tsv") || streamed != file) {
+            std::cout << "Error: the TSV-file differs from " << goldenDir << "/load.tsv" << std::endl;
+            return 1;
+        }
+
+        //load the rows of a ColumnBatch, with a NULL, as a CSV-file
+        const std::int64_t ids[] = {1, -2};
+        const double prices[] = {2.5, 0};
+        const bool nullPrices[] = {false, true};
+        const std::string names[] = {"say \"hi\", ok", "a\r\nb"};
+        ColumnBatch batch(2);
+        batch.addColumn("id", ids).addColumn("price", prices, nullPrices).addColumn("name", names);
+
+        LoadDataFormat csv;
+        csv.fieldTerminator = ",", csv.lineTerminator = "\r\n", csv.enclosure = '"';
+        std::cout << "CSV statement: " << loader.buildLoadDataStatement("/tmp/note.csv", batch, csv) << std::endl;
+
+        streamed.clear();
+        loader.streamLoadDataPayload(batch, [&](const char *chars, const std::size_t &count) {
+            streamed.append(chars, count);
+        }, csv, 7);
+        if (!matchesGolden(streamed, goldenDir + "/load.csv")) {
+            std::cout << "Error: the CSV-file differs from " << goldenDir << "/load.csv" << std::endl;
+            return 1;
+        }
+
+        for (const std::string &statement : MYSQLBuilder::buildLoadDataEpilogue(checks)) {
+            std::cout << "Epilogue: " << statement << std::endl;
+        }
+        std::cout << "Golden: the TSV and CSV files are identical" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
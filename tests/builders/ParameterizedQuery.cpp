@@ -0,0 +1,94 @@
+//
+// Created by fo on 30/03/2021.
+//
+// This file contains a use-case of the parameterized output of the builders: the same queries are built by every
+// dialect, each with its own placeholders, and the values are bound, unescaped, in order of appearance
+#include "../../factories/QueryBuilderCreator.h"
+#include "../../types/QueryCondition.h"
+#include <iostream>
+
+//perform type-aliasing for convenience
+namespace Factory = DBQueryBuilder::Factory;
+using ParameterizedQuery = DBQueryBuilder::Builder::ParameterizedQuery;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+
+/**
+ * @brief: returns the passed binds, each quoted by "[" and "]"
+ */
+std::string listed(const std::vector<std::string> &binds) {
+    std::string list;
+    for (const std::string &bind : binds) {
+        list += "[" + bind + "]";
+    }
+
+    return list;
+}
+
+/**
+ * @brief: prints the passed query, or an error if it is not the expected one
+ */
+void check(const std::string &label, const ParameterizedQuery &query, const std::string &sql,
+           const std::vector<std::string> &binds) {
+    if (query.sql == sql && query.binds == binds) {
+        std::cout << label << ": " << query.sql << " " << listed(query.binds) << std::endl;
+    } else {
+        std::cout << "\aError: " << label << ": \"" << query.sql << "\" " << listed(query.binds) << " instead of \"" << sql
+                  << "\" " << listed(binds) << std::endl;
+    }
+}
+
+int main() {
+    try {
+        //a select, with a composite guard-condition; the values need escaping, but are bound as they are
+        const std::string placeholders[3][3] = {{"?",  "?",  "?"},
+                                                {"$1", "$2", "$3"},
+                                                {"?1", "?2", "?3"}};
+        const std::string quotes[3] = {"`", "\"", "\""};
+        const Factory::Dialect dialects[3] = {Factory::MYSQL, Factory::POSTGRESQL, Factory::SQLITE};
+        const std::string labels[3] = {"MYSQL", "PostgreSQL", "SQLite"};
+        const std::string tails[3] = {"  ", "", ""};      //MYSQLBuilder keeps the spaces of the clauses not set
+
+        for (int d = 0; d < 3; ++d) {
+            const std::string &q = quotes[d];
+            const std::string *p = placeholders[d];
+            auto builder = Factory::makeQueryBuilder(dialects[d]);
+            builder->setTableName("CipherPackage");
+            builder->setAction(DBQueryBuilder::Action::SELECT);
+            builder->setTargetColumns({"clientId", "key"});
+            builder->addCondition(std::make_shared<QCondition>(QCondition::AND, "clientId", QCondition::E, false,
+                                                               "O'Reilly"));
+            builder->addCompositeCondition(
+                    {std::make_shared<QCondition>(QCondition::AND, "key", QCondition::L, true, "back\\slash"),
+                     std::make_shared<QCondition>(QCondition::OR, "id", QCondition::GE, false, "7")});
+            builder->setLimit(10);
+            check(labels[d] + " select", builder->buildParameterizedQuery(),
+                  "select  " + q + "clientId" + q + ", " + q + "key" + q + " from " + q + "CipherPackage" + q +
+                  " where  " + q + "clientId" + q + "=" + p[0] + " and ( not " + q + "key" + q + "<" + p[1] + " or " + q +
+                  "id" + q + ">=" + p[2] + ")  limit 10", {"O'Reilly", "back\\slash", "7"});
+
+            //an update binds the values of its row, then those of its guard-condition
+            builder->reset();
+            builder->setTableName("CipherPackage");
+            builder->setAction(DBQueryBuilder::Action::UPDATE);
+            builder->addResourceRep({{"key", "k\n1"}, {"cipherName", ""}});
+            builder->addCondition(std::make_shared<QCondition>(QCondition::AND, "id", QCondition::E, false, "3"));
+            check(labels[d] + " update", builder->buildParameterizedQuery(),
+                  "update " + q + "CipherPackage" + q + " set" + q + "cipherName" + q + "=" + p[0] + ", " + q + "key" +
+                  q + "=" + p[1] + " where  " + q + "id" + q + "=" + p[2] + tails[d], {"", "k\n1", "3"});
+
+            //appending a query keeps what the ParameterizedQuery already holds
+            ParameterizedQuery appended{"-- ", {"kept"}};
+            const std::size_t length = builder->buildParameterizedQueryInto(appended);
+            if (appended.sql.size() != 3 + length || appended.binds.size() != 4 || appended.binds.front() != "kept") {
+                std::cout << "\aError: " << labels[d] << " appended: \"" << appended.sql << "\" " << listed(appended.binds)
+                          << std::endl;
+            }
+        }
+
+        std::cout << "Checked: every parameterized query" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
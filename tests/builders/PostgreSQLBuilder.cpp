@@ -0,0 +1,77 @@
+//
+// Created by fo on 19/04/2021.
+//
+// This file contains a use-case of PostgreSQLBuilder: a query with numbered placeholders, then the bulk-load of rows
+// through "COPY", whose text and binary payloads are compared byte for byte with the golden files in the directory
+// passed as the first argument, e.g. tests/builders/golden
+#include "../../builders/PostgreSQLBuilder.h"
+#include "../../factories/QueryBuilderCreator.h"
+#include "../../types/QueryCondition.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+//perform type-aliasing for convenience
+namespace Factory = DBQueryBuilder::Factory;
+using PostgreSQLBuilder = DBQueryBuilder::Builder::PostgreSQLBuilder;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+
+/**
+ * @brief: confirms whether or not the passed payload is, byte for byte, the content of the passed golden file
+ */
+bool matchesGolden(const std::string &payload, const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    const std::string golden((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    return file.good() || file.eof() ? payload == golden : false;
+}
+
+int main(int argc, char *argv[]) {
+    const std::string goldenDir = argc > 1 ? argv[1] : "tests/builders/golden";
+
+    try {
+        //build a query, with its values replaced by numbered placeholders
+        auto builder = Factory::makeQueryBuilder(Factory::POSTGRESQL);
+        builder->setTableName("CipherPackage");
+        builder->setAction(DBQueryBuilder::Action::SELECT);
+        builder->setTargetColumns({"clientId", "key"});
+        builder->addCondition(std::make_shared<QCondition>(QCondition::AND, "clientId", QCondition::Operator::E, false,
+                                                           "O'Reilly"));
+        builder->addCondition(std::make_shared<QCondition>(QCondition::AND, "id", QCondition::Operator::GE, false, "7"));
+        builder->setOrder("clientId", DBQueryBuilder::Order::ASC);
+        builder->setLimit(10);
+        std::cout << "Query: " << builder->buildQuery() << std::endl;
+        std::cout << "Parameterized: " << builder->buildParameterizedQuery().sql << std::endl;
+
+        //load rows in bulk, ordered by their ids
+        PostgreSQLBuilder loader;
+        loader.setTableName("note");
+        loader.setBatchOrder("id");
+        loader.addRow({{"id", "2"}, {"name", "back\\slash"}, {"note", "line1\nline2\r"}});
+        loader.addRow({{"id", "10"}, {"name", ""}, {"note", "\\N"}});
+        loader.addRow({{"id", "1"}, {"name", "O'Reilly"}, {"note", "tab\there"}});
+        loader.addRow({{"id", "3"}, {"name", "Zo\xC3\xAB"}, {"note", "\b\f\v"}});
+        std::cout << "Command: " << loader.buildCopyCommand() << std::endl;
+        std::cout << "Binary command: " << loader.buildCopyCommand(PostgreSQLBuilder::BINARY) << std::endl;
+
+        for (const PostgreSQLBuilder::CopyFormat format : {PostgreSQLBuilder::TEXT, PostgreSQLBuilder::BINARY}) {
+            const std::string golden = goldenDir + (format == PostgreSQLBuilder::TEXT ? "/copy.txt" : "/copy.bin");
+
+            //the payload, whole, then streamed in chunks of a few bytes
+            std::string payload, streamed;
+            loader.buildCopyPayloadInto(payload, format);
+            loader.streamCopyPayload([&](const char *chars, const std::size_t &count) { streamed.append(chars, count); },
+                                     format, 7);
+
+            if (!matchesGolden(payload, golden) || streamed != payload) {
+                std::cout << "Error: the payload differs from " << golden << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "Golden: the text and binary payloads are identical" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
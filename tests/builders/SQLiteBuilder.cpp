@@ -0,0 +1,80 @@
+//
+// Created by fo on 20/04/2021.
+//
+// This file contains a use-case of SQLiteBuilder, whose queries are run against an in-memory SQLite-database: rows are
+// inserted one at a time, then in multi-row queries split by the number of variables a query may bind, then replaced,
+// and finally selected back
+#include "../../builders/SQLiteBuilder.h"
+#include "../../types/QueryCondition.h"
+#include "../SQLiteUseCase.h"
+#include <iostream>
+#include <stdexcept>
+
+//perform type-aliasing for convenience
+using SQLiteBuilder = DBQueryBuilder::Builder::SQLiteBuilder;
+using ParameterizedQuery = DBQueryBuilder::Builder::ParameterizedQuery;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+
+int main() {
+    sqlite3 *db = nullptr;
+    sqlite3_open(":memory:", &db);
+
+    try {
+        run(db, "create table note(id integer primary key, name text, body text)");
+
+        //insert a row, with its values in the text of the query
+        SQLiteBuilder builder;
+        builder.setTableName("note");
+        builder.setAction(DBQueryBuilder::Action::INSERT);
+        builder.addResourceRep({{"id", "1"}, {"name", "O'Reilly"}, {"body", "it's \"quoted\""}});
+        std::cout << "Query: " << builder.buildQuery() << std::endl;
+        run(db, builder.buildQuery());
+
+        //insert ten rows, in queries of at most seven variables, i.e. two rows of three columns each
+        builder.reset();
+        builder.setTableName("note");
+        builder.setAction(DBQueryBuilder::Action::INSERT);
+        builder.setMaxVariables(7);
+        for (int id = 2; id <= 11; ++id) {
+            builder.addRow({{"id", std::to_string(id)}, {"name", "name-" + std::to_string(id)}, {"body", "body"}});
+        }
+
+        const std::vector<ParameterizedQuery> queries = builder.buildParameterizedQueries();
+        std::cout << "Batch: " << queries.front().sql << std::endl;
+        for (const ParameterizedQuery &query : queries) {
+            run(db, query);
+        }
+
+        //replace the first row
+        builder.reset();
+        builder.setTableName("note");
+        builder.setAction(DBQueryBuilder::Action::INSERT);
+        builder.setConflict(SQLiteBuilder::REPLACE);
+        builder.addResourceRep({{"id", "1"}, {"name", "replaced"}, {"body", ""}});
+        std::cout << "Replace: " << builder.buildParameterizedQuery().sql << std::endl;
+        run(db, builder.buildParameterizedQuery());
+
+        //select the rows back
+        builder.reset();
+        builder.setTableName("note");
+        builder.setAction(DBQueryBuilder::Action::SELECT);
+        const int all = run(db, builder.buildQuery());
+        builder.addCondition(std::make_shared<QCondition>(QCondition::AND, "name", QCondition::Operator::E, false,
+                                                          "replaced"));
+        std::cout << "Select: " << builder.buildParameterizedQuery().sql << std::endl;
+        const int replaced = run(db, builder.buildParameterizedQuery());
+
+        if (queries.size() != 5 || all != 11 || replaced != 1) {
+            std::cout << "Error: " << queries.size() << " queries, " << all << " rows, " << replaced << " replaced"
+                      << std::endl;
+            sqlite3_close(db);
+            return 1;
+        }
+        std::cout << "Verified: 11 rows, in 5 queries of at most 7 variables, 1 replaced" << std::endl;
+    } catch (std::exception &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    sqlite3_close(db);
+    return 0;
+}
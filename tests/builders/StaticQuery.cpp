@@ -0,0 +1,93 @@
+//
+// Created by fo on 11/04/2021.
+//
+// This file contains a use-case of StaticQuery: a query of every action is composed at compile-time, rendered with its
+// values, and must read as the query that MYSQLBuilder builds for the same shape
+#include "../../builders/MYSQLBuilder.h"
+#include "../../builders/StaticQuery.h"
+#include "../UseCase.h"
+#include <iostream>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using QueryCondition = DBQueryBuilder::Type::QueryCondition;
+namespace Static = DBQueryBuilder::Builder::Static;
+
+int main() {
+    try {
+        //the guard-condition: `clientId`='...' and ( not `key`<'...' or `id`>='...')
+        constexpr auto where = Static::where(
+                Static::condition<QueryCondition::AND, QueryCondition::E>("clientId"),
+                Static::group(Static::condition<QueryCondition::AND, QueryCondition::L, true>("key"),
+                              Static::condition<QueryCondition::OR, QueryCondition::GE>("id")));
+        auto conditions = [](MYSQLBuilder &builder) {
+            builder.addCondition(std::make_shared<QueryCondition>(QueryCondition::AND, "clientId", QueryCondition::E,
+                                                                  false, "it's"));
+            builder.addCompositeCondition(
+                    {std::make_shared<QueryCondition>(QueryCondition::AND, "key", QueryCondition::L, true, "k"),
+                     std::make_shared<QueryCondition>(QueryCondition::OR, "id", QueryCondition::GE, false, "7")});
+        };
+
+        //select, with every clause
+        constexpr auto select = Static::select(Static::columns("clientId", "key"), "CipherPackage", where,
+                                               Static::orderBy<DBQueryBuilder::Order::DEC>("id"), Static::limit<25>());
+        static_assert(decltype(select)::slots() == 3, "the select-query has a slot per value of its guard-condition");
+        MYSQLBuilder builder;
+        builder.setTableName("CipherPackage");
+        builder.setAction(DBQueryBuilder::Action::SELECT);
+        builder.setTargetColumns({"clientId", "key"});
+        conditions(builder);
+        builder.setOrder("id", DBQueryBuilder::Order::DEC);
+        builder.setLimit(25);
+        check("Select", select.render("it's", "k", "7"), builder.buildQuery());
+
+        //select of every column, without a clause
+        builder.reset();
+        builder.setTableName("CipherPackage");
+        builder.setAction(DBQueryBuilder::Action::SELECT);
+        check("Select all", Static::select(Static::columns(), "CipherPackage").render(), builder.buildQuery());
+
+        //insert of a single row; the columns are in the order of MYSQLBuilder's, i.e. by name
+        constexpr auto insert = Static::insert("CipherPackage", Static::columns("cipherName", "clientId"));
+        builder.reset();
+        builder.setTableName("CipherPackage");
+        builder.setAction(DBQueryBuilder::Action::INSERT);
+        builder.addResourceRep({{"clientId", "0"}, {"cipherName", "AES\\256"}});
+        check("Insert", insert.render("AES\\256", "0"), builder.buildQuery());
+        check("Parameterized", std::string(insert.parameterized().text()), builder.buildParameterizedQuery().sql);
+
+        //update, with every clause
+        constexpr auto update = Static::update("CipherPackage", Static::columns("cipherName"), where,
+                                               Static::orderBy<DBQueryBuilder::Order::ASC>("id"), Static::limit<1>());
+        builder.reset();
+        builder.setTableName("CipherPackage");
+        builder.setAction(DBQueryBuilder::Action::UPDATE);
+        builder.addResourceRep({{"cipherName", "ChaCha20"}});
+        conditions(builder);
+        builder.setOrder("id", DBQueryBuilder::Order::ASC);
+        builder.setLimit(1);
+        check("Update", update.render("ChaCha20", "it's", "k", "7"), builder.buildQuery());
+
+        //delete, with a guard-condition only
+        constexpr auto remove = Static::remove("CipherPackage", where);
+        builder.reset();
+        builder.setTableName("CipherPackage");
+        builder.setAction(DBQueryBuilder::Action::DELETE);
+        conditions(builder);
+        check("Delete", remove.render("it's", "k", "7"), builder.buildQuery());
+
+        //a query is appended to the buffer it is rendered into
+        std::string buffer = "-- ";
+        const std::size_t appended = remove.renderInto(buffer, "it's", "k", "7");
+        check("Appended", buffer, "-- " + builder.buildQuery());
+        if (appended != buffer.size() - 3) {
+            std::cout << "\aError: " << appended << " characters appended, of " << buffer.size() - 3 << std::endl;
+        }
+
+        std::cout << "Checked: every static query" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
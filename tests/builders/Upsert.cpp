@@ -0,0 +1,69 @@
+//
+// Created by fo on 22/04/2021.
+//
+// This file contains a use-case of the "UPSERT" queries of MYSQLBuilder: rows that are inserted, or merged into the rows
+// already held with the same keys, a batch per query
+#include "../../builders/MYSQLBuilder.h"
+#include "../UseCase.h"
+#include <iostream>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+
+static const std::string head = "insert into `PageView`(`lastSeen`, `page`, `title`, `views`) values";
+static const std::string rows[3] = {"('2021-04-22 10:00:00', '/', 'Home', '3')", "('2021-04-22 10:05:00', '/about', 'About', '1')",
+                                    "('2021-04-22 09:55:00', '/blog', 'Blog', '7')"};
+static const std::string aliased = " as `new` on duplicate key update `views` = `views` + `new`.`views`, `lastSeen` = "
+                                   "greatest(`lastSeen`, `new`.`lastSeen`), `title` = `new`.`title`";
+
+int main() {
+    try {
+        //merge the counters of page-views, keeping the latest time of a view
+        MYSQLBuilder builder;
+        builder.setTableName("PageView");
+        builder.setAction(DBQueryBuilder::Action::UPSERT);
+        builder.addUpsertColumn("views", MYSQLBuilder::ADD);
+        builder.addUpsertColumn("lastSeen", MYSQLBuilder::GREATEST);
+        builder.addUpsertColumn("title");
+        builder.addRow({{"page", "/"}, {"views", "3"}, {"lastSeen", "2021-04-22 10:00:00"}, {"title", "Home"}});
+        builder.addRow({{"page", "/about"}, {"views", "1"}, {"lastSeen", "2021-04-22 10:05:00"}, {"title", "About"}});
+        builder.addRow({{"page", "/blog"}, {"views", "7"}, {"lastSeen", "2021-04-22 09:55:00"}, {"title", "Blog"}});
+        check("Upsert", builder.buildQuery(), head + rows[0] + ", " + rows[1] + ", " + rows[2] + " on duplicate key update "
+                                              "`views` = `views` + values(`views`), `lastSeen` = greatest(`lastSeen`, "
+                                              "values(`lastSeen`)), `title` = values(`title`)");
+
+        //the same rows, in batches of two, referring to them through the row-alias
+        builder.setUpsertSyntax(MYSQLBuilder::ROW_ALIAS);
+        builder.setBatchLimits(0, 2);
+        const std::vector<std::string> batches = builder.buildQueries();
+        check("Batches", std::to_string(batches.size()), "2");
+        check("Batch", batches.front(), head + rows[0] + ", " + rows[1] + aliased);
+        check("Batch", batches.back(), head + rows[2] + aliased);
+        check("Parameterized", builder.buildParameterizedQuery().sql,
+              head + "(?, ?, ?, ?), (?, ?, ?, ?), (?, ?, ?, ?)" + aliased);
+
+        //every column is overwritten, unless some are chosen
+        builder.reset();
+        builder.setTableName("PageView");
+        builder.setAction(DBQueryBuilder::Action::UPSERT);
+        builder.addRow({{"page", "/"}, {"title", "Home"}});
+        check("Overwrite", builder.buildQuery(), "insert into `PageView`(`page`, `title`) values('/', 'Home') on duplicate "
+                                                 "key update `page` = values(`page`), `title` = values(`title`)");
+
+        //a column that the rows do not hold cannot be updated
+        builder.addUpsertColumn("views", MYSQLBuilder::ADD);
+        try {
+            builder.buildQuery();
+            std::cout << "\aError: an upsert-column that the rows do not hold was not rejected" << std::endl;
+        } catch (std::logic_error &error) {
+            check("Rejected", error.what(), "In Builder::MYSQLBuilder::Core::buildDuplicateKeyUpdate: the upsert-column "
+                                            "\"views\" is not a column of the Resource-representations");
+        }
+
+        std::cout << "Checked: every upsert" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+//
+// Created by fo on 15/04/2021.
+//
+// This file contains a use-case of the allocation-accounting of MYSQLBuilder and QueryCondition: a builder that is
+// reused, with a reused buffer, is held to a budget of no allocation per query; the accounting is only compiled when
+// DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS is defined, e.g. through the CMake-option of the same name, and the use-case is
+// skipped without it
+#include "../../builders/MYSQLBuilder.h"
+#include "../../types/CompQueryCondition.h"
+#include <iostream>
+
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+using CQCondition = DBQueryBuilder::Type::CompQueryCondition;
+using AllocationStats = DBQueryBuilder::Diagnostics::AllocationStats;
+
+static void print(const char *name, const AllocationStats &stats) {
+    std::cout << name << ": " << stats.operations << " operations, " << stats.allocations << " allocations ("
+              << stats.bytesAllocated << " bytes), " << stats.deallocations << " deallocations ("
+              << stats.bytesDeallocated << " bytes), peak " << stats.peakBytes << " bytes, retained "
+              << stats.retainedCapacity << " bytes (peak " << stats.peakRetainedCapacity << "), "
+              << stats.stringReallocations << " string-reallocations" << std::endl;
+}
+
+int main() {
+    MYSQLBuilder builder;
+    std::string query;
+
+    QCondition::Ptr condition = std::make_shared<CQCondition>(std::vector<QCondition::Ptr>{
+            std::make_shared<QCondition>(QCondition::AND, "clientId", QCondition::Operator::E, false, "17"),
+            std::make_shared<QCondition>(QCondition::OR, "cipherName", QCondition::Operator::E, true, "aes-128-cbc")});
+
+    try {
+        //the first query acquires all the memory that the builder and the buffer need
+        for (int i = 0; i < 3; ++i) {
+            if (i == 1) {
+                builder.resetAllocationStats();
+            }
+
+            builder.reset();
+            builder.setTableName("CipherPackage");
+            builder.setAction(DBQueryBuilder::Action::SELECT);
+            builder.setTargetColumns({"clientId", "cipherName"});
+            builder.addCondition(condition);
+            builder.setLimit(10);
+
+            query.clear();
+            builder.buildQueryInto(query);
+        }
+        std::cout << "Query: " << query << std::endl;
+
+        const std::string rendered = condition->toString(true);
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+        return 1;
+    }
+
+    if (!AllocationStats::enabled) {
+        std::cout << "Skipped: allocations are not being accounted; define DBQUERYBUILDER_INSTRUMENT_ALLOCATIONS to "
+                     "account them" << std::endl;
+        return 0;
+    }
+
+    const AllocationStats stats = builder.allocationStats();
+    print("MYSQLBuilder, warm", stats);
+    print("QueryCondition::toString", DBQueryBuilder::Diagnostics::conditionRendering().stats());
+
+    if (stats.allocations != 0 || stats.stringReallocations != 0) {     //the budget of a warm builder is exceeded
+        std::cout << "Over budget" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Within budget" << std::endl;
+    return 0;
+}
@@ -0,0 +1,56 @@
+//
+// Created by fo on 16/04/2021.
+//
+// This file contains a use-case of the latency-accounting of the stages of MYSQLBuilder: queries are built on several
+// threads, then the histograms of all of them are merged, and exported in the text-format of Prometheus; the stages are
+// only timed when DBQUERYBUILDER_INSTRUMENT_LATENCY is defined, e.g. through the CMake-option of the same name
+#include "../../builders/MYSQLBuilder.h"
+#include "../../diagnostics/Latency.h"
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+namespace Diagnostics = DBQueryBuilder::Diagnostics;
+
+int main() {
+    const int threads = 4, queries = 1000;
+
+    std::vector<std::thread> workers;
+    for (int thread = 0; thread < threads; ++thread) {
+        workers.emplace_back([]() {
+            MYSQLBuilder builder;
+            std::string query;
+            for (int i = 0; i < queries; ++i) {
+                builder.reset();
+                builder.setTableName("CipherPackage");
+                builder.setAction(i % 2 == 0 ? DBQueryBuilder::Action::SELECT : DBQueryBuilder::Action::DELETE);
+                builder.addCondition(std::make_shared<QCondition>(QCondition::AND, "clientId", QCondition::Operator::E,
+                                                                  false, std::to_string(i)));
+                builder.setOrder("clientId", DBQueryBuilder::Order::ASC);
+
+                query.clear();
+                builder.buildQueryInto(query);
+            }
+        });
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    const Diagnostics::LatencySnapshot snapshot = Diagnostics::latencySnapshot();
+    std::cout << Diagnostics::toPrometheus(snapshot);
+
+#ifdef DBQUERYBUILDER_INSTRUMENT_LATENCY
+    //every build is recorded once, whatever the number of passes through its stages
+    if (snapshot[Diagnostics::BUILD_QUERY].count() != threads * queries ||
+        snapshot[Diagnostics::SELECT_CLAUSE].count() != threads * queries / 2) {
+        std::cout << "Error: the builds were not all recorded" << std::endl;
+        return 1;
+    }
+    std::cout << "p99 of a build: " << snapshot[Diagnostics::BUILD_QUERY].percentile(0.99) << " ns" << std::endl;
+#endif
+
+    return 0;
+}
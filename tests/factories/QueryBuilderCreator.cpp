@@ -0,0 +1,76 @@
+//
+// Created by fo on 17/04/2021.
+//
+// This file contains a use-case of the factory-functions: builders are created by dialect, by name, and from the
+// free-list of the calling thread, including builders of a dialect registered at startup, which are handed out
+// again as the prototype of the dialect once they are released
+#include "../../factories/QueryBuilderCreator.h"
+#include "../../builders/MYSQLBuilder.h"
+#include <iostream>
+#include <thread>
+
+//perform type-aliasing for convenience
+namespace Factory = DBQueryBuilder::Factory;
+using IQueryBuilder = DBQueryBuilder::Builder::IQueryBuilder;
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+
+int main() {
+    try {
+        //register, at startup, a dialect whose builders are cloned from a pre-configured MYSQLBuilder
+        auto prototype = std::make_unique<MYSQLBuilder>();
+        prototype->setTableName("audit");
+        prototype->setAction(DBQueryBuilder::Action::DELETE);
+        prototype->reserve(8, 1, 4, 256);
+        const Factory::Dialect audit = Factory::DialectRegistry::instance().add("audit", std::move(prototype));
+
+        //create a builder by dialect
+        auto builder = Factory::makeQueryBuilder(Factory::MYSQL);
+        builder->setTableName("CipherPackage");
+        builder->setAction(DBQueryBuilder::Action::SELECT);
+        std::cout << "MYSQL: " << builder->buildQuery() << std::endl;
+
+        //create a builder by name, and from the free-list of this thread
+        auto cloned = Factory::makeQueryBuilder("AUDIT");
+        cloned->addCondition(std::make_shared<QCondition>(QCondition::AND, "createdAt", QCondition::Operator::L, false,
+                                                          "2021-01-01"));
+        std::cout << "Audit: " << cloned->buildQuery() << std::endl;
+
+        //a pooled builder is changed, released, and handed out again as the prototype of its dialect
+        const std::string expected = Factory::makeQueryBuilder(audit)->buildQuery();
+        IQueryBuilder *first;
+        {
+            auto pooled = Factory::makePooledQueryBuilder(audit);
+            first = pooled.get();
+            std::cout << "Pooled audit: " << pooled->buildQuery() << std::endl;
+            pooled->setTableName("session");
+            pooled->addCondition(std::make_shared<QCondition>(QCondition::AND, "id", QCondition::Operator::E, false,
+                                                              "7"));
+        }
+        {
+            auto pooled = Factory::makePooledQueryBuilder(audit);
+            const std::string query = pooled->buildQuery();
+            if (pooled.get() != first || query != expected) {
+                std::cout << "\aError: the re-acquired audit-builder holds: " << query << std::endl;
+                return 1;
+            }
+            std::cout << "Re-acquired audit: " << query << std::endl;
+        }
+
+        //a pooled builder held by a thread_local, constructed before the free-lists of its thread, outlives them
+        std::thread([&audit]() {
+            thread_local Factory::PooledQueryBuilder held;
+            Factory::makePooledQueryBuilder(audit).reset();      //the free-list of the dialect is allocated
+            held = Factory::makePooledQueryBuilder(audit);
+            held->setTableName("session");
+        }).join();
+        std::cout << "Outlived: the free-lists of its thread" << std::endl;
+
+        //an unknown dialect is reported
+        Factory::makeQueryBuilder("oracle");
+    } catch (std::logic_error &error) {
+        std::cout << "Unknown dialect: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
@@ -5,8 +5,8 @@
 #include "../../types/CompQueryCondition.h"
 #include <iostream>
 
-using QueryCondition = DBQueryManager::Type::QueryCondition;
-using CompQueryCondition = DBQueryManager::Type::CompQueryCondition;
+using QueryCondition = DBQueryBuilder::Type::QueryCondition;
+using CompQueryCondition = DBQueryBuilder::Type::CompQueryCondition;
 
 int main() {
     //initialize two Query-conditions
@@ -20,6 +20,17 @@ int main() {
         //output the composite QueryCondition with the first conjunction showing
         std::cout << "With conjunction: " << condition3->toString(true) << std::endl;
         std::cout << "Without conjunction: " << condition3->toString(false) << std::endl;
+
+        //the components are escaped, however deeply they are nested
+        QueryCondition::Ptr injected(new QueryCondition(QueryCondition::OR, "a`b", QueryCondition::Operator::E, false,
+                                                        "x' or '1'='1"));
+        const std::string escaped = CompQueryCondition({condition, std::make_shared<CompQueryCondition>(
+                std::vector<QueryCondition::Ptr>{injected})}).toString(false);
+        if (escaped != "( not `clientId`>='1' or ( `a``b`='x\\' or \\'1\\'=\\'1'))") {
+            std::cout << "\aError: a component was not escaped: " << escaped << std::endl;
+        } else {
+            std::cout << "Escaped: " << escaped << std::endl;
+        }
     } catch (std::logic_error &error) {
         std::cout << "\aError: " << error.what() << std::endl;
     }
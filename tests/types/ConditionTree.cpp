@@ -0,0 +1,101 @@
+//
+// Created by fo on 12/04/2021.
+//
+// This file contains a use-case of ConditionTree: nested guard-conditions are built as a ConditionTree, and from the
+// equivalent QueryConditions, and must render, through MYSQLBuilder, as the same "where"-clause; a copied ConditionTree
+// must keep its guard-conditions when the original is discarded
+#include "../../builders/MYSQLBuilder.h"
+#include "../../types/CompQueryCondition.h"
+#include "../../types/ConditionTree.h"
+#include "../UseCase.h"
+#include <iostream>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using ConditionTree = DBQueryBuilder::Type::ConditionTree;
+using QueryCondition = DBQueryBuilder::Type::QueryCondition;
+using CompQueryCondition = DBQueryBuilder::Type::CompQueryCondition;
+
+static const std::string expected = "delete from `client` where  `a`='1' and ( not `b`<'it\\'s' or ( `c`>='3' and `d`<='4')) "
+                                    "or `e`>'5'  ";
+
+/**
+ * @brief: returns the "DELETE" query guarded by the passed ConditionTree
+ */
+std::string build(const ConditionTree &conditions) {
+    MYSQLBuilder builder;
+    builder.setTableName("client");
+    builder.setAction(DBQueryBuilder::Action::DELETE);
+    builder.addConditions(conditions);
+
+    return builder.buildQuery();
+}
+
+int main() {
+    try {
+        //`a`='1' and ( not `b`<'it\'s' or ( `c`>='3' and `d`<='4')) or `e`>'5'
+        ConditionTree tree;
+        tree.add(ConditionTree::Conjunction::AND, "a", ConditionTree::Operator::E, false, "1")
+                .openGroup()
+                .add(ConditionTree::Conjunction::AND, "b", ConditionTree::Operator::L, true, "it's")
+                .openGroup()
+                .add(ConditionTree::Conjunction::OR, "c", ConditionTree::Operator::GE, false, "3")
+                .add(ConditionTree::Conjunction::AND, "d", ConditionTree::Operator::LE, false, "4")
+                .closeGroup()
+                .closeGroup()
+                .add(ConditionTree::Conjunction::OR, "e", ConditionTree::Operator::G, false, "5");
+        check("Tree", build(tree), expected);
+
+        //a group adopts the conjunction of its first component, and holds its components as the nodes after it
+        std::string structure;
+        for (const ConditionTree::Node &node : tree.nodes()) {
+            structure += (node.composite ? "(" : std::string(tree.field(node)) + std::string(tree.value(node))) +
+                         (node.conjunction == ConditionTree::Conjunction::AND ? "&" : "|") + std::to_string(node.end) + " ";
+        }
+        check("Nodes", structure, "a1&1 (&6 bit's&3 (|6 c3|5 d4&6 e5|7 ");
+
+        //the same guard-conditions, as QueryConditions, through the builder and through the ConditionTree
+        auto a = std::make_shared<QueryCondition>(QueryCondition::AND, "a", QueryCondition::E, false, "1");
+        auto b = std::make_shared<QueryCondition>(QueryCondition::AND, "b", QueryCondition::L, true, "it's");
+        auto c = std::make_shared<QueryCondition>(QueryCondition::OR, "c", QueryCondition::GE, false, "3");
+        auto d = std::make_shared<QueryCondition>(QueryCondition::AND, "d", QueryCondition::LE, false, "4");
+        auto e = std::make_shared<QueryCondition>(QueryCondition::OR, "e", QueryCondition::G, false, "5");
+        auto group = std::make_shared<CompQueryCondition>(
+                std::vector<QueryCondition::Ptr>{b, std::make_shared<CompQueryCondition>(std::vector<QueryCondition::Ptr>{c, d})});
+
+        MYSQLBuilder builder;
+        builder.setTableName("client");
+        builder.setAction(DBQueryBuilder::Action::DELETE);
+        builder.addCondition(a);
+        builder.addCondition(group);
+        builder.addCondition(e);
+        check("Conditions", builder.buildQuery(), expected);
+
+        ConditionTree converted;
+        converted.add(*a).add(*group).add(*e);
+        check("Converted", build(converted), expected);
+
+        //a ConditionTree is a value: the copy keeps its guard-conditions, and appending joins two trees
+        ConditionTree copied = tree;
+        tree.clear();
+        check("Copied", build(copied), expected);
+        ConditionTree head, tail;
+        head.add(*a).add(*group);
+        tail.add(*e);
+        check("Appended", build(head.append(tail)), expected);
+
+        //a group must be complete, and not empty
+        check("Unopened", rejection([]() { ConditionTree().closeGroup(); }),
+              "In Type::ConditionTree::closeGroup: no group is open");
+        check("Empty", rejection([]() { ConditionTree().openGroup().closeGroup(); }),
+              "In Type::ConditionTree::closeGroup: empty group");
+        check("Open", rejection([&]() { ConditionTree open; open.openGroup(); head.append(open); }),
+              "In Type::ConditionTree::append: the appended ConditionTree has an open group");
+
+        std::cout << "Checked: every condition-tree" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
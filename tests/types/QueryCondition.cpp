@@ -5,7 +5,7 @@
 #include "../../types/QueryCondition.h"
 #include <iostream>
 
-using QueryCondition = DBQueryManager::Type::QueryCondition;
+using QueryCondition = DBQueryBuilder::Type::QueryCondition;
 
 int main() {
     //create a new QueryCondition
@@ -14,6 +14,15 @@ int main() {
     try {
         //output the string-form of the query
         std::cout << condition->toString(true) << std::endl;
+
+        //a field and a value that would end their quotes are escaped
+        const std::string escaped = QueryCondition(QueryCondition::AND, "na`me", QueryCondition::Operator::E, false,
+                                                   "x' or '1'='1").toString(false);
+        if (escaped != " `na``me`='x\\' or \\'1\\'=\\'1'") {
+            std::cout << "\aError: the field or the value was not escaped: " << escaped << std::endl;
+        } else {
+            std::cout << "Escaped:" << escaped << std::endl;
+        }
     } catch (std::logic_error &error) {
         std::cout << "\aError: " << error.what() << std::endl;
     }
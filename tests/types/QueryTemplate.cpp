@@ -0,0 +1,108 @@
+//
+// Created by fo on 12/04/2021.
+//
+// This file contains a use-case of QueryTemplate: the shape of a query is compiled once by MYSQLBuilder, then rendered
+// by a few threads at once, each with its own values, and every query must read as the one that MYSQLBuilder builds for
+// the same values
+#include "../../builders/MYSQLBuilder.h"
+#include "../../types/QueryCondition.h"
+#include "../../types/TemplateCache.h"
+#include "../UseCase.h"
+#include <iostream>
+#include <thread>
+#include <vector>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+using QueryTemplate = DBQueryBuilder::Type::QueryTemplate;
+
+/**
+ * @brief: sets the passed builder to the "UPDATE" query of the passed values: the cipher-name, then the client-id and
+ * the id
+ */
+void prepare(MYSQLBuilder &builder, const std::string &cipherName, const std::string &clientId, const std::string &id) {
+    builder.setTableName("CipherPackage");
+    builder.setAction(DBQueryBuilder::Action::UPDATE);
+    builder.addResourceRep({{"cipherName", cipherName}});
+    builder.addCondition(std::make_shared<QCondition>(QCondition::AND, "clientId", QCondition::E, false, clientId));
+    builder.addCondition(std::make_shared<QCondition>(QCondition::OR, "id", QCondition::GE, true, id));
+    builder.setLimit(1);
+}
+
+std::string build(const std::string &cipherName, const std::string &clientId, const std::string &id) {
+    MYSQLBuilder builder;
+    prepare(builder, cipherName, clientId, id);
+
+    return builder.buildQuery();
+}
+
+QueryTemplate::Ptr compile(const std::string &cipherName, const std::string &clientId, const std::string &id) {
+    MYSQLBuilder builder;
+    prepare(builder, cipherName, clientId, id);
+
+    return builder.compile();
+}
+
+int main() {
+    try {
+        //the values of the row come first, then those of the guard-conditions
+        MYSQLBuilder compiler;
+        prepare(compiler, "aes", "0", "7");
+        const QueryTemplate::Ptr qTemplate = compiler.compile();
+        check("Slots", std::to_string(qTemplate->slots()), "3");
+        std::string rendered;
+        qTemplate->render({"aes", "0", "7"}, rendered);
+        check("Rendered", rendered, compiler.buildQuery());
+
+        //the QueryTemplate does not change with the builder that compiled it
+        compiler.setLimit(2);
+        qTemplate->render({"O'Reilly\n", "", "\\"}, rendered);
+        check("Kept", rendered, build("O'Reilly\n", "", "\\"));
+
+        //a few threads render the same QueryTemplate at once, each into its own buffer
+        const std::size_t threads = 4, perThread = 500;
+        std::vector<std::size_t> mismatches(threads, 0);
+        std::vector<std::thread> renderers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            renderers.emplace_back([&, t]() {
+                std::string query;
+                for (std::size_t i = 0; i < perThread; ++i) {
+                    const std::string cipherName = "cipher-" + std::to_string(t), id = std::to_string(i);
+                    qTemplate->render({cipherName, "it's", id}, query);
+                    mismatches[t] += query != "update `CipherPackage` set`cipherName`='" + cipherName +
+                                              "' where  `clientId`='it\\'s' or not `id`>='" + id + "'  limit 1";
+                }
+            });
+        }
+        std::size_t mismatched = 0;
+        for (std::size_t t = 0; t < threads; ++t) {
+            renderers[t].join();
+            mismatched += mismatches[t];
+        }
+        check("Concurrent", std::to_string(mismatched) + " of " + std::to_string(threads * perThread) + " mismatched",
+              "0 of " + std::to_string(threads * perThread) + " mismatched");
+
+        //a cached shape is compiled into the QueryTemplate that the cache already shares
+        auto &cache = DBQueryBuilder::Type::TemplateCache::instance();
+        cache.setCapacity(4);
+        const bool shared = compile("a", "b", "c") == compile("d", "e", "f");
+        cache.setCapacity(0);
+        check("Shared", shared ? "one QueryTemplate" : "two QueryTemplates", "one QueryTemplate");
+
+        //the values must fill the slots exactly
+        try {
+            qTemplate->render({"aes", "0"}, rendered);
+            std::cout << "\aError: too few values were not rejected" << std::endl;
+        } catch (std::logic_error &error) {
+            check("Rejected", error.what(),
+                  "In Type::QueryTemplate::render: the number of values does not match the number of slots");
+        }
+
+        std::cout << "Checked: every rendered template" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+//
+// Created by fo on 02/04/2021.
+//
+// This file contains a use-case of TemplateCache: queries of a few shapes are built by MYSQLBuilder, through a cache
+// that holds two shapes, and must read as the queries built without it, while the cache counts its hits, misses and
+// evictions
+#include "../../builders/MYSQLBuilder.h"
+#include "../../types/QueryCondition.h"
+#include "../../types/TemplateCache.h"
+#include <iostream>
+
+//perform type-aliasing for convenience
+using MYSQLBuilder = DBQueryBuilder::Builder::MYSQLBuilder;
+using QCondition = DBQueryBuilder::Type::QueryCondition;
+using TemplateCache = DBQueryBuilder::Type::TemplateCache;
+
+/**
+ * @brief: returns the query of the passed shape, with the passed value
+ * @param shape: 0, a select by id; 1, a select by name; 2, a delete by id
+ */
+std::string build(const int &shape, const std::string &value) {
+    MYSQLBuilder builder;
+    builder.setTableName("client");
+    builder.setAction(shape == 2 ? DBQueryBuilder::Action::DELETE : DBQueryBuilder::Action::SELECT);
+    builder.addCondition(std::make_shared<QCondition>(QCondition::AND, shape == 1 ? "name" : "id", QCondition::E, false,
+                                                      value));
+
+    return builder.buildQuery();
+}
+
+/**
+ * @brief: prints the counters of the cache, or an error if they are not the expected ones
+ */
+void check(const std::string &label, const std::uint64_t &hits, const std::uint64_t &misses,
+           const std::uint64_t &evictions, const std::size_t &size) {
+    const TemplateCache::Stats stats = TemplateCache::instance().stats();
+    const std::string counted = std::to_string(stats.hits) + " hits, " + std::to_string(stats.misses) + " misses, " +
+                                std::to_string(stats.evictions) + " evictions, " + std::to_string(stats.size) + " held";
+    const std::string expected = std::to_string(hits) + " hits, " + std::to_string(misses) + " misses, " +
+                                 std::to_string(evictions) + " evictions, " + std::to_string(size) + " held";
+    if (counted == expected) {
+        std::cout << label << ": " << counted << std::endl;
+    } else {
+        std::cout << "\aError: " << label << ": " << counted << " instead of " << expected << std::endl;
+    }
+}
+
+int main() {
+    try {
+        //the queries, built while the cache is disabled
+        const std::string values[2] = {"O'Reilly", "7"};
+        std::string uncached[3][2];
+        for (int shape = 0; shape < 3; ++shape) {
+            for (int v = 0; v < 2; ++v) {
+                uncached[shape][v] = build(shape, values[v]);
+            }
+        }
+        check("Disabled", 0, 0, 0, 0);
+
+        //the first query of a shape misses and caches it; any later query of that shape hits, whatever its value
+        TemplateCache &cache = TemplateCache::instance();
+        cache.setCapacity(2);
+        auto cached = [&](const int &shape, const int &v) {
+            const std::string query = build(shape, values[v]);
+            if (query != uncached[shape][v]) {
+                std::cout << "\aError: \"" << query << "\" instead of \"" << uncached[shape][v] << "\"" << std::endl;
+            }
+        };
+        cached(0, 0);
+        check("Missed", 0, 1, 0, 1);
+        cached(0, 1);
+        cached(0, 0);
+        check("Hit", 2, 1, 0, 1);
+
+        //a third shape evicts the least recently used one
+        cached(1, 0);
+        cached(2, 1);
+        check("Evicted", 2, 3, 1, 2);
+        cached(1, 1);
+        cached(2, 0);
+        check("Kept", 4, 3, 1, 2);
+
+        //a shrunk cache evicts down to its new capacity, and a disabled one holds nothing
+        cache.setCapacity(1);
+        check("Shrunk", 4, 3, 2, 1);
+        cache.setCapacity(0);
+        check("Emptied", 4, 3, 3, 0);
+        cached(0, 1);
+        check("Bypassed", 4, 3, 3, 0);
+
+        std::cout << "Checked: every cached shape" << std::endl;
+    } catch (std::logic_error &error) {
+        std::cout << "\aError: " << error.what() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+//
+// Created by fo on 09/04/2021.
+//
+// This file contains a use-case of Escaper: values of every length up to a few vector-widths, from any alignment, with
+// a byte that needs escaping at every position, are escaped by every implementation that the processor supports, and
+// must read as the escaping of a byte at a time
+#include "../../utils/Escaper.h"
+#include <iostream>
+#include <string>
+
+//perform type-aliasing for convenience
+using Escaper = DBQueryBuilder::Util::Escaper;
+
+/**
+ * @brief: returns the passed value, escaped as the body of a MYSQL string-literal, a byte at a time
+ */
+std::string reference(const std::string &value) {
+    std::string escaped;
+    for (const char &byte : value) {
+        switch (byte) {
+            case '\0': escaped += "\\0"; break;
+            case '\b': escaped += "\\b"; break;
+            case '\t': escaped += "\\t"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\x1A': escaped += "\\Z"; break;
+            case '\'': escaped += "\\'"; break;
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            default: escaped += byte;
+        }
+    }
+
+    return escaped;
+}
+
+/**
+ * @brief: escapes the passed value with the implementation in use, and confirms whether or not it reads as the
+ * reference, without writing beyond its length
+ */
+bool escapes(const std::string &value, const std::string &expected) {
+    if (Escaper::literalLength(value.data(), value.size()) != expected.size()) {
+        return false;
+    }
+
+    std::string out(expected.size() + 1, '#');      //the last character guards against writing beyond the length
+    const char *end = Escaper::escapeLiteral(value.data(), value.size(), &out[0]);
+
+    return end == out.data() + expected.size() && out.compare(0, expected.size(), expected) == 0 && out.back() == '#';
+}
+
+int main() {
+    const char specials[] = {'\0', '\b', '\t', '\n', '\r', '\x1A', '\'', '"', '\\'};
+    const char plains[] = {'a', '`', '\x7F', '\x80', '\xFF', '\x1B', '%'};      //bytes that are copied as they are
+    const Escaper::Level levels[] = {Escaper::SCALAR, Escaper::SSE2, Escaper::AVX2};
+    const char *names[] = {"scalar", "SSE2", "AVX2"};
+    std::size_t failures = 0, values = 0;
+
+    for (const Escaper::Level &requested : levels) {
+        if (Escaper::setLevel(requested) != requested) {     //the processor does not support it
+            std::cout << "Unsupported: " << names[requested] << std::endl;
+            continue;
+        }
+
+        //the values are cut from a buffer at every offset within a vector-width, so that loads are unaligned too
+        std::string buffer(128, 'x');
+        for (std::size_t offset = 0; offset < 4; ++offset) {
+            for (std::size_t length = 0; length <= 70; ++length) {
+                //no byte, every byte, and a byte at every position, needing escaping
+                std::string value = buffer.substr(offset, length);
+                failures += !escapes(value, reference(value));
+                failures += !escapes(std::string(length, '\\'), reference(std::string(length, '\\')));
+                values += 2;
+
+                for (std::size_t position = 0; position < length; ++position) {
+                    for (const char &special : specials) {
+                        value[position] = special;
+                        failures += !escapes(value, reference(value));
+                        ++values;
+                    }
+                    for (const char &plain : plains) {
+                        value[position] = plain;
+                        failures += !escapes(value, reference(value));
+                        ++values;
+                    }
+                    value[position] = 'x';
+                }
+
+                //bytes needing escaping at both ends of every vector-width
+                for (const std::size_t &boundary : {std::size_t(15), std::size_t(16), std::size_t(31), std::size_t(32)}) {
+                    if (boundary < length) {
+                        value[boundary - 1] = '\'';
+                        value[boundary] = '\n';
+                        failures += !escapes(value, reference(value));
+                        value[boundary - 1] = value[boundary] = 'x';
+                        ++values;
+                    }
+                }
+            }
+        }
+
+        std::cout << "Escaped: " << names[requested] << std::endl;
+    }
+
+    if (failures != 0) {
+        std::cout << "\aError: " << failures << " of " << values << " values were not escaped as a byte at a time"
+                  << std::endl;
+        return 1;
+    }
+    std::cout << "Checked: " << values << " values, by every implementation" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+//
+// Created by fo on 06/04/2021.
+//
+// This file contains the definition of ColumnBatch, a set of Resource-representations held column by column, in arrays
+// owned by the caller
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+#ifndef DBQUERYBUILDER_COLUMNBATCH_H
+#define DBQUERYBUILDER_COLUMNBATCH_H
+
+namespace DBQueryBuilder::Type {
+
+    class ColumnBatch {
+    public:
+        /**
+         * @brief: the enumeration of the types of the arrays that a column can be viewed from
+         */
+        enum Kind {
+            STRING,     //std::string
+            STRING_VIEW,        //std::string_view
+            INT64,      //std::int64_t
+            DOUBLE      //double
+        };
+
+        /**
+         * @brief: a view of a caller-owned array of values, with an optional caller-owned mask of nulls
+         */
+        struct Column {
+            std::string name;
+            Kind kind;
+            const void *values;     //the first of rows() values, of the type described by kind
+            const bool *nulls;      //true at the rows whose value is NULL; nullptr, if no value is NULL
+        };
+
+        /**
+         * @param rows: the number of values in every column of this ColumnBatch
+         */
+        inline explicit ColumnBatch(const std::size_t &rows) : _rows(rows) {}
+
+        /**
+         * @brief: adds a column, viewing the passed arrays; the arrays must outlive the rendering of this ColumnBatch
+         * @param name: the name of the column
+         * @param values: the first of rows() values of the column
+         * @param nulls: the first of rows() flags, that are true at the rows whose value is NULL; nullptr, if no value
+         * of the column is NULL
+         * @return ColumnBatch: this ColumnBatch
+         */
+        inline ColumnBatch &addColumn(const std::string &name, const std::string *values, const bool *nulls = nullptr) {
+            return add(name, Kind::STRING, values, nulls);
+        }
+
+        inline ColumnBatch &addColumn(const std::string &name, const std::string_view *values, const bool *nulls = nullptr) {
+            return add(name, Kind::STRING_VIEW, values, nulls);
+        }
+
+        inline ColumnBatch &addColumn(const std::string &name, const std::int64_t *values, const bool *nulls = nullptr) {
+            return add(name, Kind::INT64, values, nulls);
+        }
+
+        inline ColumnBatch &addColumn(const std::string &name, const double *values, const bool *nulls = nullptr) {
+            return add(name, Kind::DOUBLE, values, nulls);
+        }
+
+        inline std::size_t rows() const {
+            return _rows;
+        }
+
+        inline const std::vector<Column> &columns() const {
+            return _columns;
+        }
+
+    private:
+        inline ColumnBatch &add(const std::string &name, const Kind &kind, const void *values, const bool *nulls) {
+            if (name.empty()) {     //the column has no name
+                throw std::logic_error("In Type::ColumnBatch::addColumn: empty column-name");
+            } else if (values == nullptr && _rows != 0) {      //the column has no values
+                throw std::logic_error("In Type::ColumnBatch::addColumn: the column \"" + name + "\" has no values");
+            }
+
+            _columns.push_back({name, kind, values, nulls});
+            return *this;
+        }
+
+        std::size_t _rows;      //the number of values in every column
+        std::vector<Column> _columns;
+    };
+
+}
+
+#endif //DBQUERYBUILDER_COLUMNBATCH_H
@@ -15,6 +15,10 @@ namespace DBQueryBuilder::Type {
     public:
         using Ptr = std::shared_ptr<CompQueryCondition>;
 
+        /**
+         * @throws std::logic_error: if the passed collection of QueryConditions is empty
+         * @param conditions
+         */
         CompQueryCondition(const std::vector<QueryCondition::Ptr> &conditions);
 
         /**
@@ -30,6 +34,18 @@ namespace DBQueryBuilder::Type {
          */
         std::string strConj() override;
 
+        /**
+         * @brief: returns the conjunction of the first QueryCondition within this CompQueryCondition
+         * @return
+         */
+        Conjunction conjunction() const override;
+
+        /**
+         *
+         * @return
+         */
+        const std::vector<QueryCondition::Ptr> &components() const override;
+
         ~CompQueryCondition() override;
 
     private:
@@ -0,0 +1,267 @@
+//
+// Created by fo on 12/04/2021.
+//
+// This file contains the definition of ConditionTree, a value-type set of guard-conditions, held as one contiguous array
+// of nodes, whose field-names and values share one text-pool
+#include "QueryCondition.h"
+#include "../diagnostics/Allocations.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+#ifndef DBQUERYBUILDER_CONDITIONTREE_H
+#define DBQUERYBUILDER_CONDITIONTREE_H
+
+namespace DBQueryBuilder::Type {
+
+    class ConditionTree {
+    public:
+        using Conjunction = QueryCondition::Conjunction;
+        using Operator = QueryCondition::Operator;
+
+        /**
+         * @brief: a guard-condition; the nodes are kept in pre-order, so that the components of a composite node are
+         * the nodes [index + 1, end)
+         */
+        struct Node {
+            Conjunction conjunction;        //for a composite node, the conjunction of its first non-composite component
+            Operator _operator;
+            bool negate;
+            bool composite;     //true, if the node is parenthesis-delimited
+            std::uint32_t end;      //the index after the last node of the subtree of this node
+            std::uint32_t field, fieldLength;       //the field-name, within the text-pool
+            std::uint32_t value, valueLength;       //the value, within the text-pool
+        };
+
+        /**
+         * @brief: adds a guard-condition, from the parameters of the constructor of QueryCondition, to the innermost
+         * open group, or to the "where"-clause if no group is open
+         * @throws std::logic_error: if the conjunction or the operator is unknown
+         * @return ConditionTree: this ConditionTree
+         */
+        inline ConditionTree &add(const Conjunction &conjunction, const std::string_view &field, const Operator &_operator,
+                                  const bool &negate, const std::string_view &value) {
+            if (conjunction != Conjunction::AND && conjunction != Conjunction::OR) {
+                throw std::logic_error("In Type::ConditionTree::add: the conjunction-type is unknown");
+            } else if (_operator < Operator::E || _operator > Operator::GE) {
+                throw std::logic_error("In Type::ConditionTree::add: the operator-type is unknown");
+            }
+
+            Node &node = push(conjunction);
+            node._operator = _operator;
+            node.negate = negate;
+            node.field = store(field);
+            node.fieldLength = static_cast<std::uint32_t>(field.size());
+            node.value = store(value);
+            node.valueLength = static_cast<std::uint32_t>(value.size());
+
+            return *this;
+        }
+
+        /**
+         * @brief: opens a parenthesis-delimited group; the guard-conditions added until closeGroup() is called are its
+         * components
+         * @return ConditionTree: this ConditionTree
+         */
+        inline ConditionTree &openGroup() {
+            _open.push_back(static_cast<std::uint32_t>(_nodes.size()));
+
+            Node &node = push(Conjunction::AND);
+            node.composite = true;
+
+            return *this;
+        }
+
+        /**
+         * @brief: closes the innermost open group
+         * @throws std::logic_error: if no group is open, or the group has no component
+         * @return ConditionTree: this ConditionTree
+         */
+        inline ConditionTree &closeGroup() {
+            if (_open.empty()) {        //there is no group to close
+                throw std::logic_error("In Type::ConditionTree::closeGroup: no group is open");
+            } else if (_open.back() + 1 == _nodes.size()) {        //the group has no component
+                throw std::logic_error("In Type::ConditionTree::closeGroup: empty group");
+            }
+
+            _nodes[_open.back()].end = static_cast<std::uint32_t>(_nodes.size());
+            _open.pop_back();
+
+            return *this;
+        }
+
+        /**
+         * @brief: adds the structure of the passed QueryCondition, and of all of its components, as add(...) and
+         * openGroup() would
+         * @throws std::logic_error: if the conjunction or operator of any of the QueryConditions is unknown
+         * @return ConditionTree: this ConditionTree
+         */
+        inline ConditionTree &add(const QueryCondition &qCondition) {
+            //the ConditionTree is restored to this size, if any of the QueryConditions is rejected
+            const std::size_t nodes = _nodes.size(), text = _text.size(), open = _open.size();
+
+            //a null entry closes the group that was opened before it
+            _pending.clear();
+            _pending.push_back(&qCondition);
+
+            try {
+                while (!_pending.empty()) {
+                    const QueryCondition *condition = _pending.back();
+                    _pending.pop_back();
+
+                    if (condition == nullptr) {
+                        closeGroup();
+                    } else if (condition->components().empty()) {       //the condition is not composite
+                        add(condition->conjunction(), condition->field(), condition->getOperator(),
+                            condition->isNegated(), condition->value());
+                    } else {
+                        openGroup();
+                        _pending.push_back(nullptr);
+
+                        //components are pushed in reverse, so that they are added in order
+                        const auto &components = condition->components();
+                        for (std::size_t i = components.size(); i-- > 0;) {
+                            _pending.push_back(components[i].get());
+                        }
+                    }
+                }
+            } catch (...) {
+                _nodes.resize(nodes);
+                _text.resize(text);
+                _open.resize(open);
+                throw;
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief: adds all the guard-conditions of the passed ConditionTree, in order
+         * @throws std::logic_error: if the passed ConditionTree has an open group
+         * @return ConditionTree: this ConditionTree
+         */
+        inline ConditionTree &append(const ConditionTree &other) {
+            if (!other._open.empty()) {     //the passed ConditionTree is incomplete
+                throw std::logic_error("In Type::ConditionTree::append: the appended ConditionTree has an open group");
+            } else if (other._nodes.empty()) {
+                return *this;
+            }
+
+            adopt(other._nodes.front().conjunction);
+
+            const auto base = static_cast<std::uint32_t>(_nodes.size());
+            const auto textBase = static_cast<std::uint32_t>(_text.size());
+            _nodes.insert(_nodes.end(), other._nodes.begin(), other._nodes.end());
+            for (std::size_t i = base; i < _nodes.size(); ++i) {
+                _nodes[i].end += base;
+                _nodes[i].field += textBase;
+                _nodes[i].value += textBase;
+            }
+            _text += other._text;
+
+            return *this;
+        }
+
+        /**
+         * @brief: discards all the guard-conditions, keeping the memory acquired for them
+         */
+        inline void clear() {
+            _nodes.clear();
+            _text.clear();
+            _open.clear();
+        }
+
+        inline bool empty() const {
+            return _nodes.empty();
+        }
+
+        /**
+         * @brief: confirms whether or not every group opened has been closed
+         * @return
+         */
+        inline bool complete() const {
+            return _open.empty();
+        }
+
+        /**
+         * @brief: acquires the memory for the passed number of guard-conditions and groups, whose field-names and values
+         * add up to the passed length, so that adding them does not grow this ConditionTree
+         */
+        inline void reserve(const std::size_t &nodes, const std::size_t &textLength) {
+            _nodes.reserve(nodes);
+            _text.reserve(textLength);
+        }
+
+        /**
+         * @brief: acquires at least as much memory as the passed ConditionTree holds
+         */
+        inline void reserveAs(const ConditionTree &other) {
+            reserve(other._nodes.capacity(), other._text.capacity());
+            _open.reserve(other._open.capacity());
+            _pending.reserve(other._pending.capacity());
+        }
+
+        /**
+         * @brief: returns the number of bytes of the memory acquired by this ConditionTree
+         * @return
+         */
+        inline std::size_t capacity() const {
+            return _nodes.capacity() * sizeof(Node) + Diagnostics::heapCapacity(_text) +
+                   _open.capacity() * sizeof(std::uint32_t) + _pending.capacity() * sizeof(const QueryCondition *);
+        }
+
+        inline const std::vector<Node> &nodes() const {
+            return _nodes;
+        }
+
+        inline std::string_view field(const Node &node) const {
+            return std::string_view(_text.data() + node.field, node.fieldLength);
+        }
+
+        inline std::string_view value(const Node &node) const {
+            return std::string_view(_text.data() + node.value, node.valueLength);
+        }
+
+    private:
+        /**
+         * @brief: gives the passed conjunction to every open group whose first component the next node is, directly or
+         * through the groups nested first within it
+         */
+        inline void adopt(const Conjunction &conjunction) {
+            auto next = static_cast<std::uint32_t>(_nodes.size());
+            for (auto group = _open.rbegin(); group != _open.rend() && *group + 1 == next; ++group) {
+                _nodes[*group].conjunction = conjunction;
+                next = *group;
+            }
+        }
+
+        /**
+         * @brief: appends a node to the innermost open group, or to the "where"-clause if no group is open
+         */
+        inline Node &push(const Conjunction &conjunction) {
+            adopt(conjunction);
+
+            const auto index = static_cast<std::uint32_t>(_nodes.size());
+            _nodes.push_back({conjunction, Operator::E, false, false, index + 1, 0, 0, 0, 0});
+
+            return _nodes.back();
+        }
+
+        inline std::uint32_t store(const std::string_view &text) {
+            auto offset = static_cast<std::uint32_t>(_text.size());
+            _text += text;
+
+            return offset;
+        }
+
+        std::vector<Node> _nodes;       //every guard-condition, in pre-order
+        std::string _text;      //the pool that holds the field-names and values of all nodes
+        std::vector<std::uint32_t> _open;       //the groups that have been opened, but not yet closed
+        std::vector<const QueryCondition *> _pending;       //scratch-stack used while adding QueryConditions
+    };
+
+}
+
+#endif //DBQUERYBUILDER_CONDITIONTREE_H
@@ -4,6 +4,7 @@
 // This file contains the definition of QueryCondition, the abstraction of a guard-condition that a SQL-query may embody
 #include <string>
 #include <memory>
+#include <vector>
 
 #ifndef DBQUERYBUILDER_QUERYCONDITION_H
 #define DBQUERYBUILDER_QUERYCONDITION_H
@@ -37,20 +38,75 @@ namespace DBQueryBuilder::Type {
         QueryCondition();
 
         /**
-         * @brief: converts this QueryCondition to its string form
+         * @brief: converts this QueryCondition to its string form, as renderTo(std::string &, const bool &) does
          * @param addConj; true, if the conjunction should be added to the string-form of this QueryCondition
          * @return std::string: the string form of this QueryCondition
          */
         virtual std::string toString(const bool &addConj = true);
 
+        /**
+         * @brief: appends the string form of this QueryCondition, and of all of its components, to the passed buffer;
+         * the components are visited without recursion, so no nesting is copied more than once or overflows the stack.
+         * Fields and values are escaped as MYSQLBuilder escapes them, through Util::Escaper
+         * @throws std::logic_error: if the operator of any of the QueryConditions is unknown, or a field holds a
+         * NUL-character
+         * @param out: the caller-owned buffer that the string form is appended to
+         * @param addConj: true, if the conjunction should be added to the string-form of this QueryCondition
+         */
+        void renderTo(std::string &out, const bool &addConj = true) const;
+
         /**
          * @brief: returns the string form of the conjunction that binds this QueryCondition to a "where"-clause
          * @return
          */
         virtual std::string strConj();
 
+        /**
+         * @brief: returns the conjunction that binds this QueryCondition to a "where"-clause
+         * @return
+         */
+        virtual Conjunction conjunction() const;
+
+        /**
+         * @brief: returns the name of the field that this QueryCondition guards
+         * @return
+         */
+        const std::string &field() const;
+
+        /**
+         * @brief: returns the operator that operates on the operands of this QueryCondition
+         * @return
+         */
+        Operator getOperator() const;
+
+        /**
+         * @brief: confirms whether or not the operation of this QueryCondition is negated
+         * @return
+         */
+        bool isNegated() const;
+
+        /**
+         * @brief: returns the value that the field of this QueryCondition is compared with
+         * @return
+         */
+        const std::string &value() const;
+
+        /**
+         * @brief: returns the QueryConditions that this QueryCondition is composed of
+         * @return std::vector: the component QueryConditions; empty, for a QueryCondition that is not composite
+         */
+        virtual const std::vector<Ptr> &components() const;
+
         virtual ~QueryCondition();
     private:
+        /**
+         * @brief: appends the conjunction and the string form of this QueryCondition, or only the opening of it, if it
+         * is composite
+         * @return bool: true, if this QueryCondition is composite, and so still expects its components and closing
+         * parenthesis
+         */
+        bool renderOpening(std::string &out, const bool &addConj) const;
+
         class Core;     //the core of QueryConditions
 
         Core *_core;
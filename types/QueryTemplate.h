@@ -0,0 +1,179 @@
+//
+// Created by fo on 02/04/2021.
+//
+// This file contains the definition of QueryTemplate, the shape of a query: its literal text, cut at the positions where
+// values are to be spliced in. Once built, a QueryTemplate is only read, so any number of threads may render it at once
+#include "../utils/Escaper.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <initializer_list>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#ifndef DBQUERYBUILDER_QUERYTEMPLATE_H
+#define DBQUERYBUILDER_QUERYTEMPLATE_H
+
+namespace DBQueryBuilder::Type {
+
+    class QueryTemplate {
+    public:
+        using Ptr = std::shared_ptr<const QueryTemplate>;
+
+        /**
+         * @brief: appends the passed characters to the literal text of this QueryTemplate
+         * @param chars: the characters being appended
+         * @param count: the number of characters being appended
+         */
+        inline void append(const char *chars, const std::size_t &count) {
+            _literals.append(chars, count);
+        }
+
+        inline void append(const std::string &chars) {
+            _literals += chars;
+        }
+
+        template<std::size_t N>
+        inline void append(const char (&literal)[N]) {
+            _literals.append(literal, N - 1);
+        }
+
+        /**
+         * @brief: appends the passed name, escaped and backtick-quoted, to the literal text of this QueryTemplate
+         */
+        inline void appendIdentifier(const char *chars, const std::size_t &count) {
+            const std::size_t offset = _literals.size();
+            _literals.resize(offset + DBQueryBuilder::Util::Escaper::identifierLength(chars, count) + 2);
+
+            char *cursor = &_literals[offset];
+            *cursor++ = '`';
+            cursor = DBQueryBuilder::Util::Escaper::escapeIdentifier(chars, count, cursor);
+            *cursor = '`';
+        }
+
+        inline void appendIdentifier(const std::string &chars) {
+            appendIdentifier(chars.data(), chars.size());
+        }
+
+        /**
+         * @brief: appends a slot, in the place of the passed value, to this QueryTemplate; the value itself is not kept
+         */
+        inline void appendValue(const char *, const std::size_t &) {
+            _cuts.push_back(static_cast<std::uint32_t>(_literals.size()));
+        }
+
+        /**
+         * @brief: returns the number of values that this QueryTemplate expects
+         * @return
+         */
+        inline std::size_t slots() const {
+            return _cuts.size();
+        }
+
+        /**
+         * @brief: returns the number of literal characters in this QueryTemplate
+         * @return
+         */
+        inline std::size_t literalLength() const {
+            return _literals.size();
+        }
+
+        /**
+         * @brief: writes this QueryTemplate into the passed writer, splicing the passed values into its slots
+         * @throws std::logic_error: if the number of values passed is not the number of slots of this QueryTemplate
+         * @param writer: any writer with the append(const char *, std::size_t) and
+         * appendValue(const char *, std::size_t) members; the values are escaped by the writer
+         * @param values: the values of the slots, in order
+         */
+        template<typename Writer>
+        inline void write(Writer &writer, const std::vector<std::string_view> &values) const {
+            if (values.size() != _cuts.size()) {        //the values do not fit the slots
+                throw std::logic_error("In Type::QueryTemplate::write: the number of values does not match the number of slots");
+            }
+
+            std::uint32_t begin = 0;        //the beginning of the literal segment before the present slot
+            for (std::size_t i = 0; i < _cuts.size(); ++i) {
+                writer.append(_literals.data() + begin, _cuts[i] - begin);
+                writer.appendValue(values[i].data(), values[i].size());
+                begin = _cuts[i];
+            }
+            writer.append(_literals.data() + begin, _literals.size() - begin);
+        }
+
+        /**
+         * @brief: returns the length of this QueryTemplate, once the passed values are spliced into its slots
+         * @throws std::logic_error: if the number of values passed is not the number of slots of this QueryTemplate
+         * @param values: the values of the slots, in order
+         * @param count: the number of values
+         */
+        inline std::size_t length(const std::string_view *values, const std::size_t &count) const {
+            if (count != _cuts.size()) {        //the values do not fit the slots
+                throw std::logic_error("In Type::QueryTemplate::render: the number of values does not match the number of slots");
+            }
+
+            //the length of the literal text is already known; only the values need to be measured
+            std::size_t length = _literals.size() + 2 * count;
+            for (std::size_t i = 0; i < count; ++i) {
+                length += DBQueryBuilder::Util::Escaper::literalLength(values[i].data(), values[i].size());
+            }
+
+            return length;
+        }
+
+        /**
+         * @brief: writes this QueryTemplate into the passed memory, with the passed values escaped and quoted in its
+         * slots; the memory must hold length(values, count) characters
+         * @return char*: the position after the last character written
+         */
+        inline char *render(const std::string_view *values, const std::size_t &count, char *out) const {
+            std::uint32_t begin = 0;        //the beginning of the literal segment before the present slot
+            for (std::size_t i = 0; i < count; ++i) {
+                std::memcpy(out, _literals.data() + begin, _cuts[i] - begin);
+                out += _cuts[i] - begin;
+
+                *out++ = '\'';
+                out = DBQueryBuilder::Util::Escaper::escapeLiteral(values[i].data(), values[i].size(), out);
+                *out++ = '\'';
+
+                begin = _cuts[i];
+            }
+            std::memcpy(out, _literals.data() + begin, _literals.size() - begin);
+
+            return out + (_literals.size() - begin);
+        }
+
+        /**
+         * @brief: writes this QueryTemplate into the passed buffer, with the passed values escaped and quoted in its
+         * slots; nothing is allocated if the buffer can already hold the query
+         * @throws std::logic_error: if the number of values passed is not the number of slots of this QueryTemplate
+         * @param values: the values of the slots, in order
+         * @param count: the number of values
+         * @param out: the caller-owned buffer that receives the query; its previous content is replaced
+         * @return std::size_t: the length of the query
+         */
+        inline std::size_t render(const std::string_view *values, const std::size_t &count, std::string &out) const {
+            const std::size_t length = this->length(values, count);
+            out.resize(length);
+            render(values, count, &out[0]);
+
+            return length;
+        }
+
+        inline std::size_t render(const std::vector<std::string_view> &values, std::string &out) const {
+            return render(values.data(), values.size(), out);
+        }
+
+        inline std::size_t render(std::initializer_list<std::string_view> values, std::string &out) const {
+            return render(values.begin(), values.size(), out);
+        }
+
+    private:
+        std::string _literals;      //the literal text of the query, without its values
+        std::vector<std::uint32_t> _cuts;       //the position, within _literals, of each slot
+    };
+
+}
+
+#endif //DBQUERYBUILDER_QUERYTEMPLATE_H
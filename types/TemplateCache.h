@@ -0,0 +1,90 @@
+//
+// Created by fo on 02/04/2021.
+//
+// This file contains the definition of TemplateCache, the process-wide cache of QueryTemplates, keyed by the structural
+// hash of the state of the builder that produced them
+#include "QueryTemplate.h"
+
+#ifndef DBQUERYBUILDER_TEMPLATECACHE_H
+#define DBQUERYBUILDER_TEMPLATECACHE_H
+
+namespace DBQueryBuilder::Type {
+
+    class TemplateCache {
+    public:
+        /**
+         * @brief: the counters of a TemplateCache
+         */
+        struct Stats {
+            std::uint64_t hits{0};
+            std::uint64_t misses{0};
+            std::uint64_t evictions{0};
+            std::size_t size{0};        //the number of QueryTemplates held
+            std::size_t capacity{0};        //the maximum number of QueryTemplates held; zero, if caching is disabled
+        };
+
+        /**
+         * @brief: returns the process-wide TemplateCache; it is disabled until a capacity is set
+         * @return
+         */
+        static TemplateCache &instance();
+
+        /**
+         * @brief: sets the maximum number of QueryTemplates held; the least recently used ones, over all the shards, are
+         * evicted beyond it. An eviction scans every QueryTemplate held, so the capacity is best set above the number of
+         * shapes in use
+         * @param capacity: the maximum number of QueryTemplates held; zero disables caching and empties the cache
+         */
+        void setCapacity(const std::size_t &capacity);
+
+        /**
+         * @brief: confirms whether or not builders should consult this cache
+         * @return
+         */
+        bool enabled() const;
+
+        /**
+         * @brief: returns the QueryTemplate cached under the passed key, or nullptr if there is none
+         * @param hash: the structural hash of the shape of the query
+         * @param check: a second, independent digest of the shape, guarding against collisions of the hash
+         * @return
+         */
+        QueryTemplate::Ptr find(const std::uint64_t &hash, const std::uint64_t &check);
+
+        /**
+         * @brief: caches the passed QueryTemplate under the passed key, evicting the least recently used
+         * QueryTemplates if needed
+         * @param hash: the structural hash of the shape of the query
+         * @param check: a second, independent digest of the shape, guarding against collisions of the hash
+         * @param qTemplate
+         */
+        void insert(const std::uint64_t &hash, const std::uint64_t &check, const QueryTemplate::Ptr &qTemplate);
+
+        /**
+         * @brief: returns the counters of this cache, summed over all of its shards
+         * @return
+         */
+        Stats stats() const;
+
+        /**
+         * @brief: discards every cached QueryTemplate and resets the counters
+         */
+        void clear();
+
+        TemplateCache(const TemplateCache &) = delete;
+
+        TemplateCache &operator=(const TemplateCache &) = delete;
+
+        ~TemplateCache();
+
+    private:
+        TemplateCache();
+
+        class Core;     //the implementer of TemplateCache
+
+        Core *_core;        //pimpl
+    };
+
+}
+
+#endif //DBQUERYBUILDER_TEMPLATECACHE_H
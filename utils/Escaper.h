@@ -0,0 +1,103 @@
+//
+// Created by fo on 09/04/2021.
+//
+// This file contains the definition of Escaper, which escapes values as the bodies of MYSQL string-literals, and names
+// as the bodies of MYSQL backtick-quoted identifiers, or either as the bodies of strings whose quotes are doubled
+#include <cstddef>
+
+#ifndef DBQUERYBUILDER_ESCAPER_H
+#define DBQUERYBUILDER_ESCAPER_H
+
+namespace DBQueryBuilder::Util {
+
+    class Escaper {
+    public:
+        /**
+         * @brief: the enumeration of the implementations of the scanning of values; the widest one that the processor
+         * supports is chosen at start-up
+         */
+        enum Level {
+            SCALAR,     //one byte at a time
+            SSE2,       //16 bytes at a time
+            AVX2        //32 bytes at a time
+        };
+
+        /**
+         * @brief: returns the length of the passed value, once escaped as the body of a string-literal; NUL, backspace,
+         * tab, newline, carriage-return, Ctrl-Z, quotes and backslashes are each escaped into two characters
+         * @param chars: the characters of the value
+         * @param count: the number of characters of the value
+         * @return std::size_t: the length of the escaped value
+         */
+        static std::size_t literalLength(const char *chars, const std::size_t &count);
+
+        /**
+         * @brief: writes the passed value, escaped as the body of a string-literal, into the passed buffer; runs that
+         * need no escaping are copied whole
+         * @param chars: the characters of the value
+         * @param count: the number of characters of the value
+         * @param out: the buffer that receives the escaped value; it must hold literalLength(chars, count) characters
+         * @return char*: the position after the last character written
+         */
+        static char *escapeLiteral(const char *chars, const std::size_t &count, char *out);
+
+        /**
+         * @brief: returns the length of the passed name, once escaped as the body of a backtick-quoted identifier
+         * @throws std::logic_error: if the name holds a NUL-character, which no identifier may hold
+         * @param chars: the characters of the name
+         * @param count: the number of characters of the name
+         * @return std::size_t: the length of the escaped name
+         */
+        static std::size_t identifierLength(const char *chars, const std::size_t &count);
+
+        /**
+         * @brief: writes the passed name, escaped as the body of a backtick-quoted identifier, into the passed buffer;
+         * every backtick is doubled
+         * @param chars: the characters of the name
+         * @param count: the number of characters of the name
+         * @param out: the buffer that receives the escaped name; it must hold identifierLength(chars, count) characters
+         * @return char*: the position after the last character written
+         */
+        static char *escapeIdentifier(const char *chars, const std::size_t &count, char *out);
+
+        /**
+         * @brief: returns the length of the passed characters, once escaped as the body of a string quoted by the passed
+         * character, e.g. a PostgreSQL string-literal or double-quoted identifier; nothing but the quote is escaped
+         * @throws std::logic_error: if the characters hold a NUL-character, which no quoted string may hold
+         * @param chars: the characters being escaped
+         * @param count: the number of characters being escaped
+         * @param quote: the quoting character
+         * @return std::size_t: the length of the escaped characters
+         */
+        static std::size_t quotedLength(const char *chars, const std::size_t &count, const char &quote);
+
+        /**
+         * @brief: writes the passed characters, escaped as the body of a string quoted by the passed character, into the
+         * passed buffer; every quote is doubled
+         * @param chars: the characters being escaped
+         * @param count: the number of characters being escaped
+         * @param quote: the quoting character
+         * @param out: the buffer that receives the escaped characters; it must hold quotedLength(chars, count, quote)
+         * characters
+         * @return char*: the position after the last character written
+         */
+        static char *escapeQuoted(const char *chars, const std::size_t &count, const char &quote, char *out);
+
+        /**
+         * @brief: returns the implementation in use
+         * @return
+         */
+        static Level level();
+
+        /**
+         * @brief: switches to the passed implementation, e.g. for benchmarking; a level that the processor does not
+         * support falls back to the widest one that it does support
+         * @param level
+         * @return Level: the implementation now in use
+         */
+        static Level setLevel(const Level &level);
+    };
+
+}
+
+#endif //DBQUERYBUILDER_ESCAPER_H
@@ -0,0 +1,58 @@
+//
+// Created by fo on 13/04/2021.
+//
+// This file contains the definition of WorkStealingPool, a fixed set of worker-threads that share the chunks of a range
+// of work, each working through its own chunks first, then stealing those that other workers have not reached
+#include <cstddef>
+#include <functional>
+
+#ifndef DBQUERYBUILDER_WORKSTEALINGPOOL_H
+#define DBQUERYBUILDER_WORKSTEALINGPOOL_H
+
+namespace DBQueryBuilder::Util {
+
+    class WorkStealingPool {
+    public:
+        /**
+         * @param threads: the number of threads that work, including the one that calls run(...); zero, for as many
+         * as the hardware runs at once
+         */
+        explicit WorkStealingPool(const std::size_t &threads = 0);
+
+        WorkStealingPool(const WorkStealingPool &) = delete;
+
+        WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+        /**
+         * @brief: returns the number of threads that work, including the one that calls run(...)
+         * @return
+         */
+        std::size_t threads() const;
+
+        /**
+         * @brief: runs the passed task over [0, count), a chunk at a time, on all the threads of this pool, then returns;
+         * every worker is dealt a contiguous run of chunks, takes them from the front, and, once it runs out, steals
+         * from the back of the run of another worker; calls are serialized
+         * @throws: the first exception thrown by the task, once every worker has stopped; the chunks that were not
+         * started are skipped
+         * @param count: the number of items
+         * @param chunkSize: the greatest number of items passed to each call of the task
+         * @param task: called with the items [begin, end) of a chunk, possibly on several threads at once
+         */
+        void run(const std::size_t &count, const std::size_t &chunkSize,
+                 const std::function<void(std::size_t begin, std::size_t end)> &task);
+
+        ~WorkStealingPool();
+
+    private:
+        /**
+         * @brief: the core of WorkStealingPools
+         */
+        class Core;
+
+        Core *_core;        //pimpl
+    };
+
+}
+
+#endif //DBQUERYBUILDER_WORKSTEALINGPOOL_H